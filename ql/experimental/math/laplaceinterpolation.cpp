@@ -24,6 +24,7 @@
 #include <ql/experimental/math/laplaceinterpolation.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
@@ -32,6 +33,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -98,25 +100,29 @@ for (auto const& m : map_)
                     decomp.push_back(m.toMatrix());
                 return decomp;
             }
+            std::vector<CsrMatrix> toCsrMatrixDecomp() const override {
+                std::vector<CsrMatrix> decomp;
+                decomp.reserve(map_.size());
+                for (auto const& m : map_)
+                    decomp.push_back(m.toCsrMatrix());
+                return decomp;
+            }
         };
 
-        SparseMatrix op = LaplaceOp(mesher).toMatrix();
+        const CsrMatrix op = LaplaceOp(mesher).toCsrMatrix();
 
         // set up the linear system to solve
 
         Size N = layout_->size();
 
-        SparseMatrix g(N, N, 5 * N);
+        std::vector<Size> offsets(1, 0), indices;
+        std::vector<Real> values;
+        indices.reserve(op.nonZeros());
+        values.reserve(op.nonZeros());
+        std::vector<std::pair<Size, Real> > row;
         Array rhs(N, 0.0), guess(N, 0.0);
         Real guessTmp = 0.0;
 
-        struct f_A {
-            const SparseMatrix& g;
-            explicit f_A(const SparseMatrix& g) : g(g) {}
-            Array operator()(const Array& x) const { return prod(g, x); }
-        };
-
-        auto rowit = op.begin1();
         Size count = 0;
         std::vector<Real> corner_h(dim.size());
         std::vector<Size> corner_neighbour_index(dim.size());
@@ -124,10 +130,10 @@ for (auto const& m : map_)
             auto coord = pos.coordinates();
             Real val =
                 y_(numberOfCoordinatesIncluded_ == x_.size() ? coord : fullCoordinates(coord));
-            QL_REQUIRE(rowit != op.end1() && rowit.index1() == count,
-                       "LaplaceInterpolation: op matrix row iterator ("
-                           << (rowit != op.end1() ? std::to_string(rowit.index1()) : "na")
-                           << ") does not match expected row count (" << count << ")");
+            QL_REQUIRE(count < op.rows(),
+                       "LaplaceInterpolation: op matrix row count ("
+                           << op.rows() << ") does not match the layout");
+            row.clear();
             if (val == Null<Real>()) {
                 bool isCorner = true;
                 for (Size d = 0; d < dim.size() && isCorner; ++d) {
@@ -155,26 +161,38 @@ for (auto const& m : map_)
                                 weight += corner_h[i];
                         }
                         weight = dim.size() == 1 ? Real(1.0) : Real(weight / sum_corner_h);
-                        g(count, layout_->index(coord_j)) = -weight;
+                        row.emplace_back(layout_->index(coord_j), -weight);
                     }
-                    g(count, count) = 1.0;
+                    row.emplace_back(count, 1.0);
                 } else {
                     // point with at least one dimension with non-trivial second derivative
-                    for (auto colit = rowit.begin(); colit != rowit.end(); ++colit)
-                        g(count, colit.index2()) = *colit;
+                    for (Size k = op.rowOffsets()[count]; k < op.rowOffsets()[count + 1]; ++k)
+                        row.emplace_back(op.columnIndices()[k], op.values()[k]);
                 }
                 rhs[count] = 0.0;
                 guess[count] = guessTmp;
             } else {
-                g(count, count) = 1;
+                row.emplace_back(count, 1.0);
                 rhs[count] = val;
                 guess[count] = guessTmp = val;
             }
+            std::sort(row.begin(), row.end());
+            for (auto const& entry : row) {
+                indices.push_back(entry.first);
+                values.push_back(entry.second);
+            }
+            offsets.push_back(values.size());
             ++count;
-            ++rowit;
         }
 
-        interpolatedValues_ = BiCGstab(f_A(g), maxIterMultiplier_ * N, relTol_).solve(rhs, guess).x;
+        const CsrMatrix g(N, std::move(offsets), std::move(indices), std::move(values));
+        const CsrILUPreconditioner preconditioner(g);
+
+        interpolatedValues_ =
+            BiCGstab([&](const Array& x) { return prod(g, x); }, maxIterMultiplier_ * N, relTol_,
+                     [&](const Array& x) { return preconditioner.apply(x); })
+                .solve(rhs, guess)
+                .x;
     }
 
     std::vector<Size>
@@ -26,6 +26,7 @@
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 
 namespace QuantLib {
 
@@ -72,6 +73,13 @@ namespace QuantLib {
                                                 BigNatural seed) {
             return rsg_type(dimension, seed);
         }
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size /*streams*/) {
+            return rsg_type(dimension,
+                            PseudoRandom::stream_seed(seed, stream));
+        }
     };
 
 }
@@ -20,6 +20,7 @@
 
 #include <ql/instrument.hpp>
 #include <ql/settings.hpp>
+#include <unordered_map>
 
 namespace QuantLib {
 
@@ -46,4 +47,54 @@ namespace QuantLib {
         QL_FAIL("Instrument::setupArguments() not implemented");
     }
 
+
+    void calculateInstruments(const std::vector<ext::shared_ptr<Instrument> >& instruments) {
+        std::vector<const PricingEngine*> engines;
+        std::vector<std::vector<const Instrument*> > batches;
+        std::unordered_map<const PricingEngine*, Size> batchIndex;
+
+        for (const auto& instrument : instruments) {
+            QL_REQUIRE(instrument, "null instrument given");
+            // as in Instrument::calculate and LazyObject::calculate
+            if (instrument->calculated_)
+                continue;
+            if (instrument->isExpired()) {
+                instrument->setupExpired();
+                instrument->calculated_ = true;
+            } else if (instrument->frozen_) {
+                continue;
+            } else if (instrument->engine_ == nullptr
+                       || !instrument->calculatedByEngine()) {
+                // the instrument calculates itself, or does more
+                // than running its engine
+                instrument->calculate();
+            } else {
+                const PricingEngine* engine = instrument->engine_.get();
+                auto i = batchIndex.find(engine);
+                if (i == batchIndex.end()) {
+                    i = batchIndex.emplace(engine, batches.size()).first;
+                    engines.push_back(engine);
+                    batches.emplace_back();
+                }
+                // this also skips duplicates in the input
+                instrument->calculated_ = true;
+                batches[i->second].push_back(instrument.get());
+            }
+        }
+
+        for (Size k=0; k<batches.size(); ++k) {
+            try {
+                engines[k]->calculateBatch(batches[k]);
+            } catch (...) {
+                // the instruments in this and the following batches
+                // were not calculated
+                for (Size j=k; j<batches.size(); ++j) {
+                    for (const auto* instrument : batches[j])
+                        instrument->calculated_ = false;
+                }
+                throw;
+            }
+        }
+    }
+
 }
@@ -32,6 +32,7 @@
 #include <ql/any.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace QuantLib {
 
@@ -42,6 +43,9 @@ namespace QuantLib {
         \test observability of class instances is checked.
     */
     class Instrument : public LazyObject {
+        friend class PricingEngine;
+        friend void calculateInstruments(
+                        const std::vector<ext::shared_ptr<Instrument> >&);
       public:
         class results;
         Instrument();
@@ -97,6 +101,15 @@ namespace QuantLib {
             can be used.
         */
         void performCalculations() const override;
+        /*! Returns whether the instrument is calculated by the
+            default performCalculations() implementation alone, in
+            which case calculateInstruments() can pass it to its
+            pricing engine together with other instruments.  The
+            default is <tt>false</tt>; classes returning
+            <tt>true</tt> must not override performCalculations(),
+            and neither must classes deriving from them.
+        */
+        virtual bool calculatedByEngine() const { return false; }
         //@}
         /*! \name Results
             The value of this attribute and any other that derived
@@ -124,6 +137,18 @@ namespace QuantLib {
     };
 
 
+    //! calculates a number of instruments at once
+    /*! The instruments which are not yet calculated and use the
+        same pricing engine are passed to it in a single call to
+        PricingEngine::calculateBatch(); the others are calculated
+        as usual.  Only instruments whose calculatedByEngine()
+        method returns <tt>true</tt> are passed in batches, so that
+        instruments overriding <b>performCalculations</b> are still
+        calculated by their override.
+    */
+    void calculateInstruments(const std::vector<ext::shared_ptr<Instrument> >& instruments);
+
+
     // inline definitions
 
     inline void Instrument::calculate() const {
@@ -28,6 +28,7 @@
 
 #include <ql/math/errorfunction.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -134,6 +135,45 @@ namespace QuantLib {
 
             return z;
         }
+        // values for a range of inputs; out can be the same as begin
+        void operator()(const Real* begin, const Real* end, Real* out) const {
+            standard_values(begin, end, out);
+            if (average_ != 0.0 || sigma_ != 1.0) {
+                for (Real* y = out; begin != end; ++begin, ++y)
+                    *y = average_ + sigma_ * *y;
+            }
+        }
+        // values for a range of inputs, for average=0, sigma=1
+        /* The central region is evaluated for a whole chunk of inputs
+           in a loop that the compiler can vectorize; the few inputs
+           falling in the tails are corrected afterwards.
+        */
+        static void standard_values(const Real* begin, const Real* end, Real* out) {
+            // inputs are buffered so that out can overwrite them
+            const Size chunk = 64;
+            Real x[chunk];
+            while (begin != end) {
+                const Size n = std::min<Size>(chunk, end - begin);
+                std::copy(begin, begin + n, x);
+                for (Size i=0; i<n; ++i) {
+                    const Real z = x[i] - 0.5;
+                    const Real r = z*z;
+                    out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                        (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+                }
+                for (Size i=0; i<n; ++i) {
+                    if (x[i] < x_low_ || x_high_ < x[i])
+                        out[i] = tail_value(x[i]);
+                    #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+                    const Real r = (f_(out[i]) - x[i]) * M_SQRT2 * M_SQRTPI
+                        * exp(0.5 * out[i]*out[i]);
+                    out[i] -= r/(1+0.5*out[i]*r);
+                    #endif
+                }
+                begin += n;
+                out += n;
+            }
+        }
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+
+namespace QuantLib {
+
+    CsrILUPreconditioner::CsrILUPreconditioner(const CsrMatrix& A)
+    : LU_(A), diagonal_(A.rows()) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "ILU preconditioner works only with square matrices");
+
+        const Size n = LU_.rows();
+        const std::vector<Size>& offsets = LU_.rowOffsets();
+        const std::vector<Size>& cols = LU_.columnIndices();
+        std::vector<Real>& a = LU_.values();
+
+        // position of the elements of the current row, if stored
+        const Size none = offsets.back();
+        std::vector<Size> position(n, none);
+
+        for (Size i=0; i < n; ++i) {
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                position[cols[k]] = k;
+
+            Size k = offsets[i];
+            for (; k < offsets[i+1] && cols[k] < i; ++k) {
+                // eliminate a_ij using row j, which is already factorized
+                const Size j = cols[k];
+                a[k] /= a[diagonal_[j]];
+                for (Size l=diagonal_[j]+1; l < offsets[j+1]; ++l) {
+                    const Size p = position[cols[l]];
+                    if (p != none)
+                        a[p] -= a[k]*a[l];
+                }
+            }
+            QL_REQUIRE(k < offsets[i+1] && cols[k] == i && a[k] != 0.0,
+                       "null pivot in row " << i);
+            diagonal_[i] = k;
+
+            for (Size l=offsets[i]; l < offsets[i+1]; ++l)
+                position[cols[l]] = none;
+        }
+    }
+
+    const CsrMatrix& CsrILUPreconditioner::LU() const {
+        return LU_;
+    }
+
+    Array CsrILUPreconditioner::apply(const Array& b) const {
+        Array x(b.size());
+        apply_into(b, x);
+        return x;
+    }
+
+    void CsrILUPreconditioner::apply_into(const Array& b, Array& x) const {
+        const Size n = LU_.rows();
+        QL_REQUIRE(b.size() == n, "inconsistent size of rhs");
+        x.resize(n);
+
+        const std::vector<Size>& offsets = LU_.rowOffsets();
+        const std::vector<Size>& cols = LU_.columnIndices();
+        const std::vector<Real>& a = LU_.values();
+
+        // forward substitution with the unit lower triangle
+        for (Size i=0; i < n; ++i) {
+            Real t = b[i];
+            for (Size k=offsets[i]; k < diagonal_[i]; ++k)
+                t -= a[k]*x[cols[k]];
+            x[i] = t;
+        }
+        // backward substitution with the upper triangle
+        for (Size i=n; i-- > 0;) {
+            Real t = x[i];
+            for (Size k=diagonal_[i]+1; k < offsets[i+1]; ++k)
+                t -= a[k]*x[cols[k]];
+            x[i] = t/a[diagonal_[i]];
+        }
+    }
+
+}
@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrilupreconditioner.hpp
+    \brief incomplete LU preconditioner on compressed sparse row matrices
+*/
+
+#ifndef quantlib_csr_ilu_preconditioner_hpp
+#define quantlib_csr_ilu_preconditioner_hpp
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    //! incomplete LU preconditioner without fill-in
+    /*! The factors keep the sparsity pattern of the matrix, i.e., this
+        is the ILU(0) factorization; the unit diagonal of L is not
+        stored.  Compared to SparseILUPreconditioner, the
+        factorization takes a time proportional to the number of
+        stored elements and is cheap enough to be repeated at each
+        step of a finite-difference scheme.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html
+    */
+    class CsrILUPreconditioner {
+      public:
+        explicit CsrILUPreconditioner(const CsrMatrix& A);
+
+        //! the factors L and U stored in the same matrix
+        const CsrMatrix& LU() const;
+
+        Array apply(const Array& b) const;
+        //! writes the solution of \f$ LU x = b \f$ into \c x
+        void apply_into(const Array& b, Array& x) const;
+
+      private:
+        CsrMatrix LU_;
+        std::vector<Size> diagonal_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    CsrMatrix::CsrMatrix(Size rows, Size columns)
+    : columns_(columns), rowOffsets_(rows+1, 0) {}
+
+    CsrMatrix::CsrMatrix(Size size,
+                         const std::vector<const Size*>& indices,
+                         const std::vector<const Real*>& values)
+    : columns_(size), rowOffsets_(size+1) {
+        QL_REQUIRE(indices.size() == values.size(),
+                   "numbers of index (" << indices.size()
+                   << ") and value arrays (" << values.size() << ") differ");
+        const Size m = indices.size();
+
+        columnIndices_.reserve(m*size);
+        values_.reserve(m*size);
+
+        std::vector<std::pair<Size, Real> > row(m);
+        rowOffsets_[0] = 0;
+        for (Size i=0; i < size; ++i) {
+            for (Size k=0; k < m; ++k) {
+                const Size j = (indices[k] != nullptr) ? indices[k][i] : i;
+                QL_REQUIRE(j < size, "column index " << j << " out of range");
+                row[k] = std::make_pair(j, values[k][i]);
+            }
+            // stencils are short, insertion sort is the fastest
+            for (Size k=1; k < m; ++k)
+                for (Size l=k; l > 0 && row[l-1].first > row[l].first; --l)
+                    std::swap(row[l-1], row[l]);
+
+            for (Size k=0; k < m; ++k) {
+                if (k > 0 && row[k].first == row[k-1].first) {
+                    values_.back() += row[k].second;
+                } else {
+                    columnIndices_.push_back(row[k].first);
+                    values_.push_back(row[k].second);
+                }
+            }
+            rowOffsets_[i+1] = values_.size();
+        }
+    }
+
+    CsrMatrix::CsrMatrix(Size columns,
+                         std::vector<Size> rowOffsets,
+                         std::vector<Size> columnIndices,
+                         std::vector<Real> values)
+    : columns_(columns), rowOffsets_(std::move(rowOffsets)),
+      columnIndices_(std::move(columnIndices)), values_(std::move(values)) {
+        QL_REQUIRE(!rowOffsets_.empty() && rowOffsets_.front() == 0
+                   && rowOffsets_.back() == values_.size()
+                   && columnIndices_.size() == values_.size(),
+                   "inconsistent compressed row storage");
+        for (Size i=0; i+1 < rowOffsets_.size(); ++i) {
+            QL_REQUIRE(rowOffsets_[i] <= rowOffsets_[i+1],
+                       "decreasing offset for row " << i+1);
+            for (Size k=rowOffsets_[i]; k < rowOffsets_[i+1]; ++k) {
+                QL_REQUIRE(columnIndices_[k] < columns_,
+                           "column index " << columnIndices_[k]
+                           << " out of range in row " << i);
+                QL_REQUIRE(k == rowOffsets_[i]
+                           || columnIndices_[k-1] < columnIndices_[k],
+                           "unsorted or repeated column index "
+                           << columnIndices_[k] << " in row " << i);
+            }
+        }
+    }
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : columns_(m.size2()), rowOffsets_(m.size1()+1, 0) {
+        columnIndices_.reserve(m.nnz());
+        values_.reserve(m.nnz());
+        for (auto i1 = m.begin1(); i1 != m.end1(); ++i1) {
+            for (auto i2 = i1.begin(); i2 != i1.end(); ++i2) {
+                columnIndices_.push_back(i2.index2());
+                values_.push_back(*i2);
+                ++rowOffsets_[i2.index1()+1];
+            }
+        }
+        for (Size i=0; i < m.size1(); ++i)
+            rowOffsets_[i+1] += rowOffsets_[i];
+    }
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows() && j < columns_,
+                   "element (" << i << "," << j << ") out of range");
+        const auto begin = columnIndices_.begin() + rowOffsets_[i];
+        const auto end = columnIndices_.begin() + rowOffsets_[i+1];
+        const auto iter = std::lower_bound(begin, end, j);
+        return (iter != end && *iter == j) ?
+            values_[iter - columnIndices_.begin()] : 0.0;
+    }
+
+    void CsrMatrix::apply_into(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << rows() << "x" << columns_ <<
+                   ") cannot be multiplied");
+        QL_REQUIRE(&x != &y, "output and input must be different arrays");
+        y.resize(rows());
+
+        const Size* const offsets = rowOffsets_.data();
+        const Size* const cols = columnIndices_.data();
+        const Real* const vals = values_.data();
+        const Real* const xp = x.begin();
+        Real* const yp = y.begin();
+
+        const long n = static_cast<long>(rows());
+        #pragma omp parallel for if(n > 10000)
+        for (long i=0; i < n; ++i) {
+            Real t = 0.0;
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                t += vals[k]*xp[cols[k]];
+            yp[i] = t;
+        }
+    }
+
+    CsrMatrix& CsrMatrix::operator*=(Real x) {
+        for (Real& v : values_)
+            v *= x;
+        return *this;
+    }
+
+    CsrMatrix& CsrMatrix::addToDiagonal(Real x) {
+        QL_REQUIRE(rows() == columns_, "square matrix required");
+
+        // the pattern is checked before any value is changed
+        std::vector<Size> diagonal(rows());
+        for (Size i=0; i < rows(); ++i) {
+            const auto begin = columnIndices_.begin() + rowOffsets_[i];
+            const auto end = columnIndices_.begin() + rowOffsets_[i+1];
+            const auto iter = std::lower_bound(begin, end, i);
+            if (iter == end || *iter != i) {
+                // the diagonal is not stored; extend the pattern
+                const std::vector<Real> xs(rows(), x);
+                *this = *this + CsrMatrix(rows(), {nullptr}, {xs.data()});
+                return *this;
+            }
+            diagonal[i] = iter - columnIndices_.begin();
+        }
+
+        for (Size k : diagonal)
+            values_[k] += x;
+        return *this;
+    }
+
+    SparseMatrix CsrMatrix::toSparseMatrix() const {
+        SparseMatrix retVal(rows(), columns_, nonZeros());
+        for (Size i=0; i < rows(); ++i)
+            for (Size k=rowOffsets_[i]; k < rowOffsets_[i+1]; ++k)
+                retVal(i, columnIndices_[k]) = values_[k];
+        return retVal;
+    }
+
+    CsrMatrix operator+(const CsrMatrix& a, const CsrMatrix& b) {
+        QL_REQUIRE(a.rows() == b.rows() && a.columns() == b.columns(),
+                   "matrices with different sizes ("
+                   << a.rows() << "x" << a.columns() << ", "
+                   << b.rows() << "x" << b.columns() << ") cannot be added");
+
+        const std::vector<Size>& ao = a.rowOffsets();
+        const std::vector<Size>& bo = b.rowOffsets();
+        const std::vector<Size>& ac = a.columnIndices();
+        const std::vector<Size>& bc = b.columnIndices();
+        const std::vector<Real>& av = a.values();
+        const std::vector<Real>& bv = b.values();
+
+        std::vector<Size> offsets(a.rows()+1, 0), indices;
+        std::vector<Real> values;
+        indices.reserve(a.nonZeros() + b.nonZeros());
+        values.reserve(a.nonZeros() + b.nonZeros());
+
+        for (Size i=0; i < a.rows(); ++i) {
+            Size k = ao[i], l = bo[i];
+            while (k < ao[i+1] || l < bo[i+1]) {
+                if (l == bo[i+1] || (k < ao[i+1] && ac[k] < bc[l])) {
+                    indices.push_back(ac[k]);
+                    values.push_back(av[k++]);
+                } else if (k == ao[i+1] || bc[l] < ac[k]) {
+                    indices.push_back(bc[l]);
+                    values.push_back(bv[l++]);
+                } else {
+                    indices.push_back(ac[k]);
+                    values.push_back(av[k++] + bv[l++]);
+                }
+            }
+            offsets[i+1] = values.size();
+        }
+
+        return CsrMatrix(a.columns(), std::move(offsets),
+                         std::move(indices), std::move(values));
+    }
+
+    CsrMatrix operator*(Real a, const CsrMatrix& m) {
+        CsrMatrix retVal(m);
+        retVal *= a;
+        return retVal;
+    }
+
+    Array prod(const CsrMatrix& A, const Array& x) {
+        Array y(A.rows());
+        A.apply_into(x, y);
+        return y;
+    }
+
+}
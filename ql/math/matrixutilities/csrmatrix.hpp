@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed sparse row format
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed sparse row format
+    /*! The entries of the i-th row are stored in positions
+        rowOffsets()[i] to rowOffsets()[i+1]-1 of columnIndices() and
+        values(), ordered by column.  Unlike SparseMatrix, the storage
+        is accessed directly by the arithmetic, which makes
+        matrix-vector products and factorizations much faster; on the
+        other hand, the sparsity pattern is fixed once the matrix is
+        built.
+    */
+    class CsrMatrix {
+      public:
+        CsrMatrix() = default;
+        //! null matrix
+        CsrMatrix(Size rows, Size columns);
+        //! square matrix assembled from a stencil
+        /*! For each \c k, the i-th row has the entry
+            <tt>values[k][i]</tt> in column <tt>indices[k][i]</tt>;
+            a null index array stands for the diagonal.  Entries in
+            the same column are summed.  They are stored even when
+            null, so that the sparsity pattern doesn't depend on the
+            values.
+        */
+        CsrMatrix(Size size,
+                  const std::vector<const Size*>& indices,
+                  const std::vector<const Real*>& values);
+        //! matrix with the given compressed row storage
+        /*! The column indices must be less than \c columns and
+            strictly increasing within each row; this is checked.
+        */
+        CsrMatrix(Size columns,
+                  std::vector<Size> rowOffsets,
+                  std::vector<Size> columnIndices,
+                  std::vector<Real> values);
+        explicit CsrMatrix(const SparseMatrix& m);
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rowOffsets_.size() - 1; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        //! element access; zero if the element is not stored
+        Real operator()(Size i, Size j) const;
+
+        const std::vector<Size>& rowOffsets() const { return rowOffsets_; }
+        const std::vector<Size>& columnIndices() const { return columnIndices_; }
+        const std::vector<Real>& values() const { return values_; }
+        std::vector<Real>& values() { return values_; }
+        //@}
+
+        //! \name Algebra
+        //@{
+        //! writes the product with \c x into \c y, which must not be \c x
+        void apply_into(const Array& x, Array& y) const;
+        CsrMatrix& operator*=(Real x);
+        //! adds \c x to each diagonal element
+        CsrMatrix& addToDiagonal(Real x);
+        //@}
+
+        SparseMatrix toSparseMatrix() const;
+
+      private:
+        Size columns_ = 0;
+        std::vector<Size> rowOffsets_ = std::vector<Size>(1, 0);
+        std::vector<Size> columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    /*! \relates CsrMatrix */
+    CsrMatrix operator+(const CsrMatrix& a, const CsrMatrix& b);
+    /*! \relates CsrMatrix */
+    CsrMatrix operator*(Real a, const CsrMatrix& m);
+    /*! \relates CsrMatrix */
+    Array prod(const CsrMatrix& A, const Array& x);
+
+}
+
+#endif
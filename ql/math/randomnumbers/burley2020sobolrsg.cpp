@@ -43,11 +43,9 @@ namespace QuantLib {
     }
 
     const std::vector<std::uint32_t>& Burley2020SobolRsg::skipTo(std::uint32_t n) const {
-        reset();
-        for (Size k = 0; k < n + 1; ++k) {
-            nextInt32Sequence();
-        }
-        return integerSequence_;
+        // the scrambled points only depend on the counter
+        setNextSample(n);
+        return nextInt32Sequence();
     }
 
     namespace {
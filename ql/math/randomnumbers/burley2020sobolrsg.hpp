@@ -41,6 +41,9 @@ namespace QuantLib {
             SobolRsg::DirectionIntegers directionIntegers = SobolRsg::Jaeckel,
             unsigned long scrambleSeed = 43);
         const std::vector<std::uint32_t>& skipTo(std::uint32_t n) const;
+        /*! make the n-th sample in the low-discrepancy sequence the
+            next one to be drawn */
+        void setNextSample(std::uint32_t n) const { nextSequenceCounter_ = n; }
         const std::vector<std::uint32_t>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return sequence_; }
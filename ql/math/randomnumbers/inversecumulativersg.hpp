@@ -25,12 +25,37 @@
 #ifndef quantlib_inversecumulative_rsg_h
 #define quantlib_inversecumulative_rsg_h
 
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        template <class IC>
+        inline void inverseCumulativeValues(const IC& ic,
+                                            const Real* begin,
+                                            const Real* end,
+                                            Real* out) {
+            for (; begin != end; ++begin, ++out)
+                *out = ic(*begin);
+        }
+
+        // the Acklam inverse is evaluated in bulk
+        inline void inverseCumulativeValues(const InverseCumulativeNormal& ic,
+                                            const Real* begin,
+                                            const Real* end,
+                                            Real* out) {
+            ic(begin, end, out);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -52,6 +77,10 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+
+        Blocks of samples can be drawn with nextSequences(), in which
+        case the inverse cumulative is applied to the whole block at
+        once; this is vectorized for InverseCumulativeNormal.
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -61,6 +90,20 @@ namespace QuantLib {
         InverseCumulativeRsg(USG uniformSequenceGenerator, const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        //! fills each row of the given matrix with the next sample
+        /*! Sample weights are not returned; this is meant for
+            low-discrepancy generators, whose samples have unit weight.
+        */
+        void nextSequences(Matrix& samples) const;
+        //! makes the n-th sample of the sequence the next one drawn
+        /*! This allows parallel workers, each with its own copy of
+            the generator, to draw non-overlapping blocks of the
+            sequence.
+
+            \pre USG must provide a setNextSample(n) method with the
+                 same semantics, as SobolRsg and Burley2020SobolRsg do.
+        */
+        void skipTo(std::uint32_t n) const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
       private:
@@ -92,6 +135,32 @@ namespace QuantLib {
         return x_;
     }
 
+    template <class USG, class IC>
+    void InverseCumulativeRsg<USG, IC>::nextSequences(Matrix& samples) const {
+        QL_REQUIRE(samples.columns() == dimension_,
+                   "wrong number of columns (" << samples.columns()
+                   << ") for a " << dimension_ << "-dimensional sequence");
+        if (samples.rows() == 0)
+            return;
+
+        for (Size i = 0; i < samples.rows(); ++i) {
+            const typename USG::sample_type& sample =
+                uniformSequenceGenerator_.nextSequence();
+            std::copy(sample.value.begin(), sample.value.end(),
+                      samples.row_begin(i));
+            x_.weight = sample.weight;
+        }
+        detail::inverseCumulativeValues(ICD_, samples.begin(), samples.end(),
+                                        samples.begin());
+        std::copy(samples.row_begin(samples.rows()-1),
+                  samples.row_end(samples.rows()-1), x_.value.begin());
+    }
+
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::skipTo(std::uint32_t n) const {
+        uniformSequenceGenerator_.setNextSample(n);
+    }
+
 }
 
 
@@ -54,6 +54,29 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! factory for the i-th of several independent streams;
+            stream 0 is the same sequence returned by the factory
+            above, while the other streams use seeds derived from
+            the given one.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size /*streams*/) {
+            return make_sequence_generator(dimension,
+                                           stream_seed(seed, stream));
+        }
+        //! seed used for the i-th of several independent streams
+        static BigNatural stream_seed(BigNatural seed, Size stream) {
+            // a null seed means a random one for each stream anyway
+            if (seed == 0 || stream == 0)
+                return seed;
+            MersenneTwisterUniformRng seeds(seed);
+            BigNatural s = 0;
+            for (Size i=0; i<stream || s==0; ++i)
+                s = seeds.nextInt32();
+            return s;
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -91,6 +114,33 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! factory for the i-th of several independent streams.
+            The sequence is split into as many disjoint blocks
+            (aligned to a power of two) as there are streams, and
+            the i-th stream starts at the beginning of the i-th
+            block; stream 0 is the same sequence returned by the
+            factory above.
+
+            \pre URSG must provide a setNextSample(n) method making
+                 the n-th sample the next one drawn, as SobolRsg and
+                 Burley2020SobolRsg do.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size stream,
+                                                Size streams) {
+            QL_REQUIRE(stream < streams,
+                       "stream " << stream << " out of range [0, "
+                       << streams << ")");
+            ursg_type g(dimension, seed);
+            if (stream > 0) {
+                std::uint32_t block = 0x80000000U;
+                for (Size s=2; s<streams; s*=2)
+                    block >>= 1;
+                g.setNextSample(static_cast<std::uint32_t>(stream*block));
+            }
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static ext::shared_ptr<IC> icInstance;
     };
@@ -129,6 +129,12 @@ namespace QuantLib {
                           bool useGrayCode = true);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         const std::vector<std::uint32_t>& skipTo(std::uint32_t n) const;
+        /*! make the n-th sample in the low-discrepancy sequence the
+            next one to be drawn, regardless of the samples drawn so far */
+        void setNextSample(std::uint32_t n) const {
+            skipTo(n);
+            firstDraw_ = true;
+        }
         const std::vector<std::uint32_t>& nextInt32Sequence() const;
 
         const SobolRsg::sample_type& nextSequence() const {
@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmbatchmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/utilities/null.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+        ext::shared_ptr<FdmLinearOpLayout> getLayoutFromMeshers(
+                 const std::vector<ext::shared_ptr<Fdm1dMesher> >& meshers) {
+            QL_REQUIRE(!meshers.empty(), "no meshers given");
+            for (const auto& mesher : meshers) {
+                QL_REQUIRE(mesher->size() == meshers.front()->size(),
+                           "meshers of different sizes given");
+            }
+            return ext::make_shared<FdmLinearOpLayout>(
+                std::vector<Size>({meshers.size(), meshers.front()->size()}));
+        }
+    }
+
+    FdmBatchMesher::FdmBatchMesher(
+        std::vector<ext::shared_ptr<Fdm1dMesher> > meshers)
+    : FdmMesher(getLayoutFromMeshers(meshers)), meshers_(std::move(meshers)) {}
+
+    Real FdmBatchMesher::dplus(const FdmLinearOpIterator& iter,
+                               Size direction) const {
+        const Size i = iter.coordinates()[0];
+        if (direction == 0)
+            return (i < meshers_.size()-1) ? 1.0 : Null<Real>();
+        else
+            return meshers_[i]->dplus(iter.coordinates()[1]);
+    }
+
+    Real FdmBatchMesher::dminus(const FdmLinearOpIterator& iter,
+                                Size direction) const {
+        const Size i = iter.coordinates()[0];
+        if (direction == 0)
+            return (i > 0) ? 1.0 : Null<Real>();
+        else
+            return meshers_[i]->dminus(iter.coordinates()[1]);
+    }
+
+    Real FdmBatchMesher::location(const FdmLinearOpIterator& iter,
+                                  Size direction) const {
+        const Size i = iter.coordinates()[0];
+        if (direction == 0)
+            return Real(i);
+        else
+            return meshers_[i]->location(iter.coordinates()[1]);
+    }
+
+    Array FdmBatchMesher::locations(Size direction) const {
+        Array retVal(layout_->size());
+
+        for (const auto& iter : *layout_) {
+            retVal[iter.index()] = location(iter, direction);
+        }
+
+        return retVal;
+    }
+
+    const std::vector<ext::shared_ptr<Fdm1dMesher> >&
+        FdmBatchMesher::getFdm1dMeshers() const {
+        return meshers_;
+    }
+}
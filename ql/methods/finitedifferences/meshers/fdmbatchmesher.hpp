@@ -0,0 +1,58 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmbatchmesher.hpp
+    \brief mesher for a batch of one-dimensional problems
+*/
+
+#ifndef quantlib_fdm_batch_mesher_hpp
+#define quantlib_fdm_batch_mesher_hpp
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
+
+namespace QuantLib {
+
+    //! mesher for a batch of one-dimensional problems
+    /*! The first direction enumerates the problems, the second one
+        runs along the grid of each problem; the i-th problem keeps
+        its own one-dimensional grid.  The points with the same index
+        on the grids of the problems are adjacent in memory, so that
+        the tridiagonal systems of the problems are solved together
+        row by row (see TripleBandLinearOp::solve_splitting).
+
+        The grids must have the same number of points.
+    */
+    class FdmBatchMesher : public FdmMesher {
+      public:
+        explicit FdmBatchMesher(
+            std::vector<ext::shared_ptr<Fdm1dMesher> > meshers);
+
+        Real dplus(const FdmLinearOpIterator& iter, Size direction) const override;
+        Real dminus(const FdmLinearOpIterator& iter, Size direction) const override;
+        Real location(const FdmLinearOpIterator& iter, Size direction) const override;
+        Array locations(Size direction) const override;
+
+        const std::vector<ext::shared_ptr<Fdm1dMesher> >&
+            getFdm1dMeshers() const;
+
+      private:
+        const std::vector<ext::shared_ptr<Fdm1dMesher> > meshers_;
+    };
+}
+
+#endif
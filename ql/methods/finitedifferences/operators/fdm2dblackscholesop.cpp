@@ -108,7 +108,45 @@ namespace QuantLib {
     }
 
     Array Fdm2dBlackScholesOp::apply(const Array& x) const {
-        return opX_.apply(x) + opY_.apply(x) + apply_mixed(x);
+        Array retVal(x.size());
+        apply_into(x, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::apply_into(const Array& x, Array& out) const {
+        // scratch array for the terms, kept by each thread across calls
+        thread_local Array tmp;
+        opX_.apply_into(x, out);
+        opY_.apply_into(x, tmp);
+        out += tmp;
+        apply_mixed_into(x, tmp);
+        out += tmp;
+    }
+
+    void Fdm2dBlackScholesOp::apply_mixed_into(const Array& x, Array& out) const {
+        corrMapT_.apply_into(x, out);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += currentForwardRate_*x[i];
+    }
+
+    void Fdm2dBlackScholesOp::apply_direction_into(Size direction,
+                                                   const Array& x, Array& out) const {
+        if (direction == 0)
+            opX_.apply_into(x, out);
+        else if (direction == 1)
+            opY_.apply_into(x, out);
+        else
+            QL_FAIL("direction is too large");
+    }
+
+    void Fdm2dBlackScholesOp::solve_splitting_into(Size direction, const Array& x,
+                                                   Real s, Array& out) const {
+        if (direction == 0)
+            opX_.solve_splitting_into(direction, x, s, out);
+        else if (direction == 1)
+            opY_.solve_splitting_into(direction, x, s, out);
+        else
+            QL_FAIL("direction is too large");
     }
     
     Array Fdm2dBlackScholesOp::apply_mixed(const Array& x) const {
@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -44,38 +45,84 @@ namespace QuantLib {
                              ext::shared_ptr<LocalVolTermStructure>()),
       x_((localVol) ? Array(Exp(mesher->locations(direction))) : Array()),
       dxMap_(FirstDerivativeOp(direction, mesher)), dxxMap_(SecondDerivativeOp(direction, mesher)),
-      mapT_(direction, mesher), strike_(strike),
+      mapT_(direction, mesher), dxxVarMap_(dxxMap_), strike_(strike), batchDirection_(Null<Size>()),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
       quantoHelper_(std::move(quantoHelper)) {}
 
+    FdmBlackScholesOp::FdmBlackScholesOp(
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& bsProcess,
+        std::vector<Real> strikes,
+        Size batchDirection,
+        bool localVol,
+        Real illegalLocalVolOverwrite,
+        Size direction,
+        ext::shared_ptr<FdmQuantoHelper> quantoHelper)
+    : mesher_(mesher), rTS_(bsProcess->riskFreeRate().currentLink()),
+      qTS_(bsProcess->dividendYield().currentLink()),
+      volTS_(bsProcess->blackVolatility().currentLink()),
+      localVol_((localVol) ? bsProcess->localVolatility().currentLink() :
+                             ext::shared_ptr<LocalVolTermStructure>()),
+      x_((localVol) ? Array(Exp(mesher->locations(direction))) : Array()),
+      dxMap_(FirstDerivativeOp(direction, mesher)), dxxMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_(direction, mesher), dxxVarMap_(dxxMap_), strike_(Null<Real>()), strikes_(std::move(strikes)),
+      batchDirection_(batchDirection),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
+      quantoHelper_(std::move(quantoHelper)) {
+        QL_REQUIRE(batchDirection_ < mesher_->layout()->dim().size()
+                   && batchDirection_ != direction_,
+                   "invalid batch direction " << batchDirection_);
+        QL_REQUIRE(strikes_.size() == mesher_->layout()->dim()[batchDirection_],
+                   "number of strikes (" << strikes_.size()
+                   << ") differs from the size of the batch ("
+                   << mesher_->layout()->dim()[batchDirection_] << ")");
+    }
+
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
-        if (localVol_ != nullptr) {
-            Array v(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
+        if (localVol_ != nullptr || !strikes_.empty()) {
+            // the coefficients are assembled in workspace kept across steps
+            v_.resize(mesher_->layout()->size());
+            if (localVol_ != nullptr) {
+                for (const auto& iter : *mesher_->layout()) {
+                    const Size i = iter.index();
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
-                        v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = squared(illegalLocalVolOverwrite_);
+                    if (illegalLocalVolOverwrite_ < 0.0) {
+                        v_[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
+                    }
+                    else {
+                        try {
+                            v_[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
+                        } catch (Error&) {
+                            v_[i] = squared(illegalLocalVolOverwrite_);
+                        }
                     }
                 }
+            } else {
+                std::vector<Real> variances(strikes_.size());
+                for (Size j=0; j < strikes_.size(); ++j)
+                    variances[j]
+                        = volTS_->blackForwardVariance(t1, t2, strikes_[j])/(t2-t1);
+
+                const Size spacing = mesher_->layout()->spacing()[batchDirection_];
+                for (Size i=0; i < v_.size(); ++i)
+                    v_[i] = variances[(i/spacing) % strikes_.size()];
             }
 
             if (quantoHelper_ != nullptr) {
-                mapT_.axpyb(r - q - 0.5*v
-                    - quantoHelper_->quantoAdjustment(Sqrt(v), t1, t2),
-                    dxMap_, dxxMap_.mult(0.5*v), Array(1, -r));
+                mapT_.axpyb(r - q - 0.5*v_
+                    - quantoHelper_->quantoAdjustment(Sqrt(v_), t1, t2),
+                    dxMap_, dxxMap_.mult(0.5*v_), Array(1, -r));
             } else {
-                mapT_.axpyb(r - q - 0.5*v, dxMap_,
-                            dxxMap_.mult(0.5*v), Array(1, -r));
+                drift_.resize(v_.size());
+                for (Size i=0; i < v_.size(); ++i) {
+                    drift_[i] = r - q - 0.5*v_[i];
+                    v_[i] *= 0.5;
+                }
+                dxxMap_.mult_into(v_, dxxVarMap_);
+                mapT_.axpyb(drift_, dxMap_, dxxVarMap_, Array(1, -r));
             }
         } else {
             const Real v
@@ -97,7 +144,9 @@ namespace QuantLib {
         }
     }
 
-    Size FdmBlackScholesOp::size() const { return 1U; }
+    Size FdmBlackScholesOp::size() const {
+        return (strikes_.empty()) ? 1U : mesher_->layout()->dim().size();
+    }
 
     Array FdmBlackScholesOp::apply(const Array& u) const {
         return mapT_.apply(u);
@@ -130,6 +179,33 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else
+            apply_mixed_into(r, out);
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction, const Array& r,
+                                                 Real dt, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, out, dt, 1.0);
+        else {
+            out.resize(r.size());
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
     std::vector<SparseMatrix> FdmBlackScholesOp::toMatrixDecomp() const {
         return std::vector<SparseMatrix>(1, mapT_.toMatrix());
     }
@@ -46,6 +46,24 @@ namespace QuantLib {
             Size direction = 0,
             ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
 
+        /*! The mesher stacks the grids of a batch of options along
+            \p batchDirection; unless local volatility is used, the
+            variance on the grid of the i-th option is taken at the
+            i-th strike.  The operator then counts the directions of
+            the whole mesher, along which it is the identity except
+            for \p direction, so that the schemes solve its systems
+            along the latter.
+        */
+        FdmBlackScholesOp(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            std::vector<Real> strikes,
+            Size batchDirection,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Size direction = 0,
+            ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
+
         Size size() const override;
         void setTime(Time t1, Time t2) override;
 
@@ -55,6 +73,11 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& out) const override;
+        void apply_mixed_into(const Array& r, Array& out) const override;
+        void apply_direction_into(Size direction, const Array& r, Array& out) const override;
+        void solve_splitting_into(Size direction, const Array& r, Real s, Array& out) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
 
       private:
@@ -65,8 +88,11 @@ namespace QuantLib {
         const Array x_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
-        TripleBandLinearOp mapT_;
+        TripleBandLinearOp mapT_, dxxVarMap_;
+        Array v_, drift_;
         const Real strike_;
+        const std::vector<Real> strikes_;
+        const Size batchDirection_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+
+namespace QuantLib {
+
+    namespace {
+        // with L = (r - q - v/2) D_x + v/2 D_xx - r, the derivative is
+        // a constant operator times a time-dependent factor
+        TripleBandLinearOp sensitivityMap(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            FdmBlackScholesSensitivityOp::Parameter parameter,
+            Size direction) {
+            const Size n = mesher->layout()->size();
+            const FirstDerivativeOp dx(direction, mesher);
+
+            switch (parameter) {
+              case FdmBlackScholesSensitivityOp::Volatility:
+                return SecondDerivativeOp(direction, mesher)
+                    .mult(Array(n, 0.5)).add(dx.mult(Array(n, -0.5)));
+              case FdmBlackScholesSensitivityOp::RiskFreeRate:
+                return dx.add(Array(n, -1.0));
+              case FdmBlackScholesSensitivityOp::DividendYield:
+                return dx.mult(Array(n, -1.0));
+              default:
+                QL_FAIL("unknown parameter");
+            }
+        }
+    }
+
+    FdmBlackScholesSensitivityOp::FdmBlackScholesSensitivityOp(
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        Real strike,
+        Parameter parameter,
+        Size direction)
+    : volTS_(process->blackVolatility().currentLink()), strike_(strike),
+      parameter_(parameter), direction_(direction),
+      map_(sensitivityMap(mesher, parameter, direction)), c_(1.0) {}
+
+    void FdmBlackScholesSensitivityOp::setTime(Time t1, Time t2) {
+        if (parameter_ == Volatility) {
+            // derivative of the forward variance between t1 and t2
+            // w.r.t. a parallel shift of the Black volatility
+            const Real s1 =
+                (t1 > 0.0) ? volTS_->blackVol(t1, strike_, true) : 0.0;
+            const Real s2 = volTS_->blackVol(t2, strike_, true);
+            c_ = 2.0*(s2*t2 - s1*t1)/(t2 - t1);
+        }
+    }
+
+    Size FdmBlackScholesSensitivityOp::size() const { return 1U; }
+
+    Array FdmBlackScholesSensitivityOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void FdmBlackScholesSensitivityOp::apply_into(const Array& r,
+                                                  Array& out) const {
+        map_.apply_into(r, out);
+        if (c_ != 1.0)
+            out *= c_;
+    }
+
+    Array FdmBlackScholesSensitivityOp::apply_mixed(const Array& r) const {
+        return Array(r.size(), 0.0);
+    }
+
+    Array FdmBlackScholesSensitivityOp::apply_direction(
+        Size direction, const Array& r) const {
+        if (direction == direction_)
+            return apply(r);
+        else
+            return Array(r.size(), 0.0);
+    }
+
+    Array FdmBlackScholesSensitivityOp::solve_splitting(
+        Size, const Array&, Real) const {
+        QL_FAIL("splitting is not available for a sensitivity operator");
+    }
+
+    Array FdmBlackScholesSensitivityOp::preconditioner(
+        const Array&, Real) const {
+        QL_FAIL("preconditioner is not available for a sensitivity operator");
+    }
+
+    std::vector<SparseMatrix>
+    FdmBlackScholesSensitivityOp::toMatrixDecomp() const {
+        SparseMatrix m = map_.toMatrix();
+        m *= c_;
+        return std::vector<SparseMatrix>(1, m);
+    }
+}
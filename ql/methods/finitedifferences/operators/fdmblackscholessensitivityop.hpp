@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholessensitivityop.hpp
+    \brief derivative of the Black Scholes operator w.r.t. a parameter
+*/
+
+#ifndef quantlib_fdm_black_scholes_sensitivity_op_hpp
+#define quantlib_fdm_black_scholes_sensitivity_op_hpp
+
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! derivative of the Black Scholes operator w.r.t. a parameter
+    /*! The operator is the derivative of FdmBlackScholesOp with
+        respect to a parallel shift of the Black volatility at
+        \p strike, of the continuously-compounded zero rates of the
+        risk-free curve or of those of the dividend curve.  It is
+        meant to be used as a derivative operator of FdmTangentOp.
+
+        Local volatility and quanto adjustments are not supported.
+    */
+    class FdmBlackScholesSensitivityOp : public FdmLinearOpComposite {
+      public:
+        enum Parameter { Volatility, RiskFreeRate, DividendYield };
+
+        FdmBlackScholesSensitivityOp(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real strike,
+            Parameter parameter,
+            Size direction = 0);
+
+        Size size() const override;
+        void setTime(Time t1, Time t2) override;
+
+        Array apply(const Array& r) const override;
+        Array apply_mixed(const Array& r) const override;
+        Array apply_direction(Size direction, const Array& r) const override;
+        //! not available, the operator is not invertible in general
+        Array solve_splitting(Size direction, const Array& r, Real s) const override;
+        //! not available, the operator is not invertible in general
+        Array preconditioner(const Array& r, Real s) const override;
+
+        void apply_into(const Array& r, Array& out) const override;
+
+        std::vector<SparseMatrix> toMatrixDecomp() const override;
+
+      private:
+        const ext::shared_ptr<BlackVolTermStructure> volTS_;
+        const Real strike_;
+        const Parameter parameter_;
+        const Size direction_;
+        const TripleBandLinearOp map_;
+        Real c_;
+    };
+}
+
+#endif
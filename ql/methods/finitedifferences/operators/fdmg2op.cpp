@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 
 namespace QuantLib {
@@ -71,7 +72,47 @@ namespace QuantLib {
     }
 
     Array FdmG2Op::apply(const Array& r) const {
-        return mapX_.apply(r) + mapY_.apply(r) + apply_mixed(r);
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void FdmG2Op::apply_into(const Array& r, Array& out) const {
+        // scratch array for the terms, kept by each thread across calls
+        thread_local Array tmp;
+        mapX_.apply_into(r, out);
+        mapY_.apply_into(r, tmp);
+        out += tmp;
+        apply_mixed_into(r, tmp);
+        out += tmp;
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& out) const {
+        corrMap_.apply_into(r, out);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction,
+                                       const Array& r, Array& out) const {
+        if (direction == direction1_)
+            mapX_.apply_into(r, out);
+        else if (direction == direction2_)
+            mapY_.apply_into(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting_into(Size direction, const Array& r,
+                                       Real a, Array& out) const {
+        if (direction == direction1_)
+            mapX_.solve_splitting_into(r, out, a, 1.0);
+        else if (direction == direction2_)
+            mapY_.solve_splitting_into(r, out, a, 1.0);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
     }
 
     Array FdmG2Op::apply_mixed(const Array& r) const {
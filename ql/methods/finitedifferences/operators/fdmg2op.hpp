@@ -50,6 +50,11 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& out) const override;
+        void apply_mixed_into(const Array& r, Array& out) const override;
+        void apply_direction_into(Size direction, const Array& r, Array& out) const override;
+        void solve_splitting_into(Size direction, const Array& r, Real s, Array& out) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
 
       private:
@@ -100,9 +100,23 @@ namespace QuantLib {
     }
 
     Array FdmHestonHullWhiteOp::apply(const Array& u) const {
-        return  dyMap_.apply(u) + dxMap_.getMap().apply(u)
-              + hullWhiteOp_.apply(u)
-              + hestonCorrMap_.apply(u) + equityIrCorrMap_.apply(u);
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::apply_into(const Array& u, Array& out) const {
+        // scratch array for the terms, kept by each thread across calls
+        thread_local Array tmp;
+        dyMap_.apply_into(u, out);
+        dxMap_.getMap().apply_into(u, tmp);
+        out += tmp;
+        hullWhiteOp_.apply_into(u, tmp);
+        out += tmp;
+        hestonCorrMap_.apply_into(u, tmp);
+        out += tmp;
+        equityIrCorrMap_.apply_into(u, tmp);
+        out += tmp;
     }
 
     Array FdmHestonHullWhiteOp::apply_direction(Size direction,
@@ -118,7 +132,41 @@ namespace QuantLib {
     }
 
     Array FdmHestonHullWhiteOp::apply_mixed(const Array& r) const {
-        return hestonCorrMap_.apply(r) + equityIrCorrMap_.apply(r);
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r, Array& out) const {
+        // scratch array for the terms, kept by each thread across calls
+        thread_local Array tmp;
+        hestonCorrMap_.apply_into(r, out);
+        equityIrCorrMap_.apply_into(r, tmp);
+        out += tmp;
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.apply_into(r, out);
+        else if (direction == 2)
+            hullWhiteOp_.apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction, const Array& r,
+                                                    Real a, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 1)
+            dyMap_.solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting_into(2, r, a, out);
+        else
+            QL_FAIL("direction too large");
     }
 
     Array FdmHestonHullWhiteOp::solve_splitting(Size direction, const Array& r,
@@ -150,8 +150,19 @@ namespace QuantLib {
     }
 
     Array FdmHestonOp::apply(const Array& u) const {
-        return dyMap_.getMap().apply(u) + dxMap_.getMap().apply(u)
-              + dxMap_.getL()*correlationMap_.apply(u);
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void FdmHestonOp::apply_into(const Array& u, Array& out) const {
+        // scratch array for the terms, kept by each thread across calls
+        thread_local Array tmp;
+        dyMap_.getMap().apply_into(u, out);
+        dxMap_.getMap().apply_into(u, tmp);
+        out += tmp;
+        apply_mixed_into(u, tmp);
+        out += tmp;
     }
 
     Array FdmHestonOp::apply_direction(Size direction,
@@ -168,6 +179,31 @@ namespace QuantLib {
         return dxMap_.getL()*correlationMap_.apply(r);
     }
 
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& out) const {
+        correlationMap_.apply_into(r, out);
+        out *= dxMap_.getL();
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction, const Array& r,
+                                           Real a, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else
+            QL_FAIL("direction too large");
+    }
+
     Array FdmHestonOp::solve_splitting(Size direction,
                                        const Array& r, Real a) const {
 
@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -85,6 +86,31 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else
+            apply_mixed_into(r, out);
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(Size direction, const Array& r,
+                                              Real a, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, out, a, 1.0);
+        else
+            apply_mixed_into(r, out);
+    }
+
     std::vector<SparseMatrix> FdmHullWhiteOp::toMatrixDecomp() const {
         return std::vector<SparseMatrix>(1, mapT_.toMatrix());
     }
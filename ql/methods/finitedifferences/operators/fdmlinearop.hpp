@@ -36,6 +36,15 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() = default;
         virtual array_type apply(const array_type& r) const = 0;
+        //! writes the result of apply() into \c out, resizing it if needed
+        /*! \c out must not be the same array as \c r.  The default
+            implementation calls apply(); derived classes can override
+            it so that no array is allocated when \c out has the
+            correct size already.
+        */
+        virtual void apply_into(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
 
         virtual SparseMatrix toMatrix() const = 0;
     };
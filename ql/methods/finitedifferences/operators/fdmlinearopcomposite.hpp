@@ -26,6 +26,7 @@
 #ifndef quantlib_fdm_affine_map_composite_hpp
 #define quantlib_fdm_affine_map_composite_hpp
 
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <numeric>
@@ -45,6 +46,32 @@ namespace QuantLib {
         virtual Array solve_splitting(Size direction, const Array& r, Real s) const = 0;
         virtual Array preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place versions
+            These write the result into \c out, which must not be the
+            same array as \c r.  The default implementations call the
+            corresponding methods above.
+
+            \note The 2D Black-Scholes, G2, Heston and Heston/Hull-White
+                  operators sum their terms in a thread_local scratch
+                  array, so that apply_into() doesn't allocate after
+                  the first call on a thread.  The array is never
+                  shrunk or released before the thread exits: every
+                  thread that applied one of these operators, such as
+                  the workers of an OpenMP pool, keeps a scratch array
+                  as large as the largest grid it was used on.
+        */
+        //@{
+        virtual void apply_mixed_into(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction, const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction, const Array& r, Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
         virtual std::vector<SparseMatrix> toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
         }
@@ -55,6 +82,22 @@ namespace QuantLib {
                                    SparseMatrix(dcmp.front()));
         }
 
+        /*! The default implementation converts the ublas
+            representation; operators built on TripleBandLinearOp and
+            NinePointLinearOp can override it and assemble the
+            matrices directly through their toCsrMatrix() methods.
+        */
+        virtual std::vector<CsrMatrix> toCsrMatrixDecomp() const {
+            const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
+            return std::vector<CsrMatrix>(dcmp.begin(), dcmp.end());
+        }
+
+        CsrMatrix toCsrMatrix() const {
+            const std::vector<CsrMatrix> dcmp = toCsrMatrixDecomp();
+            return std::accumulate(dcmp.begin()+1, dcmp.end(),
+                                   CsrMatrix(dcmp.front()));
+        }
+
     };
 }
 
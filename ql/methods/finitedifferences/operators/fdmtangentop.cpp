@@ -0,0 +1,186 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/operators/fdmtangentop.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmTangentOp::FdmTangentOp(
+        ext::shared_ptr<FdmLinearOpComposite> op,
+        std::vector<ext::shared_ptr<FdmLinearOpComposite> > derivatives)
+    : op_(std::move(op)), derivatives_(std::move(derivatives)) {
+        QL_REQUIRE(op_ != nullptr, "null operator given");
+        for (const auto& d: derivatives_)
+            QL_REQUIRE(d != nullptr, "null derivative operator given");
+    }
+
+    Size FdmTangentOp::size() const {
+        return op_->size();
+    }
+
+    Size FdmTangentOp::numberOfTangents() const {
+        return derivatives_.size();
+    }
+
+    Size FdmTangentOp::blockSize(const Array& r) const {
+        const Size blocks = derivatives_.size() + 1;
+        QL_REQUIRE(r.size() % blocks == 0,
+                   "array size (" << r.size() << ") is not a multiple of "
+                   "the number of blocks (" << blocks << ")");
+        return r.size()/blocks;
+    }
+
+    void FdmTangentOp::setTime(Time t1, Time t2) {
+        op_->setTime(t1, t2);
+        for (const auto& d: derivatives_)
+            d->setTime(t1, t2);
+    }
+
+    Array FdmTangentOp::apply(const Array& r) const {
+        const Size n = blockSize(r);
+        Array retVal(r.size());
+
+        u_.resize(n);
+        std::copy(r.begin(), r.begin()+n, u_.begin());
+        op_->apply_into(u_, du_);
+        std::copy(du_.begin(), du_.end(), retVal.begin());
+
+        Array tmp(n);
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            derivatives_[k]->apply_into(u_, du_);
+            std::copy(r.begin()+(k+1)*n, r.begin()+(k+2)*n, tmp.begin());
+            du_ += op_->apply(tmp);
+            std::copy(du_.begin(), du_.end(), retVal.begin()+(k+1)*n);
+        }
+
+        return retVal;
+    }
+
+    Array FdmTangentOp::apply_mixed(const Array& r) const {
+        const Size n = blockSize(r);
+        Array retVal(r.size());
+
+        u_.resize(n);
+        std::copy(r.begin(), r.begin()+n, u_.begin());
+        op_->apply_mixed_into(u_, du_);
+        std::copy(du_.begin(), du_.end(), retVal.begin());
+
+        Array tmp(n);
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            derivatives_[k]->apply_mixed_into(u_, du_);
+            std::copy(r.begin()+(k+1)*n, r.begin()+(k+2)*n, tmp.begin());
+            du_ += op_->apply_mixed(tmp);
+            std::copy(du_.begin(), du_.end(), retVal.begin()+(k+1)*n);
+        }
+
+        return retVal;
+    }
+
+    Array FdmTangentOp::apply_direction(Size direction,
+                                        const Array& r) const {
+        const Size n = blockSize(r);
+        Array retVal(r.size());
+
+        u_.resize(n);
+        std::copy(r.begin(), r.begin()+n, u_.begin());
+        op_->apply_direction_into(direction, u_, du_);
+        std::copy(du_.begin(), du_.end(), retVal.begin());
+
+        Array tmp(n);
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            derivatives_[k]->apply_direction_into(direction, u_, du_);
+            std::copy(r.begin()+(k+1)*n, r.begin()+(k+2)*n, tmp.begin());
+            du_ += op_->apply_direction(direction, tmp);
+            std::copy(du_.begin(), du_.end(), retVal.begin()+(k+1)*n);
+        }
+
+        return retVal;
+    }
+
+    Array FdmTangentOp::solve_splitting(Size direction,
+                                        const Array& r, Real s) const {
+        // forward substitution of the block lower-triangular system
+        // (1 + s L) x = r, (1 + s L) x_k = r_k - s L_k x
+        const Size n = blockSize(r);
+        Array retVal(r.size());
+
+        Array x(n);
+        std::copy(r.begin(), r.begin()+n, x.begin());
+        op_->solve_splitting_into(direction, x, s, u_);
+        std::copy(u_.begin(), u_.end(), retVal.begin());
+
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            derivatives_[k]->apply_direction_into(direction, u_, du_);
+            for (Size i=0; i < n; ++i)
+                x[i] = r[(k+1)*n + i] - s*du_[i];
+            op_->solve_splitting_into(direction, x, s, du_);
+            std::copy(du_.begin(), du_.end(), retVal.begin()+(k+1)*n);
+        }
+
+        return retVal;
+    }
+
+    Array FdmTangentOp::preconditioner(const Array& r, Real s) const {
+        const Size n = blockSize(r);
+        Array retVal(r.size());
+
+        Array x(n);
+        std::copy(r.begin(), r.begin()+n, x.begin());
+        u_ = op_->preconditioner(x, s);
+        std::copy(u_.begin(), u_.end(), retVal.begin());
+
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            derivatives_[k]->apply_into(u_, du_);
+            for (Size i=0; i < n; ++i)
+                x[i] = r[(k+1)*n + i] - s*du_[i];
+            const Array xk = op_->preconditioner(x, s);
+            std::copy(xk.begin(), xk.end(), retVal.begin()+(k+1)*n);
+        }
+
+        return retVal;
+    }
+
+    std::vector<SparseMatrix> FdmTangentOp::toMatrixDecomp() const {
+        const Size blocks = derivatives_.size() + 1;
+
+        std::vector<SparseMatrix> retVal;
+        for (const auto& m: op_->toMatrixDecomp()) {
+            const Size n = m.size1();
+            SparseMatrix d(blocks*n, blocks*n, blocks*m.nnz());
+            for (auto i1 = m.begin1(); i1 != m.end1(); ++i1)
+                for (auto i2 = i1.begin(); i2 != i1.end(); ++i2)
+                    for (Size k=0; k < blocks; ++k)
+                        d(k*n + i2.index1(), k*n + i2.index2()) = *i2;
+            retVal.push_back(d);
+        }
+
+        for (Size k=0; k < derivatives_.size(); ++k) {
+            for (const auto& m: derivatives_[k]->toMatrixDecomp()) {
+                const Size n = m.size1();
+                SparseMatrix d(blocks*n, blocks*n, m.nnz());
+                for (auto i1 = m.begin1(); i1 != m.end1(); ++i1)
+                    for (auto i2 = i1.begin(); i2 != i1.end(); ++i2)
+                        d((k+1)*n + i2.index1(), i2.index2()) = *i2;
+                retVal.push_back(d);
+            }
+        }
+
+        return retVal;
+    }
+}
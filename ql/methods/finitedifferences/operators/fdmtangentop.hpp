@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentop.hpp
+    \brief linear operator of a pricing problem and its tangent problems
+*/
+
+#ifndef quantlib_fdm_tangent_op_hpp
+#define quantlib_fdm_tangent_op_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! linear operator of a pricing problem and its tangent problems
+    /*! The operator acts on arrays stacking the values \f$ u \f$ of
+        the pricing problem and the sensitivities
+        \f$ u_k = \partial u / \partial \theta_k \f$ with respect to
+        the parameters of the operator,
+        \f[
+            \frac{\partial}{\partial t}
+            \begin{pmatrix} u \\ u_k \end{pmatrix}
+            + \begin{pmatrix} L & 0 \\ L_k & L \end{pmatrix}
+              \begin{pmatrix} u \\ u_k \end{pmatrix} = 0,
+        \f]
+        where \f$ L_k = \partial L / \partial \theta_k \f$ is given by
+        the k-th derivative operator.  Each block of the array has the
+        size of the layout of the mesher.
+
+        The system is block lower-triangular, so that its splitting
+        and preconditioner solve one problem of \f$ L \f$ per block.
+        Since every scheme is linear in the operator, rolling back the
+        stacked system with any scheme gives the exact derivatives of
+        the values calculated by the same scheme, up to the step
+        conditions, on the same mesher and time grid.
+
+        The derivative operators only need to implement setTime, the
+        apply methods and, if needed, toMatrixDecomp.
+    */
+    class FdmTangentOp : public FdmLinearOpComposite {
+      public:
+        FdmTangentOp(
+            ext::shared_ptr<FdmLinearOpComposite> op,
+            std::vector<ext::shared_ptr<FdmLinearOpComposite> > derivatives);
+
+        Size size() const override;
+        void setTime(Time t1, Time t2) override;
+
+        Array apply(const Array& r) const override;
+        Array apply_mixed(const Array& r) const override;
+        Array apply_direction(Size direction, const Array& r) const override;
+        Array solve_splitting(Size direction, const Array& r, Real s) const override;
+        Array preconditioner(const Array& r, Real s) const override;
+
+        std::vector<SparseMatrix> toMatrixDecomp() const override;
+
+        Size numberOfTangents() const;
+
+      private:
+        Size blockSize(const Array& r) const;
+
+        const ext::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<ext::shared_ptr<FdmLinearOpComposite> > derivatives_;
+        mutable Array u_, du_;
+    };
+}
+
+#endif
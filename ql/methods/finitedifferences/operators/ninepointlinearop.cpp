@@ -108,11 +108,18 @@ namespace QuantLib {
     }
 
     Array NinePointLinearOp::apply(const Array& u) const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal) const {
 
         QL_REQUIRE(u.size() == mesher_->layout()->size(),"inconsistent length of r "
                     << u.size() << " vs " << mesher_->layout()->size());
+        QL_REQUIRE(&retVal != &u, "output and input must be different arrays");
 
-        Array retVal(u.size());
+        retVal.resize(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -133,7 +140,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
@@ -156,6 +162,16 @@ namespace QuantLib {
     }
 
 
+    CsrMatrix NinePointLinearOp::toCsrMatrix() const {
+        return CsrMatrix(mesher_->layout()->size(),
+                         { i00_.get(), i01_.get(), i02_.get(),
+                           i10_.get(), nullptr,    i12_.get(),
+                           i20_.get(), i21_.get(), i22_.get() },
+                         { a00_.get(), a01_.get(), a02_.get(),
+                           a10_.get(), a11_.get(), a12_.get(),
+                           a20_.get(), a21_.get(), a22_.get() });
+    }
+
     NinePointLinearOp NinePointLinearOp::mult(const Array & u) const {
 
         NinePointLinearOp retVal(d0_, d1_, mesher_);
@@ -26,6 +26,7 @@
 #ifndef quantlib_nine_point_linear_op_hpp
 #define quantlib_nine_point_linear_op_hpp
 
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <memory>
@@ -45,11 +46,13 @@ namespace QuantLib {
         ~NinePointLinearOp() override = default;
 
         Array apply(const Array& r) const override;
+        void apply_into(const Array& r, Array& out) const override;
         NinePointLinearOp mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const;
 
       protected:
         NinePointLinearOp() = default;
@@ -24,37 +24,32 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace {
+        // number of adjacent grid lines solved together
+        const Size blockSize = 8;
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
       i0_       (new Size[mesher->layout()->size()]),
       i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
       mesher_(mesher) {
 
-        std::vector<Size> newDim(mesher->layout()->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
         for (const auto& iter : *mesher->layout()) {
             const Size i = iter.index();
 
             i0_[i] = mesher->layout()->neighbourhood(iter, direction, -1);
             i2_[i] = mesher->layout()->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
         }
     }
 
@@ -62,7 +57,6 @@ namespace QuantLib {
     : direction_(m.direction_),
       i0_   (new Size[m.mesher_->layout()->size()]),
       i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
@@ -70,8 +64,6 @@ namespace QuantLib {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
         std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -82,7 +74,6 @@ namespace QuantLib {
         std::swap(direction_, m.direction_);
 
         i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
     }
 
@@ -174,7 +165,7 @@ namespace QuantLib {
 
     TripleBandLinearOp TripleBandLinearOp::mult(const Array& u) const {
 
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
@@ -188,10 +179,24 @@ namespace QuantLib {
         return retVal;
     }
 
+    void TripleBandLinearOp::mult_into(const Array& u,
+                                       TripleBandLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "operators defined on different grids");
+
+        const Size size = mesher_->layout()->size();
+        for (Size i=0; i < size; ++i) {
+            const Real s = u[i];
+            out.lower_[i]= lower_[i]*s;
+            out.diag_[i] = diag_[i]*s;
+            out.upper_[i]= upper_[i]*s;
+        }
+    }
+
     TripleBandLinearOp TripleBandLinearOp::multR(const Array& u) const {
         const Size size = mesher_->layout()->size();
         QL_REQUIRE(u.size() == size, "inconsistent size of rhs");
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         #pragma omp parallel for
         for (long i=0; i < (long)size; ++i) {
@@ -208,7 +213,7 @@ namespace QuantLib {
 
     TripleBandLinearOp TripleBandLinearOp::add(const Array& u) const {
 
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
@@ -222,7 +227,14 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& out) const {
         QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent length of r");
+        QL_REQUIRE(&out != &r, "output and input must be different arrays");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -230,13 +242,11 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
+        out.resize(r.size());
         //#pragma omp parallel for
         for (Size i=0; i < mesher_->layout()->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+            out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
-
-        return retVal;
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
@@ -253,49 +263,106 @@ namespace QuantLib {
     }
 
 
+    CsrMatrix TripleBandLinearOp::toCsrMatrix() const {
+        return CsrMatrix(mesher_->layout()->size(),
+                         { i0_.get(), nullptr, i2_.get() },
+                         { lower_.get(), diag_.get(), upper_.get() });
+    }
+
     Array TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
-        QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent size of rhs");
+        Array retVal(r.size());
+        solve_splitting_into(r, retVal, a, b);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array& r, Array& retVal,
+                                                  Real a, Real b) const {
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(&retVal != &r, "output and input must be different arrays");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
-        for (const auto& iter : *mesher_->layout()) {
+        for (const auto& iter : *layout) {
             const std::vector<Size>& coordinates = iter.coordinates();
             QL_REQUIRE(   coordinates[direction_] != 0
                        || lower_[iter.index()] == 0,"removing non zero entry!");
-            QL_REQUIRE(   coordinates[direction_] != mesher_->layout()->dim()[direction_]-1
+            QL_REQUIRE(   coordinates[direction_] != layout->dim()[direction_]-1
                        || upper_[iter.index()] == 0,"removing non zero entry!");
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        retVal.resize(r.size());
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=mesher_->layout()->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        const Real* rptr = r.begin();
+        Real* xptr = retVal.begin();
+
+        // The system decouples into one tridiagonal system for each
+        // line of the grid along the direction.  The lines are solved
+        // in blocks whose rows are swept together: along a direction
+        // other than the first, the lines of a block are adjacent in
+        // memory and each row is read contiguously instead of
+        // striding through the whole grid; along the first direction,
+        // the interleaved lines hide the latency of the recursion.
+        // The blocks are independent and are distributed among
+        // threads when OpenMP is enabled.
+        const Size n = layout->dim()[direction_];
+        const Size step = layout->spacing()[direction_];
+        const Size lineStep = (step == 1) ? n : 1;
+        const Size lines = (step == 1) ? layout->size()/n : step;
+        const Size planeSize = lines*n;
+        const Size blocksPerPlane = (lines + blockSize - 1)/blockSize;
+        const Size nBlocks = layout->size()/planeSize*blocksPerPlane;
+
+        bool singular = false;
+        #pragma omp parallel for reduction(|:singular) if(nBlocks > 1)
+        for (long k=0; k < (long)nBlocks; ++k) {
+            const Size first = (Size(k) % blocksPerPlane)*blockSize;
+            const Size m = std::min(blockSize, lines - first);
+            const Size base =
+                Size(k)/blocksPerPlane*planeSize + first*lineStep;
+
+            // The workspace of the recursion only covers the lines of
+            // the block.  Each thread keeps its own across calls, so
+            // that the operator can be used concurrently.
+            thread_local std::vector<Real> workspace;
+            if (workspace.size() < blockSize*n)
+                workspace.resize(blockSize*n);
+            Real* tptr = workspace.data();
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Real bet[blockSize];
+            for (Size l=0; l < m; ++l) {
+                const Size i = base + l*lineStep;
+                const Real pivot = a*dptr[i]+b;
+                singular |= (pivot == 0.0);
+                bet[l] = 1.0/pivot;
+                xptr[i] = rptr[i]*bet[l];
+            }
+            for (Size j=1; j < n; ++j) {
+                const Size row = base + j*step;
+                for (Size l=0; l < m; ++l) {
+                    const Size i = row + l*lineStep, im1 = i - step;
+                    Real& gam = tptr[j*blockSize + l];
+                    gam = a*uptr[im1]*bet[l];
+                    const Real pivot = b+a*(dptr[i]-gam*lptr[i]);
+                    singular |= (pivot == 0.0);
+                    bet[l] = 1.0/pivot;
+                    xptr[i] = (rptr[i]-a*lptr[i]*xptr[im1])*bet[l];
+                }
+            }
+            for (Size j=n-1; j > 0; --j) {
+                const Size row = base + (j-1)*step;
+                for (Size l=0; l < m; ++l) {
+                    const Size i = row + l*lineStep, ip1 = i + step;
+                    xptr[i] -= tptr[j*blockSize + l]*xptr[ip1];
+                }
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=mesher_->layout()->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
-
-        return retVal;
+        QL_ENSURE(!singular, "division by zero");
     }
 }
@@ -27,6 +27,7 @@
 #ifndef quantlib_triple_band_linear_op_hpp
 #define quantlib_triple_band_linear_op_hpp
 
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <memory>
 
@@ -46,9 +47,20 @@ namespace QuantLib {
         ~TripleBandLinearOp() override = default;
 
         Array apply(const Array& r) const override;
+        void apply_into(const Array& r, Array& out) const override;
         Array solve_splitting(const Array& r, Real a, Real b = 1.0) const;
+        //! in-place version of solve_splitting; \c out must not be \c r
+        /*! The recursion uses a thread_local workspace covering a
+            block of eight lines, i.e. eight times the number of points
+            along the direction of the operator.  It is kept for the
+            life of the thread.
+        */
+        void solve_splitting_into(const Array& r, Array& out,
+                                  Real a, Real b = 1.0) const;
 
         TripleBandLinearOp mult(const Array& u) const;
+        //! in-place version of mult; \c out must be defined on the same grid
+        void mult_into(const Array& u, TripleBandLinearOp& out) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
         TripleBandLinearOp multR(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on RHS
@@ -62,13 +74,13 @@ namespace QuantLib {
         void swap(TripleBandLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const;
 
       protected:
         TripleBandLinearOp() = default;
 
         Size direction_;
         std::unique_ptr<Size[]> i0_, i2_;
-        std::unique_ptr<Size[]> reverseIndex_;
         std::unique_ptr<Real[]> lower_, diag_, upper_;
 
         ext::shared_ptr<FdmMesher> mesher_;
@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -37,27 +38,39 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, y_);
+        y_ *= dt_;
+        y_ += a;
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        y0_.resize(y_.size());
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, rhs_);
+            rhs_ *= -theta_*dt_;
+            rhs_ += y_;
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, y_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
-        bcSet_.applyAfterApplying(yt);
+        diff_.resize(y_.size());
+        std::copy(y_.begin(), y_.end(), diff_.begin());
+        diff_ -= a;
+        map_->apply_mixed_into(diff_, yt_);
+        yt_ *= mu_*dt_;
+        yt_ += y0_;
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, rhs_);
+            rhs_ *= -theta_*dt_;
+            rhs_ += yt_;
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, yt_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void CraigSneydScheme::setStep(Time dt) {
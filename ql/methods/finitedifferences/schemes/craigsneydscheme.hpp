@@ -56,6 +56,9 @@ namespace QuantLib {
         const Real mu_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace reused across steps
+        Array y_, y0_, yt_, rhs_, diff_;
     };
 }
 
@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // workspace reused across steps
+        Array y_, rhs_;
     };
 }
 
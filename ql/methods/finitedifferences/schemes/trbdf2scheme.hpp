@@ -58,9 +58,18 @@ namespace QuantLib {
         void step(array_type& a, Time t);
         void setStep(Time dt);
 
+        /*! performs a step and estimates its local error using the
+            embedded estimator of M.E. Hosea, L.F. Shampine, Analysis and
+            implementation of TR-BDF2, Applied Numerical Mathematics 20
+            (1996), filtered through the preconditioner to damp the
+            stiff components.
+        */
+        void step(array_type& a, Time t, array_type& localError);
+
         Size numberOfIterations() const;
       protected:
         Array apply(const Array& r) const;
+        void stepImpl(array_type& a, Time t, array_type* localError);
 
         Time dt_;
         Real beta_;
@@ -104,10 +113,23 @@ namespace QuantLib {
 
     template <class TrapezoidalScheme>
     inline void TrBDF2Scheme<TrapezoidalScheme>::step(array_type& fn, Time t) {
+        stepImpl(fn, t, nullptr);
+    }
+
+    template <class TrapezoidalScheme>
+    inline void TrBDF2Scheme<TrapezoidalScheme>::step(
+        array_type& fn, Time t, array_type& localError) {
+        stepImpl(fn, t, &localError);
+    }
+
+    template <class TrapezoidalScheme>
+    inline void TrBDF2Scheme<TrapezoidalScheme>::stepImpl(
+        array_type& fn, Time t, array_type* localError) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
 
         const Time intermediateTimeStep = dt_*alpha_;
 
+        const array_type f0 = (localError != nullptr) ? fn : array_type();
         array_type fStar = fn;
         trapezoidalScheme_->setStep(intermediateTimeStep);
         trapezoidalScheme_->step(fStar, t);
@@ -146,6 +168,17 @@ namespace QuantLib {
         }
 
         bcSet_.applyAfterSolving(fn);
+
+        if (localError != nullptr) {
+            const Real c = (-3*alpha_*alpha_ + 4*alpha_ - 2)/(6*(2-alpha_));
+            const array_type e = c*dt_*(map_->apply(f0)/alpha_
+                - map_->apply(fStar)/(alpha_*(1-alpha_))
+                + map_->apply(fn)/(1-alpha_));
+
+            *localError = (map_->size() == 1)
+                ? map_->solve_splitting(0, e, -0.5*intermediateTimeStep)
+                : map_->preconditioner(e, -0.5*intermediateTimeStep);
+        }
     }
 }
 
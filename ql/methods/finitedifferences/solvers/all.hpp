@@ -3,6 +3,7 @@
 
 #include <ql/methods/finitedifferences/solvers/fdm2dblackscholessolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimbatchsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm2dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimbatchsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    Fdm1DimBatchSolver::Fdm1DimBatchSolver(const FdmSolverDesc& solverDesc,
+                                           const FdmSchemeDesc& schemeDesc,
+                                           ext::shared_ptr<FdmLinearOpComposite> op)
+    : solverDesc_(solverDesc), schemeDesc_(schemeDesc), op_(std::move(op)),
+      thetaCondition_(ext::make_shared<FdmSnapshotCondition>(
+          0.99 * std::min(1.0 / 365.0,
+                          solverDesc.condition->stoppingTimes().empty() ?
+                              solverDesc.maturity :
+                              solverDesc.condition->stoppingTimes().front()))),
+      conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_, solverDesc.condition)),
+      initialValues_(solverDesc.mesher->layout()->size()) {
+
+        const ext::shared_ptr<FdmLinearOpLayout> layout = solverDesc.mesher->layout();
+        QL_REQUIRE(layout->dim().size() == 2,
+                   "two-dimensional mesher required for a batch of problems");
+        x_.assign(layout->dim()[0], std::vector<Real>(layout->dim()[1]));
+
+        for (const auto& iter : *layout) {
+            initialValues_[iter.index()]
+                 = solverDesc_.calculator->avgInnerValue(iter,
+                                                         solverDesc.maturity);
+            x_[iter.coordinates()[0]][iter.coordinates()[1]]
+                = solverDesc.mesher->location(iter, 1);
+        }
+    }
+
+    Size Fdm1DimBatchSolver::size() const {
+        return x_.size();
+    }
+
+    Array Fdm1DimBatchSolver::valuesOf(Size i, const Array& a) const {
+        // the values of the i-th problem are strided by the batch size
+        const Size n = size();
+        Array values(x_[i].size());
+        for (Size j=0; j < values.size(); ++j)
+            values[j] = a[i + j*n];
+        return values;
+    }
+
+    void Fdm1DimBatchSolver::performCalculations() const {
+        Array rhs(initialValues_.size());
+        std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
+
+        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+            .rollback(rhs, solverDesc_.maturity, 0.0,
+                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+        resultValues_.resize(size());
+        interpolations_.resize(size());
+        for (Size i=0; i < size(); ++i) {
+            resultValues_[i] = valuesOf(i, rhs);
+            interpolations_[i] = ext::make_shared<MonotonicCubicNaturalSpline>(
+                x_[i].begin(), x_[i].end(), resultValues_[i].begin());
+        }
+    }
+
+    Real Fdm1DimBatchSolver::interpolateAt(Size i, Real x) const {
+        calculate();
+        QL_REQUIRE(i < interpolations_.size(), "invalid problem index " << i);
+        return (*interpolations_[i])(x);
+    }
+
+    Real Fdm1DimBatchSolver::thetaAt(Size i, Real x) const {
+        if (conditions_->stoppingTimes().front() == 0.0)
+            return Null<Real>();
+
+        calculate();
+        QL_REQUIRE(i < interpolations_.size(), "invalid problem index " << i);
+
+        const Array thetaValues = valuesOf(i, thetaCondition_->getValues());
+
+        Real temp = MonotonicCubicNaturalSpline(
+            x_[i].begin(), x_[i].end(), thetaValues.begin())(x);
+        return ( temp - interpolateAt(i, x) ) / thetaCondition_->getTime();
+    }
+
+    Real Fdm1DimBatchSolver::derivativeX(Size i, Real x) const {
+        calculate();
+        QL_REQUIRE(i < interpolations_.size(), "invalid problem index " << i);
+        return interpolations_[i]->derivative(x);
+    }
+
+    Real Fdm1DimBatchSolver::derivativeXX(Size i, Real x) const {
+        calculate();
+        QL_REQUIRE(i < interpolations_.size(), "invalid problem index " << i);
+        return interpolations_[i]->secondDerivative(x);
+    }
+}
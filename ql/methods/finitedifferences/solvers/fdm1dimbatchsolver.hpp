@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdm1dimbatchsolver.hpp
+    \brief solver for a batch of one-dimensional problems
+*/
+
+#ifndef quantlib_fdm_1_dim_batch_solver_hpp
+#define quantlib_fdm_1_dim_batch_solver_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class CubicInterpolation;
+    class FdmSnapshotCondition;
+
+    //! solver for a batch of one-dimensional problems
+    /*! The mesher stacks the grids of the problems along its first
+        direction and runs along them in the second one, see
+        FdmBatchMesher, so that the problems are rolled back together:
+        the operator is set up once per time step for the whole batch,
+        and the tridiagonal systems of the problems are solved
+        together row by row (see TripleBandLinearOp::solve_splitting).
+        The values of each problem are interpolated on its own grid,
+        as in Fdm1DimSolver; given the same grid, operator and
+        conditions, each problem gives the results of the latter.
+
+        The operator must not couple the problems, i.e., it must act
+        along the second direction only.
+    */
+    class Fdm1DimBatchSolver : public LazyObject {
+      public:
+        Fdm1DimBatchSolver(const FdmSolverDesc& solverDesc,
+                           const FdmSchemeDesc& schemeDesc,
+                           ext::shared_ptr<FdmLinearOpComposite> op);
+
+        //! number of problems in the batch
+        Size size() const;
+
+        Real interpolateAt(Size i, Real x) const;
+        Real thetaAt(Size i, Real x) const;
+
+        Real derivativeX(Size i, Real x) const;
+        Real derivativeXX(Size i, Real x) const;
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        const FdmSolverDesc solverDesc_;
+        const FdmSchemeDesc schemeDesc_;
+        const ext::shared_ptr<FdmLinearOpComposite> op_;
+
+        const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const ext::shared_ptr<FdmStepConditionComposite> conditions_;
+
+        std::vector<std::vector<Real> > x_;
+        Array initialValues_;
+        mutable std::vector<Array> resultValues_;
+        mutable std::vector<ext::shared_ptr<CubicInterpolation> > interpolations_;
+
+        Array valuesOf(Size i, const Array& a) const;
+    };
+}
+
+#endif
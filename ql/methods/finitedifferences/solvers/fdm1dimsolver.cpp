@@ -21,9 +21,11 @@
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmtangentop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmtangentstepcondition.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <utility>
 
@@ -52,14 +54,55 @@ namespace QuantLib {
 
 
     void Fdm1DimSolver::performCalculations() const {
-        Array rhs(initialValues_.size());
-        std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
+        const ext::shared_ptr<FdmTangentOp> tangentOp =
+            ext::dynamic_pointer_cast<FdmTangentOp>(op_);
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        if (tangentOp == nullptr) {
+            Array rhs(initialValues_.size());
+            std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
+
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                .rollback(rhs, solverDesc_.maturity, 0.0,
+                          solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+            std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
+        }
+        else {
+            QL_REQUIRE(solverDesc_.bcSet.empty(),
+                       "boundary conditions are not supported "
+                       "for tangent problems");
+
+            // the payoff does not depend on the parameters,
+            // hence the tangent problems start at zero
+            const Size n = initialValues_.size();
+            const Size k = tangentOp->numberOfTangents();
+            Array rhs((k+1)*n, 0.0);
+            std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
+
+            const ext::shared_ptr<FdmStepConditionComposite> conditions =
+                ext::make_shared<FdmStepConditionComposite>(
+                    std::list<std::vector<Time> >(1, conditions_->stoppingTimes()),
+                    FdmStepConditionComposite::Conditions(1,
+                        ext::make_shared<FdmTangentStepCondition>(
+                            conditions_, k)));
+
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions, schemeDesc_)
+                .rollback(rhs, solverDesc_.maturity, 0.0,
+                          solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+            std::copy(rhs.begin(), rhs.begin()+n, resultValues_.begin());
+
+            tangentValues_.resize(k);
+            tangentInterpolations_.resize(k);
+            for (Size i=0; i < k; ++i) {
+                tangentValues_[i] = Array(rhs.begin()+(i+1)*n,
+                                          rhs.begin()+(i+2)*n);
+                tangentInterpolations_[i] =
+                    ext::make_shared<CubicNaturalSpline>(
+                        x_.begin(), x_.end(), tangentValues_[i].begin());
+            }
+        }
 
-        std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = ext::make_shared<MonotonicCubicNaturalSpline>(x_.begin(), x_.end(),
                                         resultValues_.begin());
     }
@@ -94,4 +137,11 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    Real Fdm1DimSolver::tangentAt(Size i, Real x) const {
+        calculate();
+        QL_REQUIRE(i < tangentInterpolations_.size(),
+                   "tangent problem " << i << " not available");
+        return (*tangentInterpolations_[i])(x);
+    }
 }
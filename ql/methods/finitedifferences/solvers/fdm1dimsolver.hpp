@@ -47,6 +47,12 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        /*! If the operator is a FdmTangentOp, the values of the i-th
+            tangent problem are rolled back together with the values
+            on the same time grid.
+        */
+        Real tangentAt(Size i, Real x) const;
+
       protected:
         void performCalculations() const override;
 
@@ -61,6 +67,9 @@ namespace QuantLib {
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable ext::shared_ptr<CubicInterpolation> interpolation_;
+        mutable std::vector<Array> tangentValues_;
+        mutable std::vector<ext::shared_ptr<CubicInterpolation> >
+            tangentInterpolations_;
     };
 }
 
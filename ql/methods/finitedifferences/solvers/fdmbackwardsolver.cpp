@@ -35,6 +35,8 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 
@@ -77,6 +79,10 @@ namespace QuantLib {
 
     FdmSchemeDesc FdmSchemeDesc::TrBDF2() { return {FdmSchemeDesc::TrBDF2Type, 2 - M_SQRT2, 1e-8}; }
 
+    FdmSchemeDesc FdmSchemeDesc::AdaptiveTrBDF2(Real tolerance) {
+        return {FdmSchemeDesc::AdaptiveTrBDF2Type, 2 - M_SQRT2, tolerance};
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         ext::shared_ptr<FdmLinearOpComposite> map,
         FdmBoundaryConditionSet bcSet,
@@ -193,8 +199,82 @@ namespace QuantLib {
                 trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
             }
             break;
+          case FdmSchemeDesc::AdaptiveTrBDF2Type:
+            rollbackAdaptive(rhs, dampingTo, to, steps);
+            break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollbackAdaptive(FdmBackwardSolver::array_type& a,
+                                             Time from, Time to, Size steps) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(schemeDesc_.mu > 0.0, "positive tolerance required");
+
+        const FdmSchemeDesc trDesc = FdmSchemeDesc::CraigSneyd();
+        const ext::shared_ptr<CraigSneydScheme> csEvolver(
+            ext::make_shared<CraigSneydScheme>(
+                trDesc.theta, trDesc.mu, map_, bcSet_));
+        TrBDF2Scheme<CraigSneydScheme> trBDF2(
+            schemeDesc_.theta, map_, csEvolver, bcSet_);
+
+        std::vector<Time> stoppingTimes = condition_->stoppingTimes();
+        std::sort(stoppingTimes.begin(), stoppingTimes.end());
+        stoppingTimes.erase(
+            std::unique(stoppingTimes.begin(), stoppingTimes.end()),
+            stoppingTimes.end());
+
+        if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+            condition_->applyTo(a, from);
+
+        // step size control as in E. Hairer, G. Wanner, Solving Ordinary
+        // Differential Equations II, section IV.8; the local error of
+        // TR-BDF2 is of third order in the step size.
+        const Real safety = 0.9, minScale = 0.2, maxScale = 5.0;
+        const Time initialStep = (from - to)/std::max(Size(1), steps);
+        const Time minStep = 1e-6*(from - to);
+
+        Time t = from, dt = initialStep;
+        array_type trial, localError;
+        while (t > to) {
+            auto iter = std::lower_bound(
+                stoppingTimes.begin(), stoppingTimes.end(), t);
+            const Time target = (iter != stoppingTimes.begin() && *(iter-1) > to)
+                ? *(iter-1) : to;
+
+            // avoid leaving a tiny remainder in front of the target
+            const Time h = (t - dt < target + 0.1*dt) ? Time(t - target) : dt;
+
+            trial = a;
+            trBDF2.setStep(h);
+            trBDF2.step(trial, t, localError);
+
+            Real norm = 0.0, scale = 1.0;
+            for (Size i=0; i < trial.size(); ++i) {
+                norm = std::max(norm, std::fabs(localError[i]));
+                scale = std::max(scale, std::fabs(trial[i]));
+            }
+            const Real err = norm/(schemeDesc_.mu*scale);
+            const Real factor = (err > 0.0)
+                ? std::min(maxScale, std::max(minScale, safety*std::cbrt(1.0/err)))
+                : maxScale;
+
+            if (err <= 1.0 || h <= minStep) {
+                a.swap(trial);
+                const Time next = (std::fabs(t - h - target) < std::sqrt(QL_EPSILON))
+                    ? target : Time(t - h);
+                condition_->applyTo(a, next);
+
+                // a stopping time may introduce a discontinuity,
+                // restart the step size control behind it.
+                dt = (next == target) ? initialStep : Time(h*factor);
+                t = next;
+            }
+            else {
+                dt = std::max(minStep, h*factor);
+            }
+        }
+    }
 }
@@ -37,7 +37,7 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType,
                              MethodOfLinesType, TrBDF2Type,
-                             CrankNicolsonType };
+                             CrankNicolsonType, AdaptiveTrBDF2Type };
 
         FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
 
@@ -56,6 +56,12 @@ namespace QuantLib {
         static FdmSchemeDesc MethodOfLines(
             Real eps=0.001, Real relInitStepSize=0.01);
         static FdmSchemeDesc TrBDF2();
+        /*! TR-BDF2 with adaptive time steps controlled by the embedded
+            error estimator; the given number of time steps only sets
+            the size of the first step and of the first step after each
+            stopping time.
+        */
+        static FdmSchemeDesc AdaptiveTrBDF2(Real tolerance = 1e-4);
     };
         
     class FdmBackwardSolver {
@@ -72,6 +78,8 @@ namespace QuantLib {
                       Size steps, Size dampingSteps);
 
       protected:
+        void rollbackAdaptive(array_type& a, Time from, Time to, Size steps);
+
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const ext::shared_ptr<FdmStepConditionComposite> condition_;
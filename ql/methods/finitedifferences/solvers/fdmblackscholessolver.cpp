@@ -20,6 +20,8 @@
 */
 
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmtangentop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
@@ -33,23 +35,75 @@ namespace QuantLib {
                                                  const FdmSchemeDesc& schemeDesc,
                                                  bool localVol,
                                                  Real illegalLocalVolOverwrite,
-                                                 Handle<FdmQuantoHelper> quantoHelper)
+                                                 Handle<FdmQuantoHelper> quantoHelper,
+                                                 bool tangents)
     : process_(std::move(process)), strike_(strike), solverDesc_(std::move(solverDesc)),
       schemeDesc_(schemeDesc), localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)),
+      tangents_(tangents) {
+        QL_REQUIRE(!tangents_ || (!localVol_ && quantoHelper_.empty()),
+                   "tangent greeks are not supported for local volatility "
+                   "or quanto adjustments");
 
         registerWith(process_);
         registerWith(quantoHelper_);
     }
 
-    void FdmBlackScholesSolver::performCalculations() const {
-            const ext::shared_ptr<FdmBlackScholesOp> op(
+    FdmBlackScholesSolver::FdmBlackScholesSolver(Handle<GeneralizedBlackScholesProcess> process,
+                                                 FdmSolverDesc solverDesc,
+                                                 const FdmSchemeDesc& schemeDesc,
+                                                 ext::shared_ptr<FdmLinearOpComposite> op)
+    : process_(std::move(process)), strike_(Null<Real>()), solverDesc_(std::move(solverDesc)),
+      schemeDesc_(schemeDesc), localVol_(false), illegalLocalVolOverwrite_(-Null<Real>()),
+      tangents_(ext::dynamic_pointer_cast<FdmTangentOp>(op) != nullptr),
+      op_(std::move(op)) {
+        QL_REQUIRE(op_ != nullptr, "null operator given");
+
+        registerWith(process_);
+    }
+
+    ext::shared_ptr<FdmLinearOpComposite> FdmBlackScholesSolver::linearOp(
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        Real strike,
+        bool localVol,
+        Real illegalLocalVolOverwrite,
+        const ext::shared_ptr<FdmQuantoHelper>& quantoHelper,
+        bool tangents) {
+
+        const ext::shared_ptr<FdmBlackScholesOp> op(
             ext::make_shared<FdmBlackScholesOp>(
-                solverDesc_.mesher, process_.currentLink(), strike_,
-                localVol_, illegalLocalVolOverwrite_, 0,
-                (quantoHelper_.empty())
-                    ? ext::shared_ptr<FdmQuantoHelper>()
-                    : quantoHelper_.currentLink()));
+                mesher, process, strike,
+                localVol, illegalLocalVolOverwrite, 0, quantoHelper));
+
+        if (!tangents)
+            return op;
+
+        QL_REQUIRE(!localVol && quantoHelper == nullptr,
+                   "tangent greeks are not supported for local volatility "
+                   "or quanto adjustments");
+
+        const std::vector<ext::shared_ptr<FdmLinearOpComposite> > derivatives = {
+            ext::make_shared<FdmBlackScholesSensitivityOp>(
+                mesher, process, strike,
+                FdmBlackScholesSensitivityOp::Volatility),
+            ext::make_shared<FdmBlackScholesSensitivityOp>(
+                mesher, process, strike,
+                FdmBlackScholesSensitivityOp::RiskFreeRate)
+        };
+
+        return ext::make_shared<FdmTangentOp>(op, derivatives);
+    }
+
+    void FdmBlackScholesSolver::performCalculations() const {
+        const ext::shared_ptr<FdmLinearOpComposite> op = (op_ != nullptr)
+            ? op_
+            : linearOp(solverDesc_.mesher, process_.currentLink(), strike_,
+                       localVol_, illegalLocalVolOverwrite_,
+                       (quantoHelper_.empty())
+                           ? ext::shared_ptr<FdmQuantoHelper>()
+                           : quantoHelper_.currentLink(),
+                       tangents_);
 
         solver_ = ext::make_shared<Fdm1DimSolver>(solverDesc_, schemeDesc_, op);
     }
@@ -73,4 +127,16 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Real FdmBlackScholesSolver::vegaAt(Real s) const {
+        QL_REQUIRE(tangents_, "tangent greeks not requested");
+        calculate();
+        return solver_->tangentAt(0, std::log(s));
+    }
+
+    Real FdmBlackScholesSolver::rhoAt(Real s) const {
+        QL_REQUIRE(tangents_, "tangent greeks not requested");
+        calculate();
+        return solver_->tangentAt(1, std::log(s));
+    }
 }
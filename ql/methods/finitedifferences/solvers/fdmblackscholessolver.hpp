@@ -45,13 +45,51 @@ namespace QuantLib {
                               const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                               bool localVol = false,
                               Real illegalLocalVolOverwrite = -Null<Real>(),
-                              Handle<FdmQuantoHelper> quantoHelper = Handle<FdmQuantoHelper>());
+                              Handle<FdmQuantoHelper> quantoHelper = Handle<FdmQuantoHelper>(),
+                              bool tangents = false);
+
+        /*! The solver uses the given operator, which must be built
+            on the mesher of \p solverDesc, e.g., by linearOp(); this
+            allows to reuse the operator across solvers.  The caller
+            is responsible for building a new operator when the
+            process changes.  Vega and rho are available if the
+            operator is a FdmTangentOp.
+        */
+        FdmBlackScholesSolver(Handle<GeneralizedBlackScholesProcess> process,
+                              FdmSolverDesc solverDesc,
+                              const FdmSchemeDesc& schemeDesc,
+                              ext::shared_ptr<FdmLinearOpComposite> op);
+
+        //! operator built by the first constructor
+        static ext::shared_ptr<FdmLinearOpComposite> linearOp(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real strike,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            const ext::shared_ptr<FdmQuantoHelper>& quantoHelper
+                = ext::shared_ptr<FdmQuantoHelper>(),
+            bool tangents = false);
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        /*! \name Tangent greeks
+            If \p tangents is set, vega and rho are calculated by
+            rolling back their tangent problems together with the
+            value problem, see FdmTangentOp.  They are the exact
+            derivatives of the finite-difference value for the given
+            mesher, i.e., the mesher is not rebuilt with the shifted
+            parameters.  Local volatility and quanto adjustments are
+            not supported.
+        */
+        //@{
+        Real vegaAt(Real s) const;
+        Real rhoAt(Real s) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
@@ -63,6 +101,8 @@ namespace QuantLib {
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
         const Handle<FdmQuantoHelper> quantoHelper_;
+        const bool tangents_;
+        const ext::shared_ptr<FdmLinearOpComposite> op_;
 
         mutable ext::shared_ptr<Fdm1DimSolver> solver_;
     };
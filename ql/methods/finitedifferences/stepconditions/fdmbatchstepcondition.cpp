@@ -0,0 +1,65 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmbatchstepcondition.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmBatchStepCondition::FdmBatchStepCondition(
+        Size batchDirection,
+        ext::shared_ptr<FdmMesher> mesher,
+        Conditions conditions)
+    : batchDirection_(batchDirection), mesher_(std::move(mesher)),
+      conditions_(std::move(conditions)) {
+        const std::vector<Size>& dim = mesher_->layout()->dim();
+        QL_REQUIRE(dim.size() == 2,
+                   "two-dimensional mesher required for a batch of problems");
+        QL_REQUIRE(batchDirection_ < 2,
+                   "invalid batch direction " << batchDirection_);
+        QL_REQUIRE(conditions_.size() == dim[batchDirection_],
+                   "number of conditions (" << conditions_.size()
+                   << ") must equal the size of the batch ("
+                   << dim[batchDirection_] << ")");
+    }
+
+    void FdmBatchStepCondition::applyTo(Array& a, Time t) const {
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        QL_REQUIRE(layout->size() == a.size(),
+                   "inconsistent array dimensions");
+
+        const Size direction = 1 - batchDirection_;
+        const Size n = layout->dim()[direction];
+        const Size stride = layout->spacing()[direction];
+        const Size batchStride = layout->spacing()[batchDirection_];
+
+        values_.resize(n);
+        for (Size i=0; i < conditions_.size(); ++i) {
+            if (conditions_[i] != nullptr) {
+                const Size offset = i*batchStride;
+                for (Size j=0; j < n; ++j)
+                    values_[j] = a[offset + j*stride];
+
+                conditions_[i]->applyTo(values_, t);
+
+                for (Size j=0; j < n; ++j)
+                    a[offset + j*stride] = values_[j];
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmbatchstepcondition.hpp
+    \brief step conditions applied to each problem of a batch
+*/
+
+#ifndef quantlib_fdm_batch_step_condition_hpp
+#define quantlib_fdm_batch_step_condition_hpp
+
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+
+namespace QuantLib {
+
+    //! step conditions applied to each problem of a batch
+    /*! The mesher is two-dimensional and stacks the grids of the
+        problems along \p batchDirection.  The i-th condition works on
+        the one-dimensional grid of the i-th problem and is applied to
+        the values on that grid.  Null conditions are skipped.
+    */
+    class FdmBatchStepCondition : public StepCondition<Array> {
+      public:
+        typedef std::vector<ext::shared_ptr<StepCondition<Array> > >
+            Conditions;
+
+        FdmBatchStepCondition(Size batchDirection,
+                              ext::shared_ptr<FdmMesher> mesher,
+                              Conditions conditions);
+
+        void applyTo(Array& a, Time t) const override;
+
+      private:
+        const Size batchDirection_;
+        const ext::shared_ptr<FdmMesher> mesher_;
+        const Conditions conditions_;
+        mutable Array values_;
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmbermudanstepcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmtangentstepcondition.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmTangentStepCondition::FdmTangentStepCondition(
+        ext::shared_ptr<FdmStepConditionComposite> conditions,
+        Size numberOfTangents)
+    : conditions_(std::move(conditions)),
+      numberOfTangents_(numberOfTangents) {
+        QL_REQUIRE(conditions_ != nullptr, "null step conditions given");
+    }
+
+    void FdmTangentStepCondition::applyTo(Array& a, Time t) const {
+        for (const auto& condition : conditions_->conditions())
+            applyTo(condition, a, t);
+    }
+
+    void FdmTangentStepCondition::applyTo(
+        const ext::shared_ptr<StepCondition<Array> >& condition,
+        Array& a, Time t) const {
+
+        const Size blocks = numberOfTangents_ + 1;
+        QL_REQUIRE(a.size() % blocks == 0,
+                   "array size (" << a.size() << ") is not a multiple of "
+                   "the number of blocks (" << blocks << ")");
+        const Size n = a.size()/blocks;
+
+        if (const auto composite =
+                ext::dynamic_pointer_cast<FdmStepConditionComposite>(condition)) {
+            for (const auto& c : composite->conditions())
+                applyTo(c, a, t);
+        }
+        else if (ext::dynamic_pointer_cast<FdmAmericanStepCondition>(condition)
+                 || ext::dynamic_pointer_cast<FdmBermudanStepCondition>(condition)) {
+            Array values(a.begin(), a.begin()+n);
+            condition->applyTo(values, t);
+
+            for (Size i=0; i < n; ++i) {
+                if (values[i] != a[i]) {
+                    a[i] = values[i];
+                    for (Size k=1; k < blocks; ++k)
+                        a[k*n + i] = 0.0;
+                }
+            }
+        }
+        else {
+            Array values(n);
+            for (Size k=blocks; k-- > 0;) {
+                std::copy(a.begin()+k*n, a.begin()+(k+1)*n, values.begin());
+                condition->applyTo(values, t);
+                std::copy(values.begin(), values.end(), a.begin()+k*n);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentstepcondition.hpp
+    \brief step conditions of a pricing problem and its tangent problems
+*/
+
+#ifndef quantlib_fdm_tangent_step_condition_hpp
+#define quantlib_fdm_tangent_step_condition_hpp
+
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+
+namespace QuantLib {
+
+    //! step conditions of a pricing problem and its tangent problems
+    /*! The array stacks the values and their sensitivities as in
+        FdmTangentOp.  American and Bermudan exercise conditions are
+        applied to the values; where the option is exercised, the
+        values are given by the payoff and the sensitivities are set
+        to zero.  All other conditions are assumed to be linear in
+        the values, e.g. dividend handlers, and are applied to each
+        block of the array, the values last.  Therefore snapshot
+        conditions hold the values.
+    */
+    class FdmTangentStepCondition : public StepCondition<Array> {
+      public:
+        FdmTangentStepCondition(
+            ext::shared_ptr<FdmStepConditionComposite> conditions,
+            Size numberOfTangents);
+
+        void applyTo(Array& a, Time t) const override;
+
+      private:
+        void applyTo(const ext::shared_ptr<StepCondition<Array> >& condition,
+                     Array& a, Time t) const;
+
+        const ext::shared_ptr<FdmStepConditionComposite> conditions_;
+        const Size numberOfTangents_;
+    };
+}
+
+#endif
@@ -133,4 +133,36 @@ namespace QuantLib {
                                     const FdmLinearOpIterator& iter, Time t) {
         return innerValue(iter, t);
     }
+
+
+    FdmBatchInnerValue::FdmBatchInnerValue(
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators,
+        Size batchDirection,
+        const ext::shared_ptr<FdmMesher>& mesher)
+    : calculators_(std::move(calculators)), batchDirection_(batchDirection),
+      gridSize_(1, mesher->layout()->dim()[1-batchDirection]) {
+        const std::vector<Size>& dim = mesher->layout()->dim();
+        QL_REQUIRE(dim.size() == 2,
+                   "two-dimensional mesher required for a batch of problems");
+        QL_REQUIRE(calculators_.size() == dim[batchDirection_],
+                   "number of calculators (" << calculators_.size()
+                   << ") differs from the size of the batch ("
+                   << dim[batchDirection_] << ")");
+    }
+
+    FdmLinearOpIterator FdmBatchInnerValue::gridIterator(
+                                    const FdmLinearOpIterator& iter) const {
+        const Size j = iter.coordinates()[1-batchDirection_];
+        return FdmLinearOpIterator(gridSize_, std::vector<Size>(1, j), j);
+    }
+
+    Real FdmBatchInnerValue::innerValue(const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[batchDirection_]]
+            ->innerValue(gridIterator(iter), t);
+    }
+
+    Real FdmBatchInnerValue::avgInnerValue(const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[batchDirection_]]
+            ->avgInnerValue(gridIterator(iter), t);
+    }
 }
@@ -90,6 +90,31 @@ namespace QuantLib {
         const ext::shared_ptr<FdmMesher> mesher_;
     };
 
+    //! inner values of a batch of problems stacked along a direction
+    /*! The mesher is two-dimensional and stacks the grids of the
+        problems along \p batchDirection.  The \f$ i \f$-th calculator
+        works on the one-dimensional grid of the \f$ i \f$-th problem
+        and gives the values at the points with coordinate \f$ i \f$
+        along \p batchDirection.
+    */
+    class FdmBatchInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmBatchInnerValue(
+            std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators,
+            Size batchDirection,
+            const ext::shared_ptr<FdmMesher>& mesher);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time t) override;
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time t) override;
+
+      private:
+        FdmLinearOpIterator gridIterator(const FdmLinearOpIterator& iter) const;
+
+        const std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators_;
+        const Size batchDirection_;
+        const std::vector<Size> gridSize_;
+    };
+
     class FdmZeroInnerValue : public FdmInnerValueCalculator {
       public:
         Real innerValue(const FdmLinearOpIterator&, Time) override { return 0.0; }
@@ -18,11 +18,21 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
+    namespace {
+
+        // the paths are accumulated in blocks of fixed size, so that
+        // the results don't depend on the number of threads
+        const Size blockSize = 1024;
+
+    }
+
     Real genericLongstaffSchwartzRegression(
                 std::vector<std::vector<NodeData> >& simulationData,
                 std::vector<std::vector<Real> >& basisCoefficients) {
@@ -37,31 +47,86 @@ namespace QuantLib {
             // 1) find the covariance matrix of basis function values and
             //    deflated cash-flows
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
+            const Size paths = exerciseData.size();
+            const Size blocks = (paths + blockSize - 1)/blockSize;
+
+            const auto sample = [&](Size j, Array& temp) {
+                std::copy(exerciseData[j].values.begin(),
+                          exerciseData[j].values.end(),
+                          temp.begin());
+                temp[N] = exerciseData[j].cumulatedCashFlows
+                        - exerciseData[j].controlValue;
+            };
+
+            // the covariance is computed in two passes, the second one
+            // accumulating the products of the deviations from the
+            // means, to avoid the cancellation of the one-pass formula.
+
+            // first pass: number of valid paths and sums of the samples
+            // for each block
+            std::vector<Real> counts(blocks, 0.0);
+            std::vector<Array> sums(blocks, Array(N+1, 0.0));
+
+            #pragma omp parallel for
+            for (long b=0; b<(long)blocks; ++b) {
+                const auto block = static_cast<Size>(b);
+                const Size end = std::min((block+1)*blockSize, paths);
+                Array temp(N+1);
+                for (Size j=block*blockSize; j<end; ++j) {
+                    if (exerciseData[j].isValid) {
+                        sample(j, temp);
+                        counts[block] += 1.0;
+                        sums[block] += temp;
+                    }
+                }
+            }
 
-                    stats.add(temp);
+            Real n = 0.0;
+            Array sum(N+1, 0.0);
+            for (Size b=0; b<blocks; ++b) {
+                n += counts[b];
+                sum += sums[b];
+            }
+            QL_REQUIRE(n > 1.0,
+                       "insufficient number of valid paths (" << n
+                       << ") for exercise " << i);
+
+            const Array means = sum/n;
+
+            // second pass: products of the deviations (lower triangle
+            // only) for each block
+            std::vector<Matrix> products(blocks, Matrix(N+1, N+1, 0.0));
+
+            #pragma omp parallel for
+            for (long b=0; b<(long)blocks; ++b) {
+                const auto block = static_cast<Size>(b);
+                const Size end = std::min((block+1)*blockSize, paths);
+                Array temp(N+1);
+                for (Size j=block*blockSize; j<end; ++j) {
+                    if (exerciseData[j].isValid) {
+                        sample(j, temp);
+                        temp -= means;
+                        for (Size k=0; k<=N; ++k)
+                            for (Size l=0; l<=k; ++l)
+                                products[block][k][l] += temp[k]*temp[l];
+                    }
                 }
             }
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
+            Matrix product(N+1, N+1, 0.0);
+            for (Size b=0; b<blocks; ++b)
+                product += products[b];
+
+            const auto covariance = [&](Size k, Size l) {
+                return product[k][l]/(n-1.0);
+            };
 
             Matrix C(N,N);
             Array target(N);
             for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
+                target[k] = covariance(N, k) + means[k]*means[N];
                 for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+                    C[k][l] = C[l][k] = covariance(k, l) + means[k]*means[l];
             }
 
             // 2) solve for least squares regression
@@ -72,7 +137,9 @@ namespace QuantLib {
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
+            #pragma omp parallel for
+            for (long jj=0; jj<(long)paths; ++jj) {
+                const auto j = static_cast<Size>(jj);
                 if (exerciseData[j].isValid) {
                     Real exerciseValue = exerciseData[j].exerciseValue;
                     Real continuationValue =
@@ -34,6 +34,10 @@ namespace QuantLib {
        simulationData[0][j].foo unused (unusable?) if foo != cumulatedCashFlows
 
        basisCoefficients.size() = n
+
+       The regression sums and the exercise decisions are computed in
+       parallel over the paths if OpenMP is enabled; the results don't
+       depend on the number of threads.
     */
     Real genericLongstaffSchwartzRegression(
         std::vector<std::vector<NodeData> >& simulationData,
@@ -32,11 +32,34 @@
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
-#include <utility>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // flat storage of the regression states of the calibration paths
+        inline Size lsmStateSize(Real) { return 1; }
+        inline Size lsmStateSize(const Array& state) { return state.size(); }
+
+        inline void lsmStoreState(Real state, std::vector<Real>& out) {
+            out.push_back(state);
+        }
+        inline void lsmStoreState(const Array& state, std::vector<Real>& out) {
+            out.insert(out.end(), state.begin(), state.end());
+        }
+
+        inline void lsmLoadState(const Real* in, Size, Real& state) {
+            state = *in;
+        }
+        inline void lsmLoadState(const Real* in, Size n, Array& state) {
+            state = Array(in, in+n);
+        }
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -44,6 +67,13 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        By default, the calibration paths are stored as they are.
+        If lean storage is requested, the pricer only stores the
+        exercise values and the regression states at each exercise
+        time in contiguous arrays, which takes a fraction of the
+        memory of the paths and of their time grids; the results
+        are the same.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -56,13 +86,23 @@ namespace QuantLib {
 
         LongstaffSchwartzPathPricer(const TimeGrid& times,
                                     ext::shared_ptr<EarlyExercisePathPricer<PathType> >,
-                                    const ext::shared_ptr<YieldTermStructure>& termStructure);
+                                    const ext::shared_ptr<YieldTermStructure>& termStructure,
+                                    bool leanStorage = false);
 
         Real operator()(const PathType& path) const override;
         virtual void calibrate();
 
+        /*! price of the path according to the calibrated exercise
+            strategy; unlike operator(), it doesn't update the
+            exercise probability and can be called concurrently.
+        */
+        Real value(const PathType& path, bool& exercised) const;
+
         Real exerciseProbability() const;
 
+        //! number of calibration paths stored so far
+        Size calibrationPaths() const;
+
       protected:
         virtual void post_processing(const Size i,
                                      const std::vector<StateType> &state,
@@ -78,19 +118,54 @@ namespace QuantLib {
         std::unique_ptr<DiscountFactor[]> dF_;
 
         mutable std::vector<PathType> paths_;
+        /* with lean storage, exercise values and states of the
+           calibration paths at the times 1...len_-1, path after path */
+        const bool leanStorage_;
+        mutable std::vector<Real> exercise_, states_;
+        mutable Size stateSize_ = 0;
         const   std::vector<std::function<Real(StateType)> > v_;
 
         const Size len_;
     };
 
+    //! path pricer sharing the exercise strategy of a calibrated pricer
+    /*! This allows several threads to price paths with the same
+        calibrated LongstaffSchwartzPathPricer, each keeping its own
+        exercise statistics.
+    */
+    template <class PathType>
+    class LongstaffSchwartzStreamPathPricer : public PathPricer<PathType> {
+      public:
+        explicit LongstaffSchwartzStreamPathPricer(
+            ext::shared_ptr<const LongstaffSchwartzPathPricer<PathType> > pricer)
+        : pricer_(std::move(pricer)) {}
+
+        Real operator()(const PathType& path) const override {
+            bool exercised;
+            const Real price = pricer_->value(path, exercised);
+            exerciseProbability_.add(exercised ? 1.0 : 0.0);
+            return price;
+        }
+
+        const IncrementalStatistics& exerciseStatistics() const {
+            return exerciseProbability_;
+        }
+
+      private:
+        const ext::shared_ptr<const LongstaffSchwartzPathPricer<PathType> >
+            pricer_;
+        mutable IncrementalStatistics exerciseProbability_;
+    };
+
     template <class PathType>
     inline LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
         ext::shared_ptr<EarlyExercisePathPricer<PathType> > pathPricer,
-        const ext::shared_ptr<YieldTermStructure>& termStructure)
+        const ext::shared_ptr<YieldTermStructure>& termStructure,
+        bool leanStorage)
     : pathPricer_(std::move(pathPricer)), coeff_(new Array[times.size() - 2]),
-      dF_(new DiscountFactor[times.size() - 1]), v_(pathPricer_->basisSystem()),
-      len_(times.size()) {
+      dF_(new DiscountFactor[times.size() - 1]), leanStorage_(leanStorage),
+      v_(pathPricer_->basisSystem()), len_(times.size()) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -102,16 +177,42 @@ namespace QuantLib {
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            if (!leanStorage_) {
+                // store paths for the calibration
+                paths_.push_back(path);
+                return 0.0;
+            }
+            // store exercise values and states for the calibration
+            for (Size i=1; i<len_; ++i) {
+                const StateType state = pathPricer_->state(path, i);
+                if (stateSize_ == 0)
+                    stateSize_ = detail::lsmStateSize(state);
+                QL_REQUIRE(detail::lsmStateSize(state) == stateSize_,
+                           "inconsistent state size");
+                exercise_.push_back((*pathPricer_)(path, i));
+                detail::lsmStoreState(state, states_);
+            }
             // result doesn't matter
             return 0.0;
         }
 
+        bool exercised;
+        const Real price = value(path, exercised);
+
+        exerciseProbability_.add(exercised ? 1.0 : 0.0);
+
+        return price;
+    }
+
+    template <class PathType> inline
+    Real LongstaffSchwartzPathPricer<PathType>::value(
+        const PathType& path, bool& exercised) const {
+        QL_REQUIRE(!calibrationPhase_, "pricer not calibrated");
+
         Real price = (*pathPricer_)(path, len_-1);
 
         // Initialize with exercise on last date
-        bool exercised = (price > 0.0);
+        exercised = (price > 0.0);
 
         for (Size i=len_-2; i>0; --i) {
             price*=dF_[i];
@@ -134,22 +235,36 @@ namespace QuantLib {
             }
         }
 
-        exerciseProbability_.add(exercised ? 1.0 : 0.0);
-
         return price*dF_[0];
     }
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
+        const Size m = len_-1;
+        const Size n = calibrationPaths();
+
+        const auto exerciseAt = [&](Size j, Size i) {
+            if (!leanStorage_)
+                return (*pathPricer_)(paths_[j], i);
+            return exercise_[j*m + i-1];
+        };
+        const auto stateAt = [&](Size j, Size i) {
+            if (!leanStorage_)
+                return pathPricer_->state(paths_[j], i);
+            StateType state;
+            detail::lsmLoadState(&states_[(j*m + i-1)*stateSize_],
+                                 stateSize_, state);
+            return state;
+        };
+
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
         std::vector<Real> p_price(n), p_exercise(n);
 
-        for (Size i=0; i<n; ++i) {
-            p_state[i] = pathPricer_->state(paths_[i],len_-1);
-            prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
-            p_exercise[i] = prices[i];
+        for (Size j=0; j<n; ++j) {
+            p_state[j] = stateAt(j, len_-1);
+            prices[j] = p_price[j] = exerciseAt(j, len_-1);
+            p_exercise[j] = prices[j];
         }
 
         post_processing(len_ - 1, p_state, p_price, p_exercise);
@@ -162,9 +277,9 @@ namespace QuantLib {
 
             //roll back step
             for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
+                exercise[j]=exerciseAt(j, i);
                 if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
+                    x.push_back(stateAt(j, i));
                     y.push_back(dF_[i]*prices[j]);
                 }
             }
@@ -190,7 +305,7 @@ namespace QuantLib {
                     }
                     ++k;
                 }
-                p_state[j] = pathPricer_->state(paths_[j],i);
+                p_state[j] = stateAt(j, i);
                 p_price[j] = prices[j];
                 p_exercise[j] = exercise[j];
             }
@@ -198,9 +313,10 @@ namespace QuantLib {
             post_processing(i, p_state, p_price, p_exercise);
         }
 
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
+        // remove calibration data and release memory
+        std::vector<PathType>().swap(paths_);
+        std::vector<Real>().swap(exercise_);
+        std::vector<Real>().swap(states_);
         // entering the calculation phase
         calibrationPhase_ = false;
     }
@@ -210,6 +326,13 @@ namespace QuantLib {
         return exerciseProbability_.mean();
     }
 
+    template <class PathType> inline
+    Size LongstaffSchwartzPathPricer<PathType>::calibrationPaths() const {
+        if (!leanStorage_)
+            return paths_.size();
+        return len_ > 1 ? exercise_.size()/(len_-1) : 0;
+    }
+
 
 }
 
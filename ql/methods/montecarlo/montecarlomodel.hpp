@@ -28,7 +28,9 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -46,6 +48,22 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Alternatively, the model can be built from a number of
+        independent sample streams, each with its own path generator
+        and path pricer.  In this case, the samples requested by each
+        call to addSamples() are split among the streams in a fixed
+        way; the streams are simulated concurrently (if OpenMP is
+        enabled) into separate buffers, which are then added to the
+        sample accumulator in stream order.  Therefore, the results
+        only depend on the number of streams and not on how the
+        threads were scheduled.
+
+        \warning when using several streams, path generators and
+                 pricers are called concurrently; they must not
+                 share any mutable state, and any lazy calculation
+                 in the underlying process should be triggered
+                 beforehand.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -58,7 +76,7 @@ namespace QuantLib {
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
         typedef S stats_type;
-        // constructor
+        // constructors
         MonteCarloModel(
             ext::shared_ptr<path_generator_type> pathGenerator,
             ext::shared_ptr<path_pricer_type> pathPricer,
@@ -68,59 +86,156 @@ namespace QuantLib {
             result_type cvOptionValue = result_type(),
             ext::shared_ptr<path_generator_type> cvPathGenerator =
                 ext::shared_ptr<path_generator_type>())
-        : pathGenerator_(std::move(pathGenerator)), pathPricer_(std::move(pathPricer)),
+        : pathGenerators_(1, std::move(pathGenerator)), pathPricers_(1, std::move(pathPricer)),
+          sampleAccumulator_(std::move(sampleAccumulator)), isAntitheticVariate_(antitheticVariate),
+          cvPathPricers_(1, std::move(cvPathPricer)), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(1, std::move(cvPathGenerator)) {
+            isControlVariate_ = static_cast<bool>(cvPathPricers_[0]);
+        }
+        /*! builds a model with one sample stream for each of the
+            given path generators. The i-th stream uses the i-th
+            path pricer and, if control variates are used, the i-th
+            control-variate path pricer and (if given) generator.
+        */
+        MonteCarloModel(
+            std::vector<ext::shared_ptr<path_generator_type> > pathGenerators,
+            std::vector<ext::shared_ptr<path_pricer_type> > pathPricers,
+            stats_type sampleAccumulator,
+            bool antitheticVariate,
+            std::vector<ext::shared_ptr<path_pricer_type> > cvPathPricers = {},
+            result_type cvOptionValue = result_type(),
+            std::vector<ext::shared_ptr<path_generator_type> > cvPathGenerators = {})
+        : pathGenerators_(std::move(pathGenerators)), pathPricers_(std::move(pathPricers)),
           sampleAccumulator_(std::move(sampleAccumulator)), isAntitheticVariate_(antitheticVariate),
-          cvPathPricer_(std::move(cvPathPricer)), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(std::move(cvPathGenerator)) {
-            isControlVariate_ = static_cast<bool>(cvPathPricer_);
+          cvPathPricers_(std::move(cvPathPricers)), cvOptionValue_(cvOptionValue),
+          cvPathGenerators_(std::move(cvPathGenerators)) {
+            const Size streams = pathGenerators_.size();
+            QL_REQUIRE(streams > 0, "no path generator given");
+            QL_REQUIRE(pathPricers_.size() == streams,
+                       "wrong number of path pricers (" << pathPricers_.size()
+                       << ") for " << streams << " streams");
+            isControlVariate_ = !cvPathPricers_.empty();
+            if (isControlVariate_)
+                QL_REQUIRE(cvPathPricers_.size() == streams,
+                           "wrong number of control-variate path pricers ("
+                           << cvPathPricers_.size() << ") for "
+                           << streams << " streams");
+            else
+                cvPathPricers_.resize(streams);
+            if (!cvPathGenerators_.empty())
+                QL_REQUIRE(cvPathGenerators_.size() == streams,
+                           "wrong number of control-variate path generators ("
+                           << cvPathGenerators_.size() << ") for "
+                           << streams << " streams");
+            else
+                cvPathGenerators_.resize(streams);
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! number of independent sample streams
+        Size streams() const { return pathGenerators_.size(); }
       private:
-        ext::shared_ptr<path_generator_type> pathGenerator_;
-        ext::shared_ptr<path_pricer_type> pathPricer_;
+        result_type nextSample(Size stream, Real& weight) const;
+        std::vector<ext::shared_ptr<path_generator_type> > pathGenerators_;
+        std::vector<ext::shared_ptr<path_pricer_type> > pathPricers_;
         stats_type sampleAccumulator_;
         bool isAntitheticVariate_;
-        ext::shared_ptr<path_pricer_type> cvPathPricer_;
+        std::vector<ext::shared_ptr<path_pricer_type> > cvPathPricers_;
         result_type cvOptionValue_;
         bool isControlVariate_;
-        ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<ext::shared_ptr<path_generator_type> > cvPathGenerators_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
-
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextSample(Size stream, Real& weight) const {
+        const ext::shared_ptr<path_generator_type>& pathGenerator =
+            pathGenerators_[stream];
+        const ext::shared_ptr<path_pricer_type>& pathPricer =
+            pathPricers_[stream];
+        const ext::shared_ptr<path_pricer_type>& cvPathPricer =
+            cvPathPricers_[stream];
+        const ext::shared_ptr<path_generator_type>& cvPathGenerator =
+            cvPathGenerators_[stream];
+
+        const sample_type& path = pathGenerator->next();
+        weight = path.weight;
+        result_type price = (*pathPricer)(path.value);
+
+        if (isControlVariate_) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer)(path.value);
+            }
+            else {
+                const sample_type& cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer)(cvPath.value);
+            }
+        }
 
+        if (isAntitheticVariate_) {
+            const sample_type& atPath = pathGenerator->antithetic();
+            result_type price2 = (*pathPricer)(atPath.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer)(atPath.value);
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer)(cvPath.value);
                 }
             }
 
-            if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
-                    else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+            return result_type((price+price2)/2.0);
+        } else {
+            return price;
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        const Size streams = pathGenerators_.size();
+
+        if (streams == 1) {
+            for(Size j = 1; j <= samples; j++) {
+                Real weight;
+                result_type price = nextSample(0, weight);
+                sampleAccumulator_.add(price, weight);
             }
+            return;
+        }
+
+        // Each stream draws a fixed share of the samples into its
+        // own buffer; exceptions can't cross the parallel region, so
+        // their messages are collected and reported afterwards.
+        std::vector<std::vector<std::pair<result_type, Real> > >
+            buffers(streams);
+        std::vector<std::string> errors(streams);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)streams; ++i) {
+            const auto k = static_cast<Size>(i);
+            const Size n = samples/streams + (k < samples%streams ? 1 : 0);
+            try {
+                buffers[k].reserve(n);
+                for (Size j=0; j<n; ++j) {
+                    Real weight;
+                    result_type price = nextSample(k, weight);
+                    buffers[k].emplace_back(std::move(price), weight);
+                }
+            } catch (std::exception& e) {
+                errors[k] = e.what();
+            } catch (...) {
+                errors[k] = "unknown error";
+            }
+        }
+
+        for (Size k=0; k<streams; ++k)
+            QL_REQUIRE(errors[k].empty(),
+                       "error in sample stream " << k << ": " << errors[k]);
+
+        for (Size k=0; k<streams; ++k) {
+            for (const auto& sample : buffers[k])
+                sampleAccumulator_.add(sample.first, sample.second);
         }
     }
 
@@ -61,21 +61,9 @@ namespace QuantLib {
             break;
           case ImpliedVolError: 
             {
-              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
-              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
-              const Real lowerPrice = blackPrice(minVol);
-              const Real upperPrice = blackPrice(maxVol);
-              const Real modelPrice = modelValue();
-
-              Volatility implied;
-              if (modelPrice <= lowerPrice)
-                  implied = minVol;
-              else if (modelPrice >= upperPrice)
-                  implied = maxVol;
-              else
-                  implied = this->impliedVolatility(
-                                          modelPrice, 1e-12, 5000, minVol, maxVol);
-              error = implied - volatility_->value();
+              bool bounded;
+              error = boundedImpliedVolatility(modelValue(), bounded)
+                  - volatility_->value();
             }
             break;
           default:
@@ -84,4 +72,57 @@ namespace QuantLib {
         
         return error;
     }
+
+    Array BlackCalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            gradient *= ((modelValue() < marketValue()) ? -1.0 : 1.0)
+                / marketValue();
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              bool bounded;
+              const Volatility implied
+                  = boundedImpliedVolatility(modelValue(), bounded);
+
+              if (bounded)
+                  std::fill(gradient.begin(), gradient.end(), 0.0);
+              else {
+                  const Real h = 1e-4*implied;
+                  const Real vega = (blackPrice(implied + h)
+                                     - blackPrice(implied - h))/(2*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
+
+    Volatility BlackCalibrationHelper::boundedImpliedVolatility(
+        Real modelPrice, bool& bounded) const {
+
+        Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+        Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+        const Real lowerPrice = blackPrice(minVol);
+        const Real upperPrice = blackPrice(maxVol);
+
+        bounded = true;
+        if (modelPrice <= lowerPrice)
+            return minVol;
+        else if (modelPrice >= upperPrice)
+            return maxVol;
+
+        bounded = false;
+        return this->impliedVolatility(
+                                modelPrice, 1e-12, 5000, minVol, maxVol);
+    }
 }
@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -42,6 +43,15 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        //! whether calibrationErrorGradient() is available
+        virtual bool hasCalibrationErrorGradient() const { return false; }
+        //! returns the gradient of the error w.r.t. the model parameters
+        /*! It must be implemented by the helpers for which
+            hasCalibrationErrorGradient() returns true.
+        */
+        virtual Array calibrationErrorGradient() {
+            QL_FAIL("calibration error gradient not available");
+        }
     };
 
     //! liquid Black76 market instrument used during calibration
@@ -78,6 +88,22 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
 
+        //! whether modelValueGradient() is available
+        virtual bool hasModelValueGradient() const { return false; }
+
+        //! gradient of the model price w.r.t. the model parameters
+        /*! It must be implemented by the helpers for which
+            hasModelValueGradient() returns true.
+        */
+        virtual Array modelValueGradient() const {
+            QL_FAIL("model value gradient not available");
+        }
+
+        bool hasCalibrationErrorGradient() const override {
+            return hasModelValueGradient();
+        }
+        Array calibrationErrorGradient() override;
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -93,6 +119,9 @@ namespace QuantLib {
         void setPricingEngine(const ext::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
@@ -103,6 +132,10 @@ namespace QuantLib {
 
       private:
         class ImpliedVolatilityHelper;
+        // Black volatility implied by the model price, bounded as
+        // for the calibration error
+        Volatility boundedImpliedVolatility(Real modelPrice,
+                                            bool& bounded) const;
         const CalibrationErrorType calibrationErrorType_;
     };
 
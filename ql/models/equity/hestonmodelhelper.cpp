@@ -23,6 +23,8 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <utility>
@@ -83,6 +85,30 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::hasModelValueGradient() const {
+        if (const ext::shared_ptr<AnalyticHestonEngine> engine =
+                ext::dynamic_pointer_cast<AnalyticHestonEngine>(engine_))
+            return engine->hasPriceGradient();
+        else
+            return ext::dynamic_pointer_cast<AnalyticPTDHestonEngine>(engine_)
+                != nullptr;
+    }
+
+    Array HestonModelHelper::modelValueGradient() const {
+        calculate();
+        const ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::make_shared<PlainVanillaPayoff>(type_, strikePrice_);
+
+        if (const ext::shared_ptr<AnalyticHestonEngine> engine =
+                ext::dynamic_pointer_cast<AnalyticHestonEngine>(engine_))
+            return engine->priceVanillaPayoffGradient(payoff, exerciseDate_);
+        else if (const ext::shared_ptr<AnalyticPTDHestonEngine> engine =
+                ext::dynamic_pointer_cast<AnalyticPTDHestonEngine>(engine_))
+            return engine->priceVanillaPayoffGradient(payoff, exerciseDate_);
+        else
+            QL_FAIL("model value gradient not available for this engine");
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
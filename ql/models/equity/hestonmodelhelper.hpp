@@ -31,6 +31,11 @@
 namespace QuantLib {
 
     //! calibration helper for Heston model
+    /*! Helpers with the same maturity which share an
+        AnalyticHestonEngine or a COSHestonEngine reuse the
+        characteristic function evaluated for the first of them as
+        long as the model parameters don't change.
+    */
     class HestonModelHelper : public BlackCalibrationHelper {
       public:
         HestonModelHelper(const Period& maturity,
@@ -56,6 +61,12 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        /*! analytic gradient, available with an AnalyticHestonEngine
+            providing it (see AnalyticHestonEngine::hasPriceGradient)
+            or an AnalyticPTDHestonEngine
+        */
+        bool hasModelValueGradient() const override;
+        Array modelValueGradient() const override;
         Real blackPrice(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
       private:
@@ -65,6 +65,8 @@ namespace QuantLib {
         Real v0()          const { return arguments_[4](0.0); }
         // spot
         Real s0()          const { return s0_->value(); }
+        // theta, kappa, sigma, rho and v0 as parameters
+        const Parameter& argument(Size i) const { return arguments_.at(i); }
 
         
         const TimeGrid& timeGrid() const;
@@ -48,8 +48,9 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
-      private:
+        //! evolves a single path and returns its weight
         Real singlePathValues(std::vector<Real>& values);
+      private:
 
         ext::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
@@ -33,6 +33,16 @@ namespace QuantLib {
 
         virtual Real nextStep(std::vector<Real>&) = 0;
         virtual Real nextPath() = 0;
+        //! skips the next \f$ n \f$ paths
+        /*! This allows parallel workers, each with its own
+            generator, to draw non-overlapping blocks of paths.
+            The default implementation draws and discards them;
+            generators able to jump ahead should override it.
+        */
+        virtual void skipPaths(Size n) {
+            for (Size i=0; i<n; ++i)
+                nextPath();
+        }
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
@@ -19,6 +19,7 @@
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
+#include <limits>
 
 namespace QuantLib {
 
@@ -207,9 +208,19 @@ namespace QuantLib {
       generator_(SobolRsg(factors * steps, seed, integers), InverseCumulativeNormal()) {}
 
     const SobolRsg::sample_type& SobolBrownianGenerator::nextSequence() {
+        ++pathsDrawn_;
         return generator_.nextSequence();
     }
 
+    void SobolBrownianGenerator::skipPaths(Size n) {
+        if (n == 0)
+            return;
+        QL_REQUIRE(pathsDrawn_ + n <= std::numeric_limits<std::uint32_t>::max(),
+                   "cannot skip beyond the Sobol sequence period");
+        pathsDrawn_ += n;
+        generator_.skipTo(static_cast<std::uint32_t>(pathsDrawn_));
+    }
+
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
                                     SobolBrownianGenerator::Ordering ordering,
                                     unsigned long seed,
@@ -235,9 +246,19 @@ namespace QuantLib {
                  InverseCumulativeNormal()) {}
 
     const Burley2020SobolRsg::sample_type& Burley2020SobolBrownianGenerator::nextSequence() {
+        ++pathsDrawn_;
         return generator_.nextSequence();
     }
 
+    void Burley2020SobolBrownianGenerator::skipPaths(Size n) {
+        if (n == 0)
+            return;
+        QL_REQUIRE(pathsDrawn_ + n <= std::numeric_limits<std::uint32_t>::max(),
+                   "cannot skip beyond the Sobol sequence period");
+        pathsDrawn_ += n;
+        generator_.skipTo(static_cast<std::uint32_t>(pathsDrawn_));
+    }
+
     Burley2020SobolBrownianGeneratorFactory::Burley2020SobolBrownianGeneratorFactory(
         SobolBrownianGenerator::Ordering ordering,
         unsigned long seed,
@@ -84,9 +84,12 @@ namespace QuantLib {
                                unsigned long seed = 0,
                                SobolRsg::DirectionIntegers directionIntegers = SobolRsg::Jaeckel);
 
+        void skipPaths(Size n) override;
+
       private:
         const SobolRsg::sample_type& nextSequence() override;
         InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal> generator_;
+        Size pathsDrawn_ = 0;
     };
 
     class SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -113,9 +116,12 @@ namespace QuantLib {
             SobolRsg::DirectionIntegers directionIntegers = SobolRsg::Jaeckel,
             unsigned long scrambleSeed = 43);
 
+        void skipPaths(Size n) override;
+
       private:
         const Burley2020SobolRsg::sample_type& nextSequence() override;
         InverseCumulativeRsg<Burley2020SobolRsg, InverseCumulativeNormal> generator_;
+        Size pathsDrawn_ = 0;
     };
 
     class Burley2020SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -23,6 +23,8 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/vectorization.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -178,4 +180,131 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "forwards.rows() <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_
+                   && drifts.columns()==forwards.columns(),
+                   "drifts and forwards sizes mismatch");
+
+        if (isFullFactor_)
+            computePlain(forwards, drifts);
+        else
+            computeReduced(forwards, drifts);
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+
+        // Same as the single-path version, with the paths
+        // in the innermost loops.
+
+        const Size paths = forwards.columns();
+        if (pathsTmp_.columns() != paths)
+            pathsTmp_ = Matrix(numberOfRates_, paths);
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* t = pathsTmp_.row_begin(i);
+            const Real d = displacements_[i], x = oneOverTaus_[i];
+            QL_SIMD_LOOP
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+d) / (x+f[p]);
+        }
+
+        // Compute drifts
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Real* drift = drifts.row_begin(i);
+            std::fill(drift, drift+paths, 0.0);
+            for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                const Real* t = pathsTmp_.row_begin(j);
+                const Real c = C_[i][j];
+                QL_SIMD_LOOP
+                for (Size p=0; p<paths; ++p)
+                    drift[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                QL_SIMD_LOOP
+                for (Size p=0; p<paths; ++p)
+                    drift[p] = -drift[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        // Same as the single-path version, with the paths in the
+        // innermost loops; only the e_ column of the current rate
+        // is kept, as a row per factor.
+
+        const Size paths = forwards.columns();
+        if (pathsTmp_.columns() != paths)
+            pathsTmp_ = Matrix(numberOfRates_, paths);
+        if (pathsE_.columns() != paths)
+            pathsE_ = Matrix(numberOfFactors_, paths);
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* t = pathsTmp_.row_begin(i);
+            const Real d = displacements_[i], x = oneOverTaus_[i];
+            QL_SIMD_LOOP
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+d) / (x+f[p]);
+        }
+
+        // 1st step: the drift corresponding to the numeraire P_N is zero.
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: move backward from N-2 (included) back to alive
+        // (included), starting from e_[r][N-1] = 0.
+        std::fill(pathsE_.begin(), pathsE_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* drift = drifts.row_begin(i);
+            std::fill(drift, drift+paths, 0.0);
+            const Real* t = pathsTmp_.row_begin(i+1);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = pathsE_.row_begin(r);
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                QL_SIMD_LOOP
+                for (Size p=0; p<paths; ++p) {
+                    e[p] = e[p] + t[p] * a;
+                    drift[p] -= e[p]*b;
+                }
+            }
+        }
+
+        // 3rd step: move forward from N (included) up to n (excluded),
+        // again starting from e_[r][N-1] = 0.
+        std::fill(pathsE_.begin(), pathsE_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* drift = drifts.row_begin(i);
+            std::fill(drift, drift+paths, 0.0);
+            const Real* t = pathsTmp_.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = pathsE_.row_begin(r);
+                const Real a = pseudo_[i][r];
+                if (i==0) {
+                    QL_SIMD_LOOP
+                    for (Size p=0; p<paths; ++p) {
+                        e[p] = t[p] * a;
+                        drift[p] += e[p]*a;
+                    }
+                } else {
+                    QL_SIMD_LOOP
+                    for (Size p=0; p<paths; ++p) {
+                        e[p] = e[p] + t[p] * a;
+                        drift[p] += e[p]*a;
+                    }
+                }
+            }
+        }
+    }
+
 }
@@ -49,6 +49,19 @@ namespace QuantLib {
                      std::vector<Real>& drifts) const;
         void compute(const std::vector<Rate>& fwds,
                      std::vector<Real>& drifts) const;
+        /*! Computes the drifts of several paths at once. The forwards
+            and the drifts have a row per rate and a column per path;
+            each path goes through the same floating-point operations,
+            in the same order, as in the single-path version.
+
+            \note The results match the single-path ones to the last
+                  bit unless the compiler fuses multiplications and
+                  additions differently in the two versions; the CMake
+                  build disables such contractions for this file when
+                  using GCC or Clang.
+        */
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
 
         /*! Computes the drifts without factor reduction as in
             eqs. 2, 4 of ref. [1] (uses the covariance matrix directly). */
@@ -56,6 +69,8 @@ namespace QuantLib {
                           std::vector<Real>& drifts) const;
         void computePlain(const std::vector<Rate>& fwds,
                           std::vector<Real>& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
 
         /*! Computes the drifts with factor reduction as in eq. 7 of ref. [1]
             (uses pseudo square root of the covariance matrix). */
@@ -63,6 +78,8 @@ namespace QuantLib {
                             std::vector<Real>& drifts) const;
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
 
       private:
         Size numberOfRates_, numberOfFactors_;
@@ -74,6 +91,8 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        // workspace for several paths, resized on demand
+        mutable Matrix pathsTmp_, pathsE_;
         std::vector<Size> downs_, ups_;
     };
 
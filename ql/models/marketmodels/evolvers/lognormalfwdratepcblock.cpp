@@ -0,0 +1,236 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcblock.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/vectorization.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace QuantLib {
+
+    LogNormalFwdRatePcBlock::LogNormalFwdRatePcBlock(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep,
+                           Size blockSize)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep), blockSize_(blockSize),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      curveState_(marketModel->evolution().rateTimes()),
+      currentStep_(initialStep), currentPath_(0), nextPath_(blockSize),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_),
+      alive_(marketModel->evolution().firstAliveRate()),
+      forwards_(numberOfRates_, blockSize), logForwards_(numberOfRates_, blockSize),
+      drifts1_(numberOfRates_, blockSize), drifts2_(numberOfRates_, blockSize),
+      correlatedBrownians_(blockSize), brownians_(numberOfFactors_),
+      pathWeights_(blockSize)
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(blockSize_ > 0, "block size must be positive");
+
+        Size steps = marketModel->evolution().numberOfSteps();
+        QL_REQUIRE(initialStep_ < steps,
+                   "initial step (" << initialStep_
+                   << ") must be less than the number of steps ("
+                   << steps << ")");
+        numberOfSteps_ = steps-initialStep_;
+
+        generator_ = factory.create(numberOfFactors_, numberOfSteps_);
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.emplace_back(A, displacements_, marketModel->evolution().rateTaus(),
+                                      numeraires[j], alive_[j]);
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), Real(0.0));
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        blockBrownians_.assign(numberOfSteps_,
+                               Matrix(numberOfFactors_, blockSize_));
+        stepWeights_ = Matrix(numberOfSteps_, blockSize_);
+        evolvedForwards_.assign(blockSize_*numberOfSteps_,
+                                std::vector<Rate>(numberOfRates_));
+
+        // rates that are never evolved keep their initial value,
+        // as they do in LogNormalFwdRatePc
+        const std::vector<Rate>& initialRates = marketModel_->initialRates();
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialRates[i]);
+
+        setForwards(initialRates);
+    }
+
+    const std::vector<Size>& LogNormalFwdRatePcBlock::numeraires() const {
+        return numeraires_;
+    }
+
+    void LogNormalFwdRatePcBlock::setForwards(const std::vector<Real>& forwards)
+    {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void LogNormalFwdRatePcBlock::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+        // the paths not yet served are evolved again from the new
+        // initial state, with the variates already drawn for them
+        if (nextPath_ < blockSize_)
+            evolveBlock();
+    }
+
+    Real LogNormalFwdRatePcBlock::startNewPath() {
+        if (nextPath_ == blockSize_) {
+            drawBlock();
+            evolveBlock();
+            nextPath_ = 0;
+        }
+        currentPath_ = nextPath_++;
+        currentStep_ = initialStep_;
+        return pathWeights_[currentPath_];
+    }
+
+    void LogNormalFwdRatePcBlock::drawBlock() {
+        for (Size p=0; p<blockSize_; ++p) {
+            pathWeights_[p] = generator_->nextPath();
+            for (Size k=0; k<numberOfSteps_; ++k) {
+                stepWeights_[k][p] = generator_->nextStep(brownians_);
+                for (Size f=0; f<numberOfFactors_; ++f)
+                    blockBrownians_[k][f][p] = brownians_[f];
+            }
+        }
+    }
+
+    void LogNormalFwdRatePcBlock::evolveBlock() {
+
+        // Same steps as LogNormalFwdRatePc::advanceStep(), with the
+        // paths of the block in the innermost loops.
+
+        const Size paths = blockSize_;
+        Real* c = &correlatedBrownians_[0];
+
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+
+        for (Size k=0; k<numberOfSteps_; ++k) {
+            Size step = initialStep_+k;
+
+            // a) compute drifts D1 at T1;
+            if (step > initialStep_) {
+                calculators_[step].compute(forwards_, drifts1_);
+            } else {
+                for (Size i=0; i<numberOfRates_; ++i)
+                    std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                              initialDrifts_[i]);
+            }
+
+            // b) evolve forwards up to T2 using D1;
+            const Matrix& A = marketModel_->pseudoRoot(step);
+            const std::vector<Real>& fixedDrift = fixedDrifts_[step];
+            const Matrix& w = blockBrownians_[k];
+
+            Size alive = alive_[step];
+            for (Size i=alive; i<numberOfRates_; ++i) {
+                Real* l = logForwards_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                const Real fd = fixedDrift[i];
+                QL_SIMD_LOOP
+                for (Size p=0; p<paths; ++p)
+                    l[p] += d1[p] + fd;
+
+                std::fill(c, c+paths, 0.0);
+                for (Size f=0; f<numberOfFactors_; ++f) {
+                    const Real a = A[i][f];
+                    const Real* z = w.row_begin(f);
+                    QL_SIMD_LOOP
+                    for (Size p=0; p<paths; ++p)
+                        c[p] += a*z[p];
+                }
+
+                Real* fwd = forwards_.row_begin(i);
+                const Real d = displacements_[i];
+                for (Size p=0; p<paths; ++p) {
+                    l[p] += c[p];
+                    fwd[p] = std::exp(l[p]) - d;
+                }
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[step].compute(forwards_, drifts2_);
+
+            // d) correct forwards using both drifts
+            for (Size i=alive; i<numberOfRates_; ++i) {
+                Real* l = logForwards_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                const Real* d2 = drifts2_.row_begin(i);
+                Real* fwd = forwards_.row_begin(i);
+                const Real d = displacements_[i];
+                QL_SIMD_LOOP
+                for (Size p=0; p<paths; ++p)
+                    l[p] += (d2[p]-d1[p])/2.0;
+                for (Size p=0; p<paths; ++p)
+                    fwd[p] = std::exp(l[p]) - d;
+            }
+
+            // e) store the forwards for the curve state of each path
+            for (Size p=0; p<paths; ++p) {
+                std::vector<Rate>& evolved = evolvedForwards_[p*numberOfSteps_+k];
+                for (Size i=0; i<numberOfRates_; ++i)
+                    evolved[i] = forwards_[i][p];
+            }
+        }
+    }
+
+    Real LogNormalFwdRatePcBlock::advanceStep()
+    {
+        Size k = currentStep_-initialStep_;
+        curveState_.setOnForwardRates(
+                          evolvedForwards_[currentPath_*numberOfSteps_+k]);
+        ++currentStep_;
+        return stepWeights_[k][currentPath_];
+    }
+
+    Size LogNormalFwdRatePcBlock::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState& LogNormalFwdRatePcBlock::currentState() const {
+        return curveState_;
+    }
+
+}
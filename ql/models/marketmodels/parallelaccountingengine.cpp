@@ -0,0 +1,149 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/models/marketmodels/evolver.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // keeps the generator it creates, so that it can be moved
+        // forward after the evolver using it was built
+        class RecordingBrownianGeneratorFactory : public BrownianGeneratorFactory {
+          public:
+            explicit RecordingBrownianGeneratorFactory(
+                                     const BrownianGeneratorFactory& factory)
+            : factory_(factory) {}
+            ext::shared_ptr<BrownianGenerator> create(Size factors,
+                                                        Size steps) const override {
+                QL_REQUIRE(!generator_,
+                           "evolver factory created more than one generator");
+                generator_ = factory_.create(factors, steps);
+                return generator_;
+            }
+            const ext::shared_ptr<BrownianGenerator>& generator() const {
+                return generator_;
+            }
+          private:
+            const BrownianGeneratorFactory& factory_;
+            mutable ext::shared_ptr<BrownianGenerator> generator_;
+        };
+
+    }
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+                        EvolverFactory evolverFactory,
+                        ext::shared_ptr<BrownianGeneratorFactory> generatorFactory,
+                        const Clone<MarketModelMultiProduct>& product,
+                        Real initialNumeraireValue,
+                        Size threads)
+    : evolverFactory_(std::move(evolverFactory)),
+      generatorFactory_(std::move(generatorFactory)), product_(product),
+      initialNumeraireValue_(initialNumeraireValue), threads_(threads) {
+        QL_REQUIRE(evolverFactory_, "no evolver factory given");
+        QL_REQUIRE(generatorFactory_, "no Brownian generator factory given");
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
+        engines_.resize(threads_);
+        generators_.resize(threads_);
+        nextPath_.resize(threads_, 0);
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                               SequenceStatisticsInc& stats,
+                                               Size numberOfPaths) {
+        if (numberOfPaths == 0)
+            return;
+
+        const Size numberProducts = product_->numberOfProducts();
+        const Size workers = threads_;
+
+        // contiguous blocks of paths, worker w evolving [first[w], first[w+1])
+        std::vector<Size> first(workers+1);
+        for (Size w=0; w<=workers; ++w)
+            first[w] = (numberOfPaths*w)/workers;
+
+        std::vector<Real> values(numberOfPaths*numberProducts);
+        std::vector<Real> weights(numberOfPaths);
+
+        // exceptions can't cross the parallel region, so their
+        // messages are collected and reported afterwards
+        std::vector<std::string> messages(workers);
+        #pragma omp parallel for num_threads(static_cast<int>(workers)) schedule(static)
+        for (long j=0; j<(long)workers; j++) {
+            const auto w = static_cast<Size>(j);
+            if (first[w] == first[w+1])
+                continue;
+            try {
+                if (!engines_[w]) {
+                    RecordingBrownianGeneratorFactory factory(*generatorFactory_);
+                    engines_[w] = ext::make_shared<AccountingEngine>(
+                        evolverFactory_(factory), product_,
+                        initialNumeraireValue_);
+                    QL_REQUIRE(factory.generator(),
+                               "evolver factory created no generator");
+                    generators_[w] = factory.generator();
+                }
+                // paths never overlap between threads, so the
+                // generator only moves forward
+                generators_[w]->skipPaths(pathsDone_ + first[w] - nextPath_[w]);
+                nextPath_[w] = pathsDone_ + first[w+1];
+
+                std::vector<Real> pathValues(numberProducts);
+                for (Size i=first[w]; i<first[w+1]; ++i) {
+                    weights[i] = engines_[w]->singlePathValues(pathValues);
+                    std::copy(pathValues.begin(), pathValues.end(),
+                              values.begin() + i*numberProducts);
+                }
+            } catch (std::exception& e) {
+                messages[w] = e.what();
+            } catch (...) {
+                messages[w] = "unknown error";
+            }
+        }
+        for (Size w=0; w<workers; ++w) {
+            if (!messages[w].empty()) {
+                // the paths of this call are not counted, but the
+                // other workers moved past them and the position of
+                // the failed generator is unknown; the next call
+                // builds new evolvers for all workers
+                for (Size v=0; v<workers; ++v) {
+                    engines_[v].reset();
+                    generators_[v].reset();
+                    nextPath_[v] = 0;
+                }
+                QL_FAIL("error in simulation of paths " << pathsDone_+first[w]
+                        << " to " << pathsDone_+first[w+1]-1 << ": "
+                        << messages[w]);
+            }
+        }
+
+        // adding the values in path order reproduces the serial results
+        for (Size i=0; i<numberOfPaths; ++i)
+            stats.add(values.begin() + i*numberProducts,
+                      values.begin() + (i+1)*numberProducts,
+                      weights[i]);
+
+        pathsDone_ += numberOfPaths;
+    }
+
+}
@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief multi-threaded accounting engine for market-model simulations
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/utilities/clone.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    class AccountingEngine;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+    class MarketModelEvolver;
+
+    //! Multi-threaded engine collecting cash flows along a market-model simulation
+    /*! The paths are split into contiguous blocks, one per thread.
+        Each thread keeps its own evolver, built through the given
+        factory at the first call, and its own copy of the product.
+        Before evolving its block, a thread moves the Brownian
+        generator of its evolver forward to the start of the block.
+        The path values are added to the statistics in path order, so
+        that the results are the same as the ones of an
+        AccountingEngine using the same evolver and generator
+        factory, for any number of threads.
+
+        Successive calls to multiplePathValues() continue the
+        sequence of paths, as they do for AccountingEngine; the
+        evolvers are kept between calls and each generator only
+        moves over the paths drawn by the other threads since its
+        last block.
+
+        If a thread fails, the call throws without adding any of its
+        paths to the statistics and all evolvers are rebuilt at the
+        next call, which simulates the same paths again.
+
+        \warning The Sobol generators jump ahead in constant time.
+                 The Mersenne-Twister generator has no skip-ahead and
+                 draws and discards the paths it moves over, so that
+                 each thread draws the uniforms of all paths and the
+                 work of the generators grows as the number of threads
+                 times the number of paths.  The uniforms are cheap
+                 compared to the evolution, but with many threads and
+                 a short evolution the skipping can dominate; a Sobol
+                 generator avoids it.
+
+        \warning The evolver factory is called concurrently from
+                 different threads and must be thread-safe; building
+                 an evolver from a shared market model is.
+    */
+    class ParallelAccountingEngine {
+      public:
+        typedef std::function<ext::shared_ptr<MarketModelEvolver>(
+            const BrownianGeneratorFactory&)> EvolverFactory;
+
+        ParallelAccountingEngine(EvolverFactory evolverFactory,
+                                 ext::shared_ptr<BrownianGeneratorFactory> generatorFactory,
+                                 const Clone<MarketModelMultiProduct>& product,
+                                 Real initialNumeraireValue,
+                                 Size threads);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        EvolverFactory evolverFactory_;
+        ext::shared_ptr<BrownianGeneratorFactory> generatorFactory_;
+        Clone<MarketModelMultiProduct> product_;
+        Real initialNumeraireValue_;
+        Size threads_;
+        Size pathsDone_ = 0;
+        // per thread: its engine, the generator of its evolver and
+        // the index of the next path the generator will draw
+        std::vector<ext::shared_ptr<AccountingEngine> > engines_;
+        std::vector<ext::shared_ptr<BrownianGenerator> > generators_;
+        std::vector<Size> nextPath_;
+    };
+
+}
+
+#endif
@@ -23,6 +23,9 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/models/model.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <algorithm>
+#include <map>
+#include <string>
 #include <utility>
 
 using std::vector;
@@ -37,39 +40,112 @@ namespace QuantLib {
         CalibrationFunction(CalibratedModel* model,
                             const vector<ext::shared_ptr<CalibrationHelper> >& h,
                             vector<Real> weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            Size threads = 1,
+                            vector<vector<Size> > groups = vector<vector<Size> >())
         : model_(model, null_deleter()), instruments_(h), weights_(std::move(weights)),
-          projection_(projection) {}
+          projection_(projection), threads_(threads), groups_(std::move(groups)),
+          analyticJacobian_(std::all_of(
+              h.begin(), h.end(),
+              [](const ext::shared_ptr<CalibrationHelper>& helper) {
+                  return helper->hasCalibrationErrorGradient();
+              })) {}
 
         ~CalibrationFunction() override = default;
 
         Real value(const Array& params) const override {
             model_->setParams(projection_.include(params));
+            const Array diff = errors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
+                value += diff[i]*diff[i]*weights_[i];
             }
             return std::sqrt(value);
         }
 
         Array values(const Array& params) const override {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = errors();
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        /*! uses the analytic gradients of the calibration errors
+            if all helpers provide them, finite differences otherwise
+        */
+        void jacobian(Matrix& jac, const Array& params) const override {
+            if (!analyticJacobian_) {
+                CostFunction::jacobian(jac, params);
+                return;
+            }
+
+            model_->setParams(projection_.include(params));
+
+            const Size n = instruments_.size();
+            vector<Array> gradients(n);
+            forEachInstrument([&](Size i) {
+                gradients[i] = instruments_[i]->calibrationErrorGradient();
+            });
+
+            for (Size i=0; i<n; i++) {
+                const Array gradient = projection_.project(gradients[i]);
+                for (Size j=0; j<gradient.size(); j++)
+                    jac[i][j] = gradient[j]*std::sqrt(weights_[i]);
+            }
+        }
+
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        Array errors() const {
+            Array errors(instruments_.size());
+            forEachInstrument([&](Size i) {
+                errors[i] = instruments_[i]->calibrationError();
+            });
+            return errors;
+        }
+
+        // the groups are evaluated concurrently, the helpers of
+        // each group one after the other and in their order
+        template <class F>
+        void forEachInstrument(const F& f) const {
+            const Size n = instruments_.size();
+            if (threads_ == 1 || groups_.size() < 2) {
+                for (Size i=0; i<n; i++)
+                    f(i);
+                return;
+            }
+
+            // exceptions can't cross the parallel region, so their
+            // messages are collected and reported afterwards
+            vector<std::string> messages(n);
+            #pragma omp parallel for num_threads(static_cast<int>(threads_)) schedule(dynamic)
+            for (long j=0; j<(long)groups_.size(); j++) {
+                for (Size i : groups_[static_cast<Size>(j)]) {
+                    try {
+                        f(i);
+                    } catch (std::exception& e) {
+                        messages[i] = e.what();
+                    } catch (...) {
+                        messages[i] = "unknown error";
+                    }
+                }
+            }
+            for (Size i=0; i<n; i++)
+                QL_REQUIRE(messages[i].empty(),
+                           "error in calibration helper " << i << ": "
+                           << messages[i]);
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        const Size threads_;
+        const vector<vector<Size> > groups_;
+        const bool analyticJacobian_;
     };
 
     void CalibratedModel::calibrate(
@@ -102,7 +178,33 @@ namespace QuantLib {
                    fixParameters.size() << ")");
         vector<bool> all(prms.size(), false);
         Projection proj(prms, !fixParameters.empty() ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+
+        // helpers sharing a pricing engine are evaluated by the same
+        // thread, so that they can reuse the results it caches
+        vector<vector<Size> > groups;
+        if (calibrationThreads_ > 1) {
+            std::map<const PricingEngine*, Size> engines;
+            for (Size i=0; i<instruments.size(); i++) {
+                const auto helper =
+                    ext::dynamic_pointer_cast<BlackCalibrationHelper>(instruments[i]);
+                if (helper != nullptr && helper->pricingEngine() != nullptr) {
+                    const auto group = engines.emplace(
+                        helper->pricingEngine().get(), groups.size());
+                    if (group.second)
+                        groups.emplace_back();
+                    groups[group.first->second].push_back(i);
+                } else {
+                    groups.emplace_back(1, i);
+                }
+            }
+            // lazy objects are not thread safe; the first evaluation
+            // triggers their calculation, so that the concurrent ones
+            // only read them
+            for (const auto& instrument : instruments)
+                instrument->calibrationError();
+        }
+
+        CalibrationFunction f(this,instruments,w,proj,calibrationThreads_,groups);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -135,6 +237,11 @@ namespace QuantLib {
         return params;
     }
 
+    void CalibratedModel::setCalibrationThreads(Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        calibrationThreads_ = threads;
+    }
+
     void CalibratedModel::setParams(const Array& params) {
         Array::const_iterator p = params.begin();
         for (auto& argument : arguments_) {
@@ -95,6 +95,13 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all helpers provide analytic gradients of their
+            calibration errors (as checked once, at the start of the
+            calibration, through hasCalibrationErrorGradient()) the
+            jacobian of the cost function is calculated from them;
+            LevenbergMarquardt uses it when constructed with
+            useCostFunctionsJacobian = true.
         */
         virtual void calibrate(
                 const std::vector<ext::shared_ptr<CalibrationHelper> >&,
@@ -121,6 +128,25 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! number of threads evaluating the calibration helpers
+        /*! If more than one thread is used (and OpenMP is enabled),
+            the errors of the calibration helpers are evaluated
+            concurrently for each set of parameters tried by the
+            optimizer, including the finite-difference Jacobian
+            columns of LevenbergMarquardt.  Helpers sharing a pricing
+            engine are evaluated by the same thread, one after the
+            other, so that the engine is never used concurrently and
+            can reuse what it caches between them (e.g., the slices
+            of AnalyticHestonEngine for helpers with the same
+            maturity); the engines should then be shared by the
+            helpers of each maturity, so that there are enough groups
+            to be distributed among the threads.  Lazy calculations
+            in the market data the helpers depend on are triggered by
+            a serial evaluation at the start of the calibration.
+        */
+        void setCalibrationThreads(Size threads);
+        Size calibrationThreads() const { return calibrationThreads_; }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -130,6 +156,7 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        Size calibrationThreads_ = 1;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -45,6 +45,7 @@ namespace QuantLib {
         ext::shared_ptr<Payoff> payoff() const { return payoff_; }
         ext::shared_ptr<Exercise> exercise() const { return exercise_; }
       protected:
+        bool calculatedByEngine() const override { return true; }
         // arguments
         ext::shared_ptr<Payoff> payoff_;
         ext::shared_ptr<Exercise> exercise_;
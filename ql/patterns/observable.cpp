@@ -23,6 +23,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <unordered_map>
+
 namespace QuantLib {
 
     void ObservableSettings::enableUpdates() {
@@ -54,14 +56,26 @@ namespace QuantLib {
 
 
     void Observable::notifyObservers() {
-        if (!ObservableSettings::instance().updatesEnabled()) {
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.batching()) {
+            // collected and sent when the batch is flushed
+            settings.collectNotification(this);
+        } else if (!settings.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
-            ObservableSettings::instance().registerDeferredObservers(observers_);
+            settings.registerDeferredObservers(observers_);
         } else if (!observers_.empty()) {
             bool successful = true;
             std::string errMsg;
-            for (auto* observer : observers_) {
+            // observers might unregister (leaving a tombstone) or
+            // register (appending to the vector) during the loop, so
+            // we use indices and skip the observers added meanwhile
+            ++notifying_;
+            const Size n = observers_.size();
+            for (Size i=0; i<n; ++i) {
+                Observer* observer = observers_[i];
+                if (observer == nullptr)
+                    continue;
                 try {
                     observer->update();
                 } catch (std::exception& e) {
@@ -78,128 +92,440 @@ namespace QuantLib {
                     successful = false;
                 }
             }
+            if (--notifying_ == 0 && 2 * tombstones_ >= observers_.size())
+                compact();
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
     }
 
-}
+    void Observable::compact() {
+        Size j = 0;
+        for (Size i=0; i<observers_.size(); ++i) {
+            if (observers_[i] != nullptr) {
+                if (i != j) {
+                    observers_[j] = observers_[i];
+                    observers_[j]->relocate(this, j);
+                }
+                ++j;
+            }
+        }
+        observers_.resize(j);
+        tombstones_ = 0;
+    }
 
-#else
 
-#include <boost/signals2/signal_type.hpp>
+    // the part of the observer graph reached by a batch of notifications
+    struct ObservableSettings::FlushState {
+        struct Node {
+            Observer* observer;
+            // the same object seen as an observable, if it is one
+            Observable* observable;
+            std::vector<Size> successors;
+            Size pending = 0;
+            bool fired = false, alive = true, done = false;
+        };
 
-namespace QuantLib {
+        Size node(Observer* o) {
+            auto i = index.find(o);
+            if (i != index.end())
+                return i->second;
+            index.emplace(o, nodes.size());
+            nodes.push_back({o, dynamic_cast<Observable*>(o), {}});
+            return nodes.size() - 1;
+        }
 
-    namespace detail {
+        std::vector<Node> nodes;
+        std::unordered_map<const Observer*, Size> index;
+    };
 
-        class Signal {
-          public:
-            typedef boost::signals2::signal_type<
-                void(),
-                boost::signals2::keywords::mutex_type<std::recursive_mutex> >
-                ::type signal_type;
+    void ObservableSettings::endBatch() {
+        QL_REQUIRE(batchDepth_ > 0, "no active notification batch");
+        if (--batchDepth_ == 0)
+            flushNotifications();
+    }
 
-            void connect(const signal_type::slot_type& slot) {
-                sig_.connect(slot);
+    void ObservableSettings::flushBatch() {
+        // inner batches leave the flush to the outermost one
+        if (batchDepth_ == 1)
+            flushNotifications();
+    }
+
+    void ObservableSettings::unregisterBatchedObserver(const Observer* o) {
+        auto i = flushing_->index.find(o);
+        if (i != flushing_->index.end())
+            flushing_->nodes[i->second].alive = false;
+    }
+
+    void ObservableSettings::flushNotifications() {
+        // if we're already flushing, the outer loop below will
+        // take care of the notifications collected meanwhile
+        if (flushing_ != nullptr)
+            return;
+
+        bool successful = true;
+        std::string errMsg;
+
+        while (!batchedObservables_.empty()) {
+            std::vector<Observable*> sources;
+            sources.swap(batchedObservables_);
+            for (auto* source : sources) {
+                if (source != nullptr)
+                    source->batchState_ = Observable::NotBatched;
             }
 
-            template <class T>
-            void disconnect(const T& slot) {
-                sig_.disconnect(slot);
+            if (!updatesEnabled_) {
+                // as in Observable::notifyObservers
+                for (auto* source : sources) {
+                    if (source != nullptr)
+                        registerDeferredObservers(source->observers_);
+                }
+                continue;
             }
 
-            void operator()() const {
-                sig_();
+            FlushState state;
+            for (auto* source : sources) {
+                if (source == nullptr)
+                    continue;
+                for (auto* observer : source->observers_) {
+                    if (observer != nullptr)
+                        state.nodes[state.node(observer)].fired = true;
+                }
+            }
+            // the vector grows while we walk it, so that the graph is
+            // visited breadth-first
+            for (Size i=0; i<state.nodes.size(); ++i) {
+                Observable* observable = state.nodes[i].observable;
+                if (observable == nullptr)
+                    continue;
+                for (auto* observer : observable->observers_) {
+                    if (observer != nullptr) {
+                        Size j = state.node(observer);
+                        state.nodes[i].successors.push_back(j);
+                        ++state.nodes[j].pending;
+                    }
+                }
             }
-          private:
-            signal_type sig_;
-        };
 
-        template <class T>
-        class ProxyUpdater {
-            T* proxy_;
+            std::vector<Size> ready;
+            for (Size i=0; i<state.nodes.size(); ++i) {
+                if (state.nodes[i].pending == 0)
+                    ready.push_back(i);
+            }
+
+            // an observer is updated once, after all its observables,
+            // and only if at least one of them notified
+            auto process = [&](Size i) {
+                FlushState::Node& node = state.nodes[i];
+                node.done = true;
+                if (node.fired && node.alive) {
+                    ++batchedUpdates_;
+                    try {
+                        node.observer->update();
+                    } catch (std::exception& e) {
+                        successful = false;
+                        errMsg = e.what();
+                    } catch (...) {
+                        successful = false;
+                    }
+                }
+                bool fired = false;
+                if (node.alive && node.observable != nullptr &&
+                    node.observable->batchState_ == Observable::Batched) {
+                    // delivered to the successors below
+                    fired = true;
+                    node.observable->batchState_ = Observable::Delivered;
+                }
+                for (Size j : node.successors) {
+                    FlushState::Node& successor = state.nodes[j];
+                    if (successor.done)
+                        continue;
+                    successor.fired = successor.fired || fired;
+                    if (--successor.pending == 0)
+                        ready.push_back(j);
+                }
+            };
+
+            flushing_ = &state;
+            try {
+                Size next = 0;
+                auto drain = [&]() {
+                    while (next < ready.size())
+                        process(ready[next++]);
+                };
+                drain();
+                // what's left is part of a cycle; we can only break it
+                // in the order the nodes were discovered
+                for (Size i=0; i<state.nodes.size(); ++i) {
+                    if (!state.nodes[i].done) {
+                        process(i);
+                        drain();
+                    }
+                }
+            } catch (...) {
+                flushing_ = nullptr;
+                throw;
+            }
+            flushing_ = nullptr;
+
+            // keep the observables notified during the flush by
+            // something outside the graph visited above
+            auto delivered = [](Observable* o) {
+                if (o == nullptr)
+                    return true;
+                if (o->batchState_ == Observable::Delivered) {
+                    o->batchState_ = Observable::NotBatched;
+                    return true;
+                }
+                return false;
+            };
+            batchedObservables_.erase(
+                std::remove_if(batchedObservables_.begin(),
+                               batchedObservables_.end(), delivered),
+                batchedObservables_.end());
+        }
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+}
+
+#else
+
+#include <cstdint>
+#include <unordered_set>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        template <class Proxy>
+        class ObserverShards {
           public:
-            explicit ProxyUpdater(const ext::shared_ptr<T>& observerProxy)
-            : proxy_(observerProxy.get()) {}
+            // a handful of shards is enough to spread the registrations
+            // coming from a typical thread pool
+            static constexpr std::size_t size = 8;
 
-            void operator()() const {
-                proxy_->update();
+            struct Hash {
+                std::size_t operator()(const ext::shared_ptr<Proxy>& p) const {
+                    return std::hash<Proxy*>()(p.get());
+                }
+            };
+
+            // each shard on its own cache line to avoid false sharing
+            struct alignas(64) Shard {
+                std::mutex mutex;
+                std::unordered_set<ext::shared_ptr<Proxy>, Hash> observers;
+            };
+
+            Shard& shard(const ext::shared_ptr<Proxy>& proxy) {
+                // proxies are heap-allocated, so the low bits of their
+                // addresses carry no information
+                const auto address = reinterpret_cast<std::uintptr_t>(proxy.get());
+                return shards_[((address >> 4) ^ (address >> 10)) % size];
             }
 
-            bool operator==(const ProxyUpdater<T>& other) const {
-                return proxy_ == other.proxy_;
+            void insert(const ext::shared_ptr<Proxy>& proxy) {
+                Shard& s = shard(proxy);
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.observers.insert(proxy);
             }
 
-            bool operator!=(const ProxyUpdater<T>& other) const {
-                return proxy_ != other.proxy_;
+            void erase(const ext::shared_ptr<Proxy>& proxy) {
+                Shard& s = shard(proxy);
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.observers.erase(proxy);
             }
+
+            /* copies the registered proxies; the copies keep them alive
+               while they are notified outside of the shard locks. */
+            void snapshot(std::vector<ext::shared_ptr<Proxy>>& proxies) {
+                for (auto& s : shards_) {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    proxies.insert(proxies.end(),
+                                   s.observers.begin(), s.observers.end());
+                }
+            }
+
+          private:
+            Shard shards_[size];
         };
 
     }
 
-    void Observable::registerObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy) {
-        {
-            std::lock_guard<std::recursive_mutex> lock(mutex_);
-            observers_.insert(observerProxy);
+    Observable::shards_type* Observable::shards() {
+        shards_type* shards = shards_.load(std::memory_order_acquire);
+        if (shards == nullptr) {
+            auto* newShards = new shards_type;
+            if (shards_.compare_exchange_strong(shards, newShards,
+                                                std::memory_order_acq_rel)) {
+                shards = newShards;
+            } else {
+                // another thread was faster; shards now holds its value
+                delete newShards;
+            }
         }
+        return shards;
+    }
 
-        detail::Signal::signal_type::slot_type slot {detail::ProxyUpdater<Observer::Proxy>(observerProxy)};
-        #if defined(QL_USE_STD_SHARED_PTR)
-        sig_->connect(slot.track_foreign(observerProxy));
-        #else
-        sig_->connect(slot.track(observerProxy));
-        #endif
+    void Observable::registerObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy) {
+        shards()->insert(observerProxy);
     }
 
-    void Observable::unregisterObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy,
-                                        bool disconnect) {
-        {
-            std::lock_guard<std::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
-        }
+    void Observable::unregisterObserver(const ext::shared_ptr<Observer::Proxy>& observerProxy) {
+        if (shards_type* shards = shards_.load(std::memory_order_acquire))
+            shards->erase(observerProxy);
 
         if (ObservableSettings::instance().updatesDeferred()) {
             std::lock_guard<std::mutex> sLock(ObservableSettings::instance().mutex_);
             if (ObservableSettings::instance().updatesDeferred())
                 ObservableSettings::instance().unregisterDeferredObserver(observerProxy);
         }
-
-        if (disconnect) {
-            sig_->disconnect(detail::ProxyUpdater<Observer::Proxy>(observerProxy));
-        }
     }
 
     void Observable::notifyObservers() {
-        if (ObservableSettings::instance().updatesEnabled()) {
-            sig_->operator()();
-        }
-        else {
-            bool updatesEnabled = false;
-            {
-                std::lock_guard<std::mutex> sLock(ObservableSettings::instance().mutex_);
-                updatesEnabled = ObservableSettings::instance().updatesEnabled();
+        shards_type* shards = shards_.load(std::memory_order_acquire);
+        if (shards == nullptr)
+            return;
 
+        proxy_list proxies;
+        if (!ObservableSettings::instance().updatesEnabled()) {
+            std::lock_guard<std::mutex> sLock(ObservableSettings::instance().mutex_);
+            if (!ObservableSettings::instance().updatesEnabled()) {
                 if (ObservableSettings::instance().updatesDeferred()) {
-                    std::lock_guard<std::recursive_mutex> lock(mutex_);
-                    ObservableSettings::instance().registerDeferredObservers(observers_);
+                    shards->snapshot(proxies);
+                    ObservableSettings::instance().registerDeferredObservers(proxies);
                 }
+                return;
             }
+        }
+
+        shards->snapshot(proxies);
+
+        ObservableSettings::BatchState& batch = ObservableSettings::batchState();
+        if (batch.depth > 0) {
+            // collected and sent when the batch of this thread is flushed
+            ++batch.suppressedNotifications;
+            batch.observers.insert(proxies.begin(), proxies.end());
+            return;
+        }
 
-            if (updatesEnabled)
-                sig_->operator()();
+        bool successful = true;
+        std::string errMsg;
+        for (const auto& proxy : proxies) {
+            try {
+                proxy->update();
+            } catch (std::exception& e) {
+                // see the non-thread-safe implementation above
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
         }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
     Observable::Observable()
-    : sig_(new detail::Signal()) { }
+    : shards_(nullptr) { }
 
     Observable::Observable(const Observable&)
-    : sig_(new detail::Signal()) {
+    : shards_(nullptr) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
 
+    Observable::~Observable() {
+        delete shards_.load(std::memory_order_acquire);
+    }
+
+    ObservableSettings::BatchState& ObservableSettings::batchState() {
+        static thread_local BatchState state;
+        return state;
+    }
+
+    void ObservableSettings::endBatch() {
+        BatchState& batch = batchState();
+        QL_REQUIRE(batch.depth > 0, "no active notification batch");
+        if (--batch.depth == 0)
+            flushNotifications();
+    }
+
+    void ObservableSettings::flushBatch() {
+        BatchState& batch = batchState();
+        // inner batches leave the flush to the outermost one
+        if (batch.depth == 1) {
+            // notifications sent by the updated observers go through
+            batch.depth = 0;
+            try {
+                flushNotifications();
+            } catch (...) {
+                batch.depth = 1;
+                throw;
+            }
+            batch.depth = 1;
+        }
+    }
+
+    void ObservableSettings::flushNotifications() {
+        BatchState& batch = batchState();
+        bool successful = true;
+        std::string errMsg;
+        while (!batch.observers.empty()) {
+            set_type observers;
+            observers.swap(batch.observers);
+            for (const auto& i : observers) {
+                try {
+                    const ext::shared_ptr<Observer::Proxy> proxy = i.lock();
+                    if (proxy) {
+                        ++batch.updates;
+                        proxy->update();
+                    }
+                } catch (std::exception& e) {
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
 }
 
 #endif
+
+namespace QuantLib {
+
+    NotificationBatch::NotificationBatch()
+    : suppressedNotifications_(ObservableSettings::instance().suppressedNotifications()),
+      updates_(ObservableSettings::instance().batchedUpdates()) {
+        ObservableSettings::instance().beginBatch();
+    }
+
+    NotificationBatch::~NotificationBatch() {
+        try {
+            ObservableSettings::instance().endBatch();
+        } catch (...) {
+            // nothing we can do in a destructor; see the class docs
+        }
+    }
+
+    void NotificationBatch::flush() {
+        ObservableSettings::instance().flushBatch();
+    }
+
+    Size NotificationBatch::suppressedNotifications() const {
+        return ObservableSettings::instance().suppressedNotifications()
+            - suppressedNotifications_;
+    }
+
+    Size NotificationBatch::updates() const {
+        return ObservableSettings::instance().batchedUpdates() - updates_;
+    }
+
+}
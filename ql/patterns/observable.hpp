@@ -33,7 +33,11 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/patterns/singleton.hpp>
 #include <ql/shared_ptr.hpp>
 #include <ql/types.hpp>
+#include <algorithm>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #if !defined(QL_USE_STD_SHARED_PTR) && BOOST_VERSION < 107400
 
@@ -56,9 +60,16 @@ namespace QuantLib {
 
     class Observer;
     class ObservableSettings;
+    class NotificationBatch;
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! Observers are stored in a flat vector.  Unregistered observers
+        leave a null tombstone behind, so that removals are O(1) and
+        safe during notification; tombstones are compacted away once
+        they make up half of the vector.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
         friend class ObservableSettings;
@@ -70,23 +81,31 @@ namespace QuantLib {
         // delete the move operations because the semantics are not yet clear
         Observable(Observable&&) = delete;
         Observable& operator=(Observable&&) = delete;
-        virtual ~Observable() = default;
+        virtual ~Observable();
         /*! This method should be called at the end of non-const methods
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*> set_type;
-        typedef set_type::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
-        Size unregisterObserver(Observer*);
+        typedef std::vector<Observer*> set_type;
+        // returns the slot of the new observer
+        Size registerObserver(Observer*);
+        void unregisterObserver(Observer*, Size slot);
+        void compact();
         set_type observers_;
+        Size tombstones_ = 0;
+        unsigned int notifying_ = 0;
+        // whether the observable is listed among the ones notified
+        // while a NotificationBatch was active
+        enum BatchState { NotBatched, Batched, Delivered };
+        BatchState batchState_ = NotBatched;
     };
 
     //! global repository for run-time library settings
     class ObservableSettings : public Singleton<ObservableSettings> {
         friend class Singleton<ObservableSettings>;
         friend class Observable;
+        friend class NotificationBatch;
       public:
         void disableUpdates(bool deferred=false) {
             updatesEnabled_  = false;
@@ -109,13 +128,44 @@ namespace QuantLib {
         set_type deferredObservers_;
 
         bool updatesEnabled_ = true, updatesDeferred_ = false;
+
+        // notification batches, see NotificationBatch
+        struct FlushState;
+
+        bool batching() const { return batchDepth_ > 0 || flushing_ != nullptr; }
+        void beginBatch() { ++batchDepth_; }
+        void endBatch();
+        void flushBatch();
+        void flushNotifications();
+        void collectNotification(Observable*);
+        void unregisterBatchedObservable(const Observable*);
+        void unregisterBatchedObserver(const Observer*);
+
+        Size suppressedNotifications() const { return suppressedNotifications_; }
+        Size batchedUpdates() const { return batchedUpdates_; }
+
+        std::vector<Observable*> batchedObservables_;
+        Size batchDepth_ = 0;
+        FlushState* flushing_ = nullptr;
+        Size suppressedNotifications_ = 0, batchedUpdates_ = 0;
     };
 
     //! Object that gets notified when a given observable changes
-    /*! \ingroup patterns */
+    /*! The observables are kept in a flat vector.  Observers
+        registered with many of them also keep a hash index of the
+        vector, so that registration and removal are O(1) on
+        average and don't need a linear search.
+
+        \warning The iterator returned by registerWith() points into
+                 the vector, and is invalidated by any later
+                 registration or unregistration.
+
+        \ingroup patterns
+    */
     class Observer { // NOLINT(cppcoreguidelines-special-member-functions)
+        friend class Observable;
       private:
-        typedef std::set<ext::shared_ptr<Observable>> set_type;
+        typedef std::vector<ext::shared_ptr<Observable>> set_type;
       public:
         typedef set_type::iterator iterator;
 
@@ -152,7 +202,17 @@ namespace QuantLib {
         virtual void deepUpdate();
 
       private:
+        // position of the given observable, or the number of
+        // observables if not registered
+        Size position(const Observable*) const;
+        void buildIndex();
+        void relocate(const Observable*, Size slot);
         set_type observables_;
+        // slot of this observer in each of the observables above
+        std::vector<Size> slots_;
+        // position of each observable, only kept above this size
+        static constexpr Size indexThreshold = 16;
+        std::unique_ptr<std::unordered_map<const Observable*, Size>> index_;
     };
 
 
@@ -160,7 +220,10 @@ namespace QuantLib {
 
     inline void ObservableSettings::registerDeferredObservers(const Observable::set_type& observers) {
         if (updatesDeferred()) {
-            deferredObservers_.insert(observers.begin(), observers.end());
+            for (auto* observer : observers) {
+                if (observer != nullptr)
+                    deferredObservers_.insert(observer);
+            }
         }
     }
 
@@ -168,6 +231,20 @@ namespace QuantLib {
         deferredObservers_.erase(o);
     }
 
+    inline void ObservableSettings::collectNotification(Observable* o) {
+        ++suppressedNotifications_;
+        if (o->batchState_ == Observable::NotBatched)
+            batchedObservables_.push_back(o);
+        // if already delivered during the current flush, the
+        // observable is still listed and just needs to be flagged
+        o->batchState_ = Observable::Batched;
+    }
+
+    inline void ObservableSettings::unregisterBatchedObservable(const Observable* o) {
+        std::replace(batchedObservables_.begin(), batchedObservables_.end(),
+                     const_cast<Observable*>(o), static_cast<Observable*>(nullptr));
+    }
+
     inline Observable::Observable(const Observable&) {
         // the observer set is not copied; no observer asked to
         // register with this object
@@ -189,44 +266,88 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<Observable::iterator, bool>
-    Observable::registerObserver(Observer* o) {
-        return observers_.insert(o);
+    inline Size Observable::registerObserver(Observer* o) {
+        observers_.push_back(o);
+        return observers_.size() - 1;
     }
 
-    inline Size Observable::unregisterObserver(Observer* o) {
+    inline Observable::~Observable() {
+        if (batchState_ != NotBatched)
+            ObservableSettings::instance().unregisterBatchedObservable(this);
+    }
+
+    inline void Observable::unregisterObserver(Observer* o, Size slot) {
         if (ObservableSettings::instance().updatesDeferred())
             ObservableSettings::instance().unregisterDeferredObserver(o);
+        if (ObservableSettings::instance().flushing_ != nullptr)
+            ObservableSettings::instance().unregisterBatchedObserver(o);
 
-        return observers_.erase(o);
+        observers_[slot] = nullptr;
+        ++tombstones_;
+        if (notifying_ == 0 && 2 * tombstones_ >= observers_.size())
+            compact();
     }
 
 
     inline Observer::Observer(const Observer& o)
     : observables_(o.observables_) {
+        slots_.reserve(observables_.size());
         for (const auto& observable : observables_)
-            observable->registerObserver(this);
+            slots_.push_back(observable->registerObserver(this));
+        if (observables_.size() > indexThreshold)
+            buildIndex();
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
-        for (const auto& observable : observables_)
-            observable->unregisterObserver(this);
+        if (&o == this)
+            return *this;
+        unregisterWithAll();
         observables_ = o.observables_;
+        slots_.reserve(observables_.size());
         for (const auto& observable : observables_)
-            observable->registerObserver(this);
+            slots_.push_back(observable->registerObserver(this));
+        if (observables_.size() > indexThreshold)
+            buildIndex();
         return *this;
     }
 
     inline Observer::~Observer() {
-        for (const auto& observable : observables_)
-            observable->unregisterObserver(this);
+        for (Size i=0; i<observables_.size(); ++i)
+            observables_[i]->unregisterObserver(this, slots_[i]);
+    }
+
+    inline Size Observer::position(const Observable* h) const {
+        if (index_ != nullptr) {
+            auto i = index_->find(h);
+            return i != index_->end() ? i->second : observables_.size();
+        }
+        for (Size i=0; i<observables_.size(); ++i) {
+            if (observables_[i].get() == h)
+                return i;
+        }
+        return observables_.size();
+    }
+
+    inline void Observer::buildIndex() {
+        index_.reset(new std::unordered_map<const Observable*, Size>);
+        index_->reserve(observables_.size());
+        for (Size i=0; i<observables_.size(); ++i)
+            index_->emplace(observables_[i].get(), i);
     }
 
     inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const ext::shared_ptr<Observable>& h) {
         if (h != nullptr) {
-            h->registerObserver(this);
-            return observables_.insert(h);
+            Size k = position(h.get());
+            if (k < observables_.size())
+                return std::make_pair(observables_.begin() + k, false);
+            observables_.push_back(h);
+            slots_.push_back(h->registerObserver(this));
+            if (index_ != nullptr)
+                index_->emplace(h.get(), k);
+            else if (observables_.size() > indexThreshold)
+                buildIndex();
+            return std::make_pair(observables_.begin() + k, true);
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -234,22 +355,44 @@ namespace QuantLib {
     inline void
     Observer::registerWithObservables(const ext::shared_ptr<Observer> &o) {
         if (o != nullptr) {
-            for (const auto& observable : o->observables_)
-                registerWith(observable);
+            for (Size i=0; i<o->observables_.size(); ++i)
+                registerWith(o->observables_[i]);
         }
     }
 
     inline
     Size Observer::unregisterWith(const ext::shared_ptr<Observable>& h) {
-        if (h != nullptr)
-            h->unregisterObserver(this);
-        return observables_.erase(h);
+        if (h == nullptr)
+            return 0;
+        Size k = position(h.get());
+        if (k == observables_.size())
+            return 0;
+
+        h->unregisterObserver(this, slots_[k]);
+        if (index_ != nullptr) {
+            index_->erase(h.get());
+            if (k != observables_.size() - 1)
+                (*index_)[observables_.back().get()] = k;
+        }
+        observables_[k] = std::move(observables_.back());
+        observables_.pop_back();
+        slots_[k] = slots_.back();
+        slots_.pop_back();
+        return 1;
     }
 
     inline void Observer::unregisterWithAll() {
-        for (const auto& observable : observables_)
-            observable->unregisterObserver(this);
+        for (Size i=0; i<observables_.size(); ++i)
+            observables_[i]->unregisterObserver(this, slots_[i]);
         observables_.clear();
+        slots_.clear();
+        index_.reset();
+    }
+
+    inline void Observer::relocate(const Observable* h, Size slot) {
+        Size k = position(h);
+        if (k < observables_.size())
+            slots_[k] = slot;
     }
 
     inline void Observer::deepUpdate() {
@@ -267,11 +410,13 @@ namespace QuantLib {
 #include <mutex>
 #include <set>
 #include <thread>
+#include <vector>
 
 namespace QuantLib {
 
     class Observable;
     class ObservableSettings;
+    class NotificationBatch;
 
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
@@ -289,6 +434,11 @@ namespace QuantLib {
         Observer& operator=(const Observer&);
         virtual ~Observer();
         // observer interface
+        /*! An observer is registered at most once with a given
+            observable; further calls return false as the second
+            element of the pair and don't cause additional
+            notifications.
+        */
         std::pair<iterator, bool>
         registerWith(const ext::shared_ptr<Observable>&);
         /*! register with all observables of a given observer. Note
@@ -361,11 +511,21 @@ namespace QuantLib {
     };
 
     namespace detail {
-        class Signal;
+        template <class Proxy> class ObserverShards;
     }
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! In the thread-safe implementation the registered observers
+        are spread over a small number of independently locked
+        shards, which are only allocated when the first observer
+        registers.  Registration and notification from different
+        threads thus contend only when they hit the same shard.
+        Observers are notified outside of any lock; observers
+        destroyed meanwhile are skipped, since their proxy is
+        deactivated but kept alive by the notification snapshot.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
         friend class ObservableSettings;
@@ -378,25 +538,27 @@ namespace QuantLib {
         Observable();
         Observable(const Observable&);
         Observable& operator=(const Observable&);
-        virtual ~Observable() {}
+        virtual ~Observable();
         /*! This method should be called at the end of non-const methods
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
       private:
+        typedef detail::ObserverShards<Observer::Proxy> shards_type;
+        typedef std::vector<ext::shared_ptr<Observer::Proxy>> proxy_list;
+
         void registerObserver(const ext::shared_ptr<Observer::Proxy>&);
-        void unregisterObserver(
-            const ext::shared_ptr<Observer::Proxy>& proxy, bool disconnect);
+        void unregisterObserver(const ext::shared_ptr<Observer::Proxy>&);
+        shards_type* shards();
 
-        ext::shared_ptr<detail::Signal> sig_;
-        set_type observers_;
-        mutable std::recursive_mutex mutex_;
+        std::atomic<shards_type*> shards_;
     };
 
     //! global repository for run-time library settings
     class ObservableSettings : public Singleton<ObservableSettings> {
         friend class Singleton<ObservableSettings>;
         friend class Observable;
+        friend class NotificationBatch;
 
       public:
         void disableUpdates(bool deferred=false) {
@@ -420,7 +582,7 @@ namespace QuantLib {
             set_type;
 #endif
 
-        void registerDeferredObservers(const Observable::set_type& observers);
+        void registerDeferredObservers(const Observable::proxy_list& observers);
         void unregisterDeferredObserver(const ext::shared_ptr<Observer::Proxy>& proxy);
 
         set_type deferredObservers_;
@@ -428,12 +590,31 @@ namespace QuantLib {
 
         enum UpdateType { UpdatesDisabled = 0, UpdatesEnabled = 1, UpdatesDeferred = 2} ;
         std::atomic<int> updatesType_;
+
+        // notification batches, see NotificationBatch; each
+        // thread has its own batch, so its state needs no lock
+        struct BatchState {
+            Size depth = 0;
+            set_type observers;
+            Size suppressedNotifications = 0, updates = 0;
+        };
+        static BatchState& batchState();
+
+        void beginBatch() { ++batchState().depth; }
+        void endBatch();
+        void flushBatch();
+        void flushNotifications();
+        Size suppressedNotifications() const {
+            return batchState().suppressedNotifications;
+        }
+        Size batchedUpdates() const { return batchState().updates; }
     };
 
 
     // inline definitions
 
-    inline void ObservableSettings::registerDeferredObservers(const Observable::set_type& observers) {
+    inline void ObservableSettings::registerDeferredObservers(
+        const Observable::proxy_list& observers) {
         deferredObservers_.insert(observers.begin(), observers.end());
     }
 
@@ -509,7 +690,7 @@ namespace QuantLib {
         }
 
         for (const auto& observable : observables_)
-            observable->unregisterObserver(proxy_, true);
+            observable->unregisterObserver(proxy_);
 
         {
             std::lock_guard<std::recursive_mutex> lock(o.mutex_);
@@ -527,7 +708,7 @@ namespace QuantLib {
             proxy_->deactivate();
 
         for (const auto& observable : observables_)
-            observable->unregisterObserver(proxy_, false);
+            observable->unregisterObserver(proxy_);
     }
 
     inline std::pair<Observer::iterator, bool>
@@ -538,8 +719,11 @@ namespace QuantLib {
         }
 
         if (h) {
-            h->registerObserver(proxy_);
-            return observables_.insert(h);
+            std::pair<iterator, bool> result = observables_.insert(h);
+            // an observer is registered only once with each observable
+            if (result.second)
+                h->registerObserver(proxy_);
+            return result;
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -559,7 +743,7 @@ namespace QuantLib {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
 
         if (h && proxy_)  {
-            h->unregisterObserver(proxy_, true);
+            h->unregisterObserver(proxy_);
         }
 
         return observables_.erase(h);
@@ -569,7 +753,7 @@ namespace QuantLib {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
 
         for (const auto& observable : observables_)
-            observable->unregisterObserver(proxy_, true);
+            observable->unregisterObserver(proxy_);
 
         observables_.clear();
     }
@@ -579,4 +763,55 @@ namespace QuantLib {
     }
 }
 #endif
+
+namespace QuantLib {
+
+    //! Scoped batch of notifications
+    /*! While an instance is alive, calls to
+        Observable::notifyObservers() are collected instead of being
+        forwarded.  When the outermost batch goes out of scope (or
+        when flush() is called on it) the observers reached from the
+        notified observables are updated once each, in topological
+        order: an observer is updated after all the observables it
+        depends upon, and only if at least one of them did notify.
+        Thus, a market-data tick touching many quotes invalidates
+        each dependent lazy object exactly once.
+
+        Batches can be nested; only the outermost one flushes.
+
+        \warning Exceptions thrown by observers during the flush
+                 performed by the destructor are swallowed.  Call
+                 flush() explicitly to have them reported.
+
+        \warning In the thread-safe implementation of the observer
+                 pattern, a batch only collects the notifications sent
+                 from the thread that created it; other threads keep
+                 notifying as usual.  The notifications are still
+                 merged, but no ordering is guaranteed.
+
+        \ingroup patterns
+    */
+    class NotificationBatch { // NOLINT(cppcoreguidelines-special-member-functions)
+      public:
+        NotificationBatch();
+        ~NotificationBatch();
+        NotificationBatch(const NotificationBatch&) = delete;
+        NotificationBatch& operator=(const NotificationBatch&) = delete;
+
+        //! sends the collected notifications if this is the outermost batch
+        void flush();
+
+        //! \name Instrumentation
+        //@{
+        //! calls to notifyObservers() collected since the batch was created
+        Size suppressedNotifications() const;
+        //! observer updates sent by flushes since the batch was created
+        Size updates() const;
+        //@}
+      private:
+        Size suppressedNotifications_, updates_;
+    };
+
+}
+
 #endif
@@ -27,9 +27,12 @@
 #define quantlib_pricing_engine_hpp
 
 #include <ql/patterns/observable.hpp>
+#include <vector>
 
 namespace QuantLib {
 
+    class Instrument;
+
     //! interface for pricing engines
     class PricingEngine : public Observable {
       public:
@@ -40,6 +43,17 @@ namespace QuantLib {
         virtual const results* getResults() const = 0;
         virtual void reset() = 0;
         virtual void calculate() const = 0;
+        /*! Sets up the arguments, performs the calculation and
+            fetches the results for each of the passed instruments,
+            which must all be using this engine.  The default
+            implementation processes them one at a time; engines
+            can override this method in order to price the whole
+            batch in one pass.
+
+            This method is called by calculateInstruments(), which
+            takes care of the instruments' lazy-object state.
+        */
+        virtual void calculateBatch(const std::vector<const Instrument*>& instruments) const;
     };
 
     class PricingEngine::arguments {
@@ -73,7 +73,8 @@ namespace QuantLib {
                                            Size maxSamples,
                                            BigNatural seed,
                                            Size timeSteps = Null<Size>(),
-                                           Size timeStepsPerYear = Null<Size>());
+                                           Size timeStepsPerYear = Null<Size>(),
+                                           Size threads = 1);
         void calculate() const override {
             try {
                 McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
@@ -107,11 +108,15 @@ namespace QuantLib {
         // McSimulation implementation
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override {
+            return streamPathGenerator(0);
+        }
+        ext::shared_ptr<path_generator_type>
+        streamPathGenerator(Size stream) const override {
 
             Size dimensions = process_->factors();
             TimeGrid grid = this->timeGrid();
             typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+                this->sequenceGenerator(dimensions*(grid.size()-1), seed_, stream);
             return ext::shared_ptr<path_generator_type>(
                          new path_generator_type(process_, grid,
                                                  gen, brownianBridge_));
@@ -139,8 +144,10 @@ namespace QuantLib {
         Size maxSamples,
         BigNatural seed,
         Size timeSteps,
-        Size timeStepsPerYear)
-    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
+        Size timeStepsPerYear,
+        Size threads)
+    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate, threads),
+      process_(std::move(process)),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear), requiredTolerance_(requiredTolerance),
       brownianBridge_(brownianBridge), seed_(seed) {
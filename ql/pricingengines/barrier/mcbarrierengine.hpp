@@ -74,7 +74,8 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size threads = 1);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot > 0.0, "negative or null underlying given");
@@ -92,14 +93,22 @@ namespace QuantLib {
         // McSimulation implementation
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override {
+            return streamPathGenerator(0);
+        }
+        ext::shared_ptr<path_generator_type>
+        streamPathGenerator(Size stream) const override {
             TimeGrid grid = timeGrid();
             typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(grid.size()-1,seed_);
+                this->sequenceGenerator(grid.size()-1, seed_, stream);
             return ext::shared_ptr<path_generator_type>(
                          new path_generator_type(process_,
                                                  grid, gen, brownianBridge_));
         }
-        ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<path_pricer_type> pathPricer() const override {
+            return streamPathPricer(0);
+        }
+        ext::shared_ptr<path_pricer_type>
+        streamPathPricer(Size stream) const override;
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -126,6 +135,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +144,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
+        Size threads_ = 1;
     };
 
 
@@ -193,8 +204,10 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
-    : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
+        BigNatural seed,
+        Size threads)
+    : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false, threads),
+      process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
       brownianBridge_(brownianBridge), seed_(seed) {
@@ -231,7 +244,7 @@ namespace QuantLib {
     template <class RNG, class S>
     inline
     ext::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
-    MCBarrierEngine<RNG,S>::pathPricer() const {
+    MCBarrierEngine<RNG,S>::streamPathPricer(Size stream) const {
         ext::shared_ptr<PlainVanillaPayoff> payoff =
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-plain payoff given");
@@ -253,8 +266,9 @@ namespace QuantLib {
                        payoff->strike(),
                        discounts));
         } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+            PseudoRandom::ursg_type sequenceGen(
+                grid.size()-1,
+                PseudoRandom::urng_type(PseudoRandom::stream_seed(5, stream)));
             return ext::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
@@ -346,6 +360,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -363,7 +384,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   threads_));
     }
 
 }
@@ -31,10 +31,14 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/vectorization.hpp>
 #include <boost/math/distributions/normal.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/math/special_functions/atanh.hpp>
 #include <boost/math/special_functions/sign.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace {
     void checkParameters(QuantLib::Real strike,
@@ -702,6 +706,452 @@ namespace QuantLib {
                                      stdDev, discount, displacement);
     }
 
+    namespace {
+
+        /* Branch-free exp, log and normal distribution for the strip
+           loops.  The library functions are external calls that set
+           errno, and compilers can't vectorize loops calling them
+           unless fast-math options are used; these are inlined, only
+           use arithmetic, selections and bit operations, and are
+           accurate within a few ulps in the ranges used below. */
+
+        inline std::uint64_t bitsOf(double x) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return bits;
+        }
+
+        inline double fromBits(std::uint64_t bits) {
+            double x;
+            std::memcpy(&x, &bits, sizeof(x));
+            return x;
+        }
+
+        /* the higher 32 bits, sign included, which fdlibm uses to
+           compare magnitudes.  The compiler may move floating-point
+           comparisons into branches and, since they might trap, not
+           turn them back into selections; integer ones don't have the
+           problem, and 32-bit ones exist in any SIMD instruction set. */
+        inline std::int32_t highWord(double x) {
+            return static_cast<std::int32_t>(bitsOf(x) >> 32);
+        }
+
+        // log(2) split so that k*ln2Hi is exact for |k| < 2^20
+        const double ln2Hi = 6.93147180369123816490e-01;
+        const double ln2Lo = 1.90821492927058770002e-10;
+
+        /* exp(x + y), with x clamped to [-700, 700] and y small; the
+           latter is added after the reduction, so that it's not lost
+           in the rounding of the sum when x is large */
+        QL_SIMD_INLINE double stripExp(double x, double y = 0.0) {
+            const bool large = highWord(std::fabs(x)) >= 0x4085E000;  // 700
+            x = large ? std::copysign(700.0, x) : x;
+            // x + y = k*log(2) + r with |r| <= log(2)/2; adding 1.5*2^52
+            // rounds (x+y)/log(2) to the integer k in the low bits
+            const double shift = 6755399441055744.0;
+            const double shifted = (x + y)*M_LOG2E + shift;
+            const double k = shifted - shift;
+            const double r = ((x - k*ln2Hi) + y) - k*ln2Lo;
+            // Taylor expansion of exp(r) up to r^13/13!
+            double p = 1.0/6227020800.0;
+            p = 1.0/479001600.0 + r*p;
+            p = 1.0/39916800.0 + r*p;
+            p = 1.0/3628800.0 + r*p;
+            p = 1.0/362880.0 + r*p;
+            p = 1.0/40320.0 + r*p;
+            p = 1.0/5040.0 + r*p;
+            p = 1.0/720.0 + r*p;
+            p = 1.0/120.0 + r*p;
+            p = 1.0/24.0 + r*p;
+            p = 1.0/6.0 + r*p;
+            p = 0.5 + r*p;
+            p = 1.0 + r*p;
+            p = 1.0 + r*p;
+            // multiplication by 2^k, adding k to the exponent
+            return fromBits(bitsOf(p) + ((bitsOf(shifted) - bitsOf(shift)) << 52));
+        }
+
+        // log(x) for positive normal x
+        QL_SIMD_INLINE double stripLog(double x) {
+            const std::uint64_t bits = bitsOf(x);
+            // x = 2^e m with m in [1, 2), the biased exponent being
+            // converted by placing it in the mantissa of 2^52
+            // m is moved to about [sqrt(1/2), sqrt(2)) to avoid
+            // cancellation
+            const std::uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFULL;
+            const std::uint64_t above =
+                (highWord(x) & 0x000FFFFF) >= 0x0006A09F ? 1 : 0;
+            const double m = fromBits(mantissa | (0x3FF0000000000000ULL - (above << 52)));
+            const double e = fromBits(((bits >> 52) + above) | 0x4330000000000000ULL)
+                - (4503599627370496.0 + 1023.0);
+            // log(m) = 2 atanh(s) with s = (m-1)/(m+1), |s| < 0.172
+            const double s = (m - 1.0)/(m + 1.0);
+            const double z = s*s;
+            double p = 1.0/23.0;
+            p = 1.0/21.0 + z*p;
+            p = 1.0/19.0 + z*p;
+            p = 1.0/17.0 + z*p;
+            p = 1.0/15.0 + z*p;
+            p = 1.0/13.0 + z*p;
+            p = 1.0/11.0 + z*p;
+            p = 1.0/9.0 + z*p;
+            p = 1.0/7.0 + z*p;
+            p = 1.0/5.0 + z*p;
+            p = 1.0/3.0 + z*p;
+            const double logM = 2.0*s + 2.0*s*(z*p);
+            return e*ln2Hi + (logM + e*ln2Lo);
+        }
+
+        /* Coefficients of the rational approximations of erfc on
+           [0, 0.84375), [0.84375, 1.25), [1.25, 1/0.35) and [1/0.35,
+           28), the same used by ErrorFunction (from fdlibm); missing
+           ones are zero. */
+        const double erx = 8.45062911510467529297e-01;
+        const double erfcP[4][8] = {
+            { 1.28379167095512558561e-01, -3.25042107247001499370e-01,
+             -2.84817495755985104766e-02, -5.77027029648944159157e-03,
+             -2.37630166566501626084e-05, 0.0, 0.0, 0.0 },
+            {-2.36211856075265944077e-03,  4.14856118683748331666e-01,
+             -3.72207876035701323847e-01,  3.18346619901161753674e-01,
+             -1.10894694282396677476e-01,  3.54783043256182359371e-02,
+             -2.16637559486879084300e-03, 0.0 },
+            {-9.86494403484714822705e-03, -6.93858572707181764372e-01,
+             -1.05586262253232909814e+01, -6.23753324503260060396e+01,
+             -1.62396669462573470355e+02, -1.84605092906711035994e+02,
+             -8.12874355063065934246e+01, -9.81432934416914548592e+00 },
+            {-9.86494292470009928597e-03, -7.99283237680523006574e-01,
+             -1.77579549177547519889e+01, -1.60636384855821916062e+02,
+             -6.37566443368389627722e+02, -1.02509513161107724954e+03,
+             -4.83519191608651397019e+02, 0.0 }
+        };
+        const double erfcQ[4][8] = {
+            { 3.97917223959155352819e-01,  6.50222499887672944485e-02,
+              5.08130628187576562776e-03,  1.32494738004321644526e-04,
+             -3.96022827877536812320e-06, 0.0, 0.0, 0.0 },
+            { 1.06420880400844228286e-01,  5.40397917702171048937e-01,
+              7.18286544141962662868e-02,  1.26171219808761642112e-01,
+              1.36370839120290507362e-02,  1.19844998467991074170e-02,
+              0.0, 0.0 },
+            { 1.96512716674392571292e+01,  1.37657754143519042600e+02,
+              4.34565877475229228821e+02,  6.45387271733267880336e+02,
+              4.29008140027567833386e+02,  1.08635005541779435134e+02,
+              6.57024977031928170135e+00, -6.04244152148580987438e-02 },
+            { 3.03380607434824582924e+01,  3.25792512996573918826e+02,
+              1.53672958608443695994e+03,  3.19985821950859553908e+03,
+              2.55305040643316442583e+03,  4.74528541206955367215e+02,
+             -2.24409524465858183362e+01, 0.0 }
+        };
+
+        /* the j-th coefficient of the interval containing the
+           argument, as a sum weighted by 0 or 1; choosing among the
+           rows would become a gather, and choosing among values a
+           branch */
+        inline double erfcCoefficient(const double (&c)[4][8], Size j,
+                                      double w0, double w1, double w2, double w3) {
+            return w0*c[0][j] + w1*c[1][j] + w2*c[2][j] + w3*c[3][j];
+        }
+
+        // normal cumulative distribution, as erfc(-x/sqrt(2))/2
+        QL_SIMD_INLINE double stripCumNormal(double x) {
+            const double z = std::fabs(x) * M_SQRT1_2;
+            const std::int32_t high = highWord(z);
+            const bool first = high < 0x3FEB0000,   // 0.84375
+                second = high < 0x3FF40000,         // 1.25
+                third = high < 0x4006DB6D;          // 1/0.35
+            const double w0 = first ? 1.0 : 0.0,
+                w1 = (!first & second) ? 1.0 : 0.0,
+                w2 = (!second & third) ? 1.0 : 0.0,
+                w3 = third ? 0.0 : 1.0;
+            // all intervals use the ratio of two polynomials in t; the
+            // alternatives are blended with the same weights, and kept
+            // finite where their weight is zero
+            const double z2 = z*z, inverse = 1.0/(z + w0);
+            const double t = w0*z2 + w1*(z - 1.0) + (w2 + w3)*(inverse*inverse);
+            double p = erfcCoefficient(erfcP, 7, w0, w1, w2, w3);
+            double q = erfcCoefficient(erfcQ, 7, w0, w1, w2, w3);
+            p = erfcCoefficient(erfcP, 6, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 6, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 5, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 5, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 4, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 4, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 3, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 3, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 2, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 2, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 1, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 1, w0, w1, w2, w3) + t*q;
+            p = erfcCoefficient(erfcP, 0, w0, w1, w2, w3) + t*p;
+            q = erfcCoefficient(erfcQ, 0, w0, w1, w2, w3) + t*q;
+            q = 1.0 + t*q;
+            const double r = p/q;
+            // the tail intervals approximate log(z erfc(z)) + z^2 + 0.5625;
+            // as in fdlibm, z is split so that the square of its higher
+            // part, with the lower 32 bits cleared, is exact
+            const double zHigh = fromBits(bitsOf(z) & 0xFFFFFFFF00000000ULL);
+            const double erfc = w0*(1.0 - (z + z*r))
+                + w1*((1.0 - erx) - r)
+                + (w2 + w3)*stripExp(-zHigh*zHigh - 0.5625,
+                                     (zHigh - z)*(zHigh + z) + r)*inverse;
+            // erfc/2 for negative x, 1 - erfc/2 otherwise
+            const bool negative = highWord(x) < 0;
+            return (negative ? 0.0 : 1.0) + (negative ? 0.5 : -0.5)*erfc;
+        }
+
+        QL_SIMD_INLINE double stripNormalDensity(double x) {
+            return M_SQRT1_2 * M_1_SQRTPI * stripExp(-0.5 * x * x);
+        }
+
+        void checkStrip(const std::vector<Real>& strikes,
+                        Real forward,
+                        const std::vector<Real>& stdDevs,
+                        Real discount,
+                        Real displacement) {
+            QL_REQUIRE(strikes.size() == stdDevs.size(),
+                       "mismatch between number of strikes (" << strikes.size()
+                       << ") and of standard deviations (" << stdDevs.size() << ")");
+            QL_REQUIRE(discount>0.0,
+                       "discount (" << discount << ") must be positive");
+            for (Size i=0; i<strikes.size(); ++i) {
+                checkParameters(strikes[i], forward, displacement);
+                QL_REQUIRE(stdDevs[i]>=0.0,
+                           "stdDev (" << stdDevs[i] << ") must be non-negative");
+            }
+        }
+
+    }
+
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   Real forward,
+                                   const std::vector<Real>& stdDevs,
+                                   Real discount,
+                                   Real displacement) {
+        checkStrip(strikes, forward, stdDevs, discount, displacement);
+
+        const Size n = strikes.size();
+        const Real sign = Integer(optionType);
+        const Real f = forward + displacement;
+        const Real* k = strikes.data();
+        const Real* s = stdDevs.data();
+        std::vector<Real> result(n);
+        Real* r = result.data();
+
+        QL_SIMD_LOOP
+        for (Size i=0; i<n; ++i) {
+            const Real kd = k[i] + displacement;
+            const Real d1 = stripLog(f/kd)/s[i] + 0.5*s[i];
+            const Real d2 = d1 - s[i];
+            r[i] = discount * sign *
+                (f*stripCumNormal(sign*d1) - kd*stripCumNormal(sign*d2));
+        }
+
+        // degenerate entries, and any that came out negative, are
+        // left to the scalar formula
+        for (Size i=0; i<n; ++i) {
+            if (s[i] == 0.0 || k[i] + displacement == 0.0 || !(r[i] >= 0.0))
+                r[i] = blackFormula(optionType, k[i], forward, s[i],
+                                    discount, displacement);
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaForwardDerivative(Option::Type optionType,
+                                                    const std::vector<Real>& strikes,
+                                                    Real forward,
+                                                    const std::vector<Real>& stdDevs,
+                                                    Real discount,
+                                                    Real displacement) {
+        checkStrip(strikes, forward, stdDevs, discount, displacement);
+
+        const Size n = strikes.size();
+        const Real sign = Integer(optionType);
+        const Real f = forward + displacement;
+        const Real* k = strikes.data();
+        const Real* s = stdDevs.data();
+        std::vector<Real> result(n);
+        Real* r = result.data();
+
+        QL_SIMD_LOOP
+        for (Size i=0; i<n; ++i) {
+            const Real d1 = stripLog(f/(k[i]+displacement))/s[i] + 0.5*s[i];
+            r[i] = sign * stripCumNormal(sign*d1) * discount;
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (s[i] == 0.0 || k[i] + displacement == 0.0)
+                r[i] = blackFormulaForwardDerivative(optionType, k[i], forward,
+                                                     s[i], discount, displacement);
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                                   Real forward,
+                                                   const std::vector<Real>& stdDevs,
+                                                   Real discount,
+                                                   Real displacement) {
+        checkStrip(strikes, forward, stdDevs, discount, displacement);
+
+        const Size n = strikes.size();
+        const Real f = forward + displacement;
+        const Real* k = strikes.data();
+        const Real* s = stdDevs.data();
+        std::vector<Real> result(n);
+        Real* r = result.data();
+
+        QL_SIMD_LOOP
+        for (Size i=0; i<n; ++i) {
+            const Real d1 = stripLog(f/(k[i]+displacement))/s[i] + 0.5*s[i];
+            r[i] = discount * f * stripNormalDensity(d1);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (s[i] == 0.0 || k[i] + displacement == 0.0)
+                r[i] = 0.0;
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaImpliedStdDev(Option::Type optionType,
+                                                const std::vector<Real>& strikes,
+                                                Real forward,
+                                                const std::vector<Real>& blackPrices,
+                                                Real discount,
+                                                Real displacement,
+                                                Real accuracy,
+                                                Natural maxIterations) {
+        QL_REQUIRE(strikes.size() == blackPrices.size(),
+                   "mismatch between number of strikes (" << strikes.size()
+                   << ") and of prices (" << blackPrices.size() << ")");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        const Real f = forward + displacement;
+        const Real minStdDev = 0.0, maxStdDev = 24.0; // as in the scalar version
+
+        // each entry is solved on its out-of-the-money option, as in
+        // the scalar version; the ones solved by the bulk iteration
+        // are stored contiguously, the others are left to the scalar
+        // solver.
+        std::vector<Real> result(n, Null<Real>());
+        std::vector<Size> index;
+        std::vector<Real> kd, moneyness, omega, target, stdDevs, lower, upper;
+        // moving is a Real, as the other data in the iteration, so
+        // that the loop can be vectorized with a single lane width
+        std::vector<Real> moving;
+        index.reserve(n);
+
+        for (Size i=0; i<n; ++i) {
+            const Real strike = strikes[i];
+            const Real blackPrice = blackPrices[i];
+            checkParameters(strike, forward, displacement);
+            QL_REQUIRE(blackPrice>=0.0,
+                       "option price (" << blackPrice << ") must be non-negative");
+            Real otherOptionPrice =
+                blackPrice - Integer(optionType) * (forward-strike)*discount;
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       optionType << " strike " << strike <<
+                       ", forward " << forward <<
+                       ", price " << blackPrice <<
+                       ", deflator " << discount);
+
+            Option::Type type = optionType;
+            Real price = blackPrice;
+            if ((optionType==Option::Put && strike>forward) ||
+                (optionType==Option::Call && strike<forward)) {
+                type = Option::Type(-1*optionType);
+                price = otherOptionPrice;
+            }
+
+            Real guess = Null<Real>();
+            if (strike + displacement != 0.0 && price > 0.0)
+                guess = blackFormulaImpliedStdDevApproximation(
+                    type, strike, forward, price, discount, displacement);
+            if (guess == Null<Real>() || guess <= minStdDev || guess >= maxStdDev)
+                continue;
+
+            index.push_back(i);
+            kd.push_back(strike + displacement);
+            moneyness.push_back(std::log(f/kd.back()));
+            omega.push_back(Integer(type));
+            target.push_back(price/discount);
+            stdDevs.push_back(guess);
+            lower.push_back(minStdDev);
+            upper.push_back(maxStdDev);
+        }
+        moving.resize(index.size());
+
+        Real* k = kd.data();
+        Real* m = moneyness.data();
+        Real* w = omega.data();
+        Real* t = target.data();
+        Real* x = stdDevs.data();
+        Real* lo = lower.data();
+        Real* hi = upper.data();
+        Real* p = moving.data();
+
+        // safeguarded Newton iteration, as in NewtonSafe: the bracket
+        // is narrowed at each step and a bisection replaces any Newton
+        // step falling outside it.
+        Size live = index.size();
+        for (Natural iteration=0; live>0 && iteration<maxIterations; ++iteration) {
+            QL_SIMD_LOOP
+            for (Size i=0; i<live; ++i) {
+                const Real sd = x[i];
+                const Real d1 = m[i]/sd + 0.5*sd;
+                const Real d2 = d1 - sd;
+                const Real value =
+                    w[i]*(f*stripCumNormal(w[i]*d1) - k[i]*stripCumNormal(w[i]*d2)) - t[i];
+                const Real vega = f*stripNormalDensity(d1);
+                const bool above = value > 0.0;
+                const Real l = above ? lo[i] : sd;
+                const Real h = above ? sd : hi[i];
+                // the midpoint is used in the test, so that the
+                // compiler doesn't move its calculation into a branch
+                const Real newton = sd - value/vega, middle = 0.5*(l+h);
+                const bool inside = std::fabs(newton - middle) < 0.5*(h-l);
+                const Real next = inside ? newton : middle;
+                lo[i] = l;
+                hi[i] = h;
+                x[i] = next;
+                p[i] = std::fabs(next-sd) >= accuracy ? 1.0 : 0.0;
+            }
+
+            // converged entries are stored, and the others moved to the
+            // front so that the next step only works on them
+            Size stillMoving = 0;
+            for (Size i=0; i<live; ++i) {
+                if (p[i] == 0.0) {
+                    result[index[i]] = x[i];
+                } else {
+                    index[stillMoving] = index[i];
+                    k[stillMoving] = k[i];
+                    m[stillMoving] = m[i];
+                    w[stillMoving] = w[i];
+                    t[stillMoving] = t[i];
+                    x[stillMoving] = x[i];
+                    lo[stillMoving] = lo[i];
+                    hi[stillMoving] = hi[i];
+                    ++stillMoving;
+                }
+            }
+            live = stillMoving;
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (result[i] == Null<Real>())
+                result[i] = blackFormulaImpliedStdDev(optionType, strikes[i], forward,
+                                                      blackPrices[i], discount, displacement,
+                                                      Null<Real>(), accuracy, maxIterations);
+        }
+        return result;
+    }
+
     Real bachelierBlackFormula(Option::Type optionType,
                                Real strike,
                                Real forward,
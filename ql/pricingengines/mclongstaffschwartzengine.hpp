@@ -68,7 +68,11 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+
+          If more than one thread is given, the pricing phase draws
+          the paths from as many independent streams, which share the
+          exercise strategy calibrated on the calibration paths. */
         MCLongstaffSchwartzEngine(ext::shared_ptr<StochasticProcess> process,
                                   Size timeSteps,
                                   Size timeStepsPerYear,
@@ -82,7 +86,8 @@ namespace QuantLib {
                                   Size nCalibrationSamples = Null<Size>(),
                                   ext::optional<bool> brownianBridgeCalibration = ext::nullopt,
                                   ext::optional<bool> antitheticVariateCalibration = ext::nullopt,
-                                  BigNatural seedCalibration = Null<Size>());
+                                  BigNatural seedCalibration = Null<Size>(),
+                                  Size threads = 1);
 
         void calculate() const override;
 
@@ -93,6 +98,10 @@ namespace QuantLib {
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override;
+        ext::shared_ptr<path_generator_type>
+        streamPathGenerator(Size stream) const override;
+        ext::shared_ptr<path_pricer_type>
+        streamPathPricer(Size stream) const override;
 
         ext::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -111,6 +120,8 @@ namespace QuantLib {
             pathPricer_;
         mutable ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >
             mcModelCalibration_;
+        mutable std::vector<ext::shared_ptr<
+            LongstaffSchwartzStreamPathPricer<path_type> > > streamPricers_;
     };
 
     template <class GenericEngine,
@@ -133,8 +144,10 @@ namespace QuantLib {
                                   Size nCalibrationSamples,
                                   ext::optional<bool> brownianBridgeCalibration,
                                   ext::optional<bool> antitheticVariateCalibration,
-                                  BigNatural seedCalibration)
-    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
+                                  BigNatural seedCalibration,
+                                  Size threads)
+    : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate, threads),
+      process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), brownianBridge_(brownianBridge),
       requiredSamples_(requiredSamples), requiredTolerance_(requiredTolerance),
       maxSamples_(maxSamples), seed_(seed),
@@ -197,12 +210,27 @@ namespace QuantLib {
         mcModelCalibration_->addSamples(nCalibrationSamples_);
         pathPricer_->calibrate();
         // pricing
+        streamPricers_.clear();
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
                                           maxSamples_);
         this->results_.value = this->mcModel_->sampleAccumulator().mean();
-        this->results_.additionalResults["exerciseProbability"] =
-            this->pathPricer_->exerciseProbability();
+        if (this->threads_ > 1) {
+            Real exercised = 0.0, samples = 0.0;
+            for (const auto& pricer : streamPricers_) {
+                const IncrementalStatistics& stats =
+                    pricer->exerciseStatistics();
+                if (stats.weightSum() > 0.0) {
+                    exercised += stats.mean()*stats.weightSum();
+                    samples += stats.weightSum();
+                }
+            }
+            this->results_.additionalResults["exerciseProbability"] =
+                samples > 0.0 ? exercised/samples : 0.0;
+        } else {
+            this->results_.additionalResults["exerciseProbability"] =
+                this->pathPricer_->exerciseProbability();
+        }
         if constexpr (RNG::allowsErrorEstimate) {
             this->results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
@@ -245,16 +273,41 @@ namespace QuantLib {
         GenericEngine, MC, RNG, S, RNG_Calibration>::path_generator_type>
     MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S,
                               RNG_Calibration>::pathGenerator() const {
+        return streamPathGenerator(0);
+    }
+
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline ext::shared_ptr<typename MCLongstaffSchwartzEngine<
+        GenericEngine, MC, RNG, S, RNG_Calibration>::path_generator_type>
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+        streamPathGenerator(Size stream) const {
 
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
         typename RNG::rsg_type generator =
-            RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+            this->sequenceGenerator(dimensions*(grid.size()-1), seed_, stream);
         return ext::shared_ptr<path_generator_type>(
                    new path_generator_type(process_,
                                            grid, generator, brownianBridge_));
     }
 
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline ext::shared_ptr<typename MCLongstaffSchwartzEngine<
+        GenericEngine, MC, RNG, S, RNG_Calibration>::path_pricer_type>
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S, RNG_Calibration>::
+        streamPathPricer(Size stream) const {
+
+        QL_REQUIRE(pathPricer_, "path pricer unknown");
+        if (streamPricers_.size() <= stream)
+            streamPricers_.resize(stream+1);
+        streamPricers_[stream] =
+            ext::make_shared<LongstaffSchwartzStreamPathPricer<path_type> >(
+                pathPricer_);
+        return streamPricers_[stream];
+    }
+
 }
 
 
@@ -28,15 +28,39 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <type_traits>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // whether the RNG traits provide the stream factory
+        // make_sequence_generator(dimension, seed, stream, streams)
+        template <class RNG, class = void>
+        struct has_stream_factory : std::false_type {};
+
+        template <class RNG>
+        struct has_stream_factory<RNG, std::void_t<decltype(
+            RNG::make_sequence_generator(Size(), BigNatural(),
+                                         Size(), Size()))> >
+        : std::true_type {};
+
+    }
+
     //! base class for Monte Carlo engines
     /*! Eventually this class might offer greeks methods.  Deriving a
         class from McSimulation gives an easy way to write a Monte
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        If more than one thread is requested, the samples are drawn
+        from as many independent streams, each with its own path
+        generator and path pricer; see MonteCarloModel for details.
+        Engines supporting this mode must override the
+        streamPathGenerator() method and, if needed, the
+        streamPathPricer() one.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,12 +91,58 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size threads = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(threads) {
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+        }
         virtual ext::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual ext::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
+        /*! path generator for the i-th of the independent streams
+            used in multi-threaded simulations.  Stream 0 must
+            return the same sequence of paths as pathGenerator(),
+            while each other stream must draw from its own random
+            sequence; see the stream factories in rngtraits.hpp.
+            The default implementation only provides stream 0.
+        */
+        virtual ext::shared_ptr<path_generator_type>
+        streamPathGenerator(Size stream) const {
+            QL_REQUIRE(stream == 0,
+                       "engine does not support multi-threaded simulation");
+            return pathGenerator();
+        }
+        /*! path pricer for the i-th of the independent streams used
+            in multi-threaded simulations.  The default implementation
+            returns a new instance from pathPricer(); engines whose
+            path pricers draw random numbers should override it so
+            that each stream uses its own sequence.
+        */
+        virtual ext::shared_ptr<path_pricer_type>
+        streamPathPricer(Size /*stream*/) const {
+            return pathPricer();
+        }
+        /*! sequence generator for the i-th of the streams used by
+            this simulation.  With a single thread, the plain
+            RNG::make_sequence_generator(dimension, seed) factory is
+            called, so that RNG traits without stream factories can
+            still be used in single-threaded simulations.
+        */
+        typename RNG::rsg_type sequenceGenerator(Size dimension,
+                                                 BigNatural seed,
+                                                 Size stream) const {
+            if constexpr (detail::has_stream_factory<RNG>::value) {
+                if (threads_ > 1)
+                    return RNG::make_sequence_generator(dimension, seed,
+                                                        stream, threads_);
+            } else {
+                QL_REQUIRE(threads_ == 1,
+                           "RNG traits don't provide independent streams "
+                           "for multi-threaded simulation");
+            }
+            return RNG::make_sequence_generator(dimension, seed);
+        }
         virtual TimeGrid timeGrid() const = 0;
         virtual ext::shared_ptr<path_pricer_type> controlPathPricer() const {
             return ext::shared_ptr<path_pricer_type>();
@@ -97,6 +167,7 @@ namespace QuantLib {
         
         mutable ext::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
     };
 
 
@@ -165,7 +236,54 @@ namespace QuantLib {
                    "neither tolerance nor number of samples set");
 
         //! Initialize the one-factor Monte Carlo
-        if (this->controlVariate_) {
+        if (threads_ > 1) {
+
+            std::vector<ext::shared_ptr<path_generator_type> >
+                generators(threads_);
+            std::vector<ext::shared_ptr<path_pricer_type> >
+                pricers(threads_), controlPricers;
+            for (Size i=0; i<threads_; ++i) {
+                generators[i] = this->streamPathGenerator(i);
+                pricers[i] = this->streamPathPricer(i);
+            }
+
+            result_type controlVariateValue = result_type();
+            if (this->controlVariate_) {
+                controlVariateValue = this->controlVariateValue();
+                QL_REQUIRE(controlVariateValue != Null<result_type>(),
+                           "engine does not provide "
+                           "control-variation price");
+                QL_REQUIRE(!this->controlPathGenerator(),
+                           "separate control-variation path generator "
+                           "not supported in multi-threaded simulation");
+                controlPricers.resize(threads_);
+                for (Size i=0; i<threads_; ++i) {
+                    controlPricers[i] = this->controlPathPricer();
+                    QL_REQUIRE(controlPricers[i],
+                               "engine does not provide "
+                               "control-variation path pricer");
+                }
+            }
+
+            // Lazy objects and caches in the underlying process are
+            // not thread safe; pricing a path from a separate
+            // generator triggers their calculation here, so that the
+            // streams only read them afterwards.
+            ext::shared_ptr<path_generator_type> warmUp =
+                this->pathGenerator();
+            const typename path_generator_type::sample_type& path =
+                warmUp->next();
+            (*this->pathPricer())(path.value);
+            if (this->controlVariate_)
+                (*this->controlPathPricer())(path.value);
+
+            this->mcModel_ =
+                ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                    new MonteCarloModel<MC,RNG,S>(
+                           generators, pricers, stats_type(),
+                           this->antitheticVariate_, controlPricers,
+                           controlVariateValue));
+        } else if (this->controlVariate_) {
 
             result_type controlVariateValue = this->controlVariateValue();
             QL_REQUIRE(controlVariateValue != Null<result_type>(),
@@ -19,8 +19,11 @@
 */
 
 #include <ql/exercise.hpp>
+#include <ql/math/comparison.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <map>
 #include <utility>
 
 namespace QuantLib {
@@ -39,14 +42,38 @@ namespace QuantLib {
         registerWith(discountCurve_);
     }
 
-    void AnalyticEuropeanEngine::calculate() const {
-
+    ext::shared_ptr<YieldTermStructure> AnalyticEuropeanEngine::discountCurve() const {
         // if the discount curve is not specified, we default to the
         // risk free rate curve embedded within the GBM process
-        ext::shared_ptr<YieldTermStructure> discountPtr = 
-            discountCurve_.empty() ? 
+        return discountCurve_.empty() ?
             process_->riskFreeRate().currentLink() :
             discountCurve_.currentLink();
+    }
+
+    AnalyticEuropeanEngine::ExpiryData
+    AnalyticEuropeanEngine::expiryData(const Date& exerciseDate,
+                                       const YieldTermStructure& discountTS) const {
+        ExpiryData data;
+        data.dividendDiscount = process_->dividendYield()->discount(exerciseDate);
+        data.discount = discountTS.discount(exerciseDate);
+        data.riskFreeDiscount = process_->riskFreeRate()->discount(exerciseDate);
+
+        DayCounter rfdc  = discountTS.dayCounter();
+        DayCounter divdc = process_->dividendYield()->dayCounter();
+        DayCounter voldc = process_->blackVolatility()->dayCounter();
+        data.riskFreeTime =
+            rfdc.yearFraction(process_->riskFreeRate()->referenceDate(), exerciseDate);
+        data.dividendTime =
+            divdc.yearFraction(process_->dividendYield()->referenceDate(), exerciseDate);
+        data.volatilityTime =
+            voldc.yearFraction(process_->blackVolatility()->referenceDate(), exerciseDate);
+        data.timeToExpiry = process_->blackVolatility()->timeFromReference(exerciseDate);
+        return data;
+    }
+
+    void AnalyticEuropeanEngine::calculate() const {
+
+        ext::shared_ptr<YieldTermStructure> discountPtr = discountCurve();
 
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
                    "not an European option");
@@ -55,22 +82,131 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-striked payoff given");
 
-        Real variance =
-            process_->blackVolatility()->blackVariance(
-                                              arguments_.exercise->lastDate(),
-                                              payoff->strike());
-        DiscountFactor dividendDiscount =
-            process_->dividendYield()->discount(
-                                             arguments_.exercise->lastDate());
-        DiscountFactor df = discountPtr->discount(arguments_.exercise->lastDate());
-        DiscountFactor riskFreeDiscountForFwdEstimation =
-            process_->riskFreeRate()->discount(arguments_.exercise->lastDate());
+        const Date& exerciseDate = arguments_.exercise->lastDate();
+        ExpiryData data = expiryData(exerciseDate, *discountPtr);
         Real spot = process_->stateVariable()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
-        Real forwardPrice = spot * dividendDiscount / riskFreeDiscountForFwdEstimation;
 
-        BlackCalculator black(payoff, forwardPrice, std::sqrt(variance),df);
+        calculate(payoff, exerciseDate, spot, data);
+    }
+
+    void AnalyticEuropeanEngine::calculateBatch(
+                              const std::vector<const Instrument*>& instruments) const {
+        ext::shared_ptr<YieldTermStructure> discountPtr = discountCurve();
+        Real spot = process_->stateVariable()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        // options in a portfolio usually share a few exercise dates
+        std::map<Date, ExpiryData> expiries;
+
+        // plain-vanilla options sharing exercise date and type are
+        // priced together by the strip versions of the Black formula
+        struct Strip {
+            Option::Type type;
+            const ExpiryData* data;
+            Real forward;
+            std::vector<Real> strikes, stdDevs;
+            std::vector<Real> values, forwardDerivatives, stdDevDerivatives;
+        };
+        std::vector<Strip> strips;
+        std::map<std::pair<Date, Option::Type>, Size> stripIndex;
 
+        struct Entry {
+            ext::shared_ptr<StrikedTypePayoff> payoff;
+            Date exerciseDate;
+            const ExpiryData* data;
+            Size strip, position;
+        };
+        std::vector<Entry> entries;
+        entries.reserve(instruments.size());
+
+        for (const auto* instrument : instruments) {
+            instrument->setupArguments(&arguments_);
+            arguments_.validate();
+
+            QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                       "not an European option");
+            ext::shared_ptr<StrikedTypePayoff> payoff =
+                ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
+            QL_REQUIRE(payoff, "non-striked payoff given");
+
+            const Date& exerciseDate = arguments_.exercise->lastDate();
+            auto data = expiries.find(exerciseDate);
+            if (data == expiries.end())
+                data = expiries.emplace(exerciseDate,
+                                        expiryData(exerciseDate, *discountPtr)).first;
+            Entry entry = { payoff, exerciseDate, &data->second,
+                            Null<Size>(), Null<Size>() };
+
+            // other payoffs and the cases which BlackCalculator
+            // treats as degenerate go through calculate() below
+            Real strike = payoff->strike();
+            Real stdDev = std::sqrt(
+                process_->blackVolatility()->blackVariance(exerciseDate, strike));
+            const ExpiryData& d = data->second;
+            if (ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff)
+                && stdDev >= QL_EPSILON && !close(strike, 0.0)
+                && d.riskFreeTime >= 0.0 && d.dividendTime >= 0.0
+                && d.volatilityTime >= 0.0) {
+                auto key = std::make_pair(exerciseDate, payoff->optionType());
+                auto i = stripIndex.find(key);
+                if (i == stripIndex.end()) {
+                    i = stripIndex.emplace(key, strips.size()).first;
+                    strips.push_back({ payoff->optionType(), &d,
+                                       spot * d.dividendDiscount / d.riskFreeDiscount,
+                                       {}, {}, {}, {}, {} });
+                }
+                Strip& strip = strips[i->second];
+                entry.strip = i->second;
+                entry.position = strip.strikes.size();
+                strip.strikes.push_back(strike);
+                strip.stdDevs.push_back(stdDev);
+            }
+            entries.push_back(entry);
+        }
+
+        for (auto& strip : strips) {
+            Real discount = strip.data->discount;
+            strip.values = blackFormula(strip.type, strip.strikes, strip.forward,
+                                        strip.stdDevs, discount);
+            strip.forwardDerivatives =
+                blackFormulaForwardDerivative(strip.type, strip.strikes, strip.forward,
+                                              strip.stdDevs, discount);
+            strip.stdDevDerivatives =
+                blackFormulaStdDevDerivative(strip.strikes, strip.forward,
+                                             strip.stdDevs, discount);
+        }
+
+        // the calculations below set all the results but the ones
+        // left null by the reset, so we don't need to reset (and
+        // reallocate the additional results) for each option
+        results_.reset();
+
+        for (Size k=0; k<instruments.size(); ++k) {
+            const Entry& entry = entries[k];
+            if (entry.strip == Null<Size>()) {
+                calculate(entry.payoff, entry.exerciseDate, spot, *entry.data);
+            } else {
+                const Strip& strip = strips[entry.strip];
+                Size j = entry.position;
+                calculate(strip.type, strip.strikes[j], strip.forward,
+                          strip.stdDevs[j], spot, *strip.data, strip.values[j],
+                          strip.forwardDerivatives[j], strip.stdDevDerivatives[j]);
+            }
+            instruments[k]->fetchResults(&results_);
+        }
+    }
+
+    void AnalyticEuropeanEngine::calculate(const ext::shared_ptr<StrikedTypePayoff>& payoff,
+                                           const Date& exerciseDate,
+                                           Real spot,
+                                           const ExpiryData& data) const {
+        Real variance =
+            process_->blackVolatility()->blackVariance(exerciseDate,
+                                                       payoff->strike());
+        Real forwardPrice = spot * data.dividendDiscount / data.riskFreeDiscount;
+
+        BlackCalculator black(payoff, forwardPrice, std::sqrt(variance), data.discount);
 
         results_.value = black.value();
         results_.delta = black.delta(spot);
@@ -78,19 +214,10 @@ namespace QuantLib {
         results_.elasticity = black.elasticity(spot);
         results_.gamma = black.gamma(spot);
 
-        DayCounter rfdc  = discountPtr->dayCounter();
-        DayCounter divdc = process_->dividendYield()->dayCounter();
-        DayCounter voldc = process_->blackVolatility()->dayCounter();
-        Time t = rfdc.yearFraction(process_->riskFreeRate()->referenceDate(),
-                                   arguments_.exercise->lastDate());
-        results_.rho = black.rho(t);
-
-        t = divdc.yearFraction(process_->dividendYield()->referenceDate(),
-                               arguments_.exercise->lastDate());
-        results_.dividendRho = black.dividendRho(t);
+        results_.rho = black.rho(data.riskFreeTime);
+        results_.dividendRho = black.dividendRho(data.dividendTime);
 
-        t = voldc.yearFraction(process_->blackVolatility()->referenceDate(),
-                               arguments_.exercise->lastDate());
+        Time t = data.volatilityTime;
         results_.vega = black.vega(t);
         try {
             results_.theta = black.theta(spot, t);
@@ -104,15 +231,68 @@ namespace QuantLib {
         results_.strikeSensitivity  = black.strikeSensitivity();
         results_.itmCashProbability = black.itmCashProbability();
 
-        Real tte = process_->blackVolatility()->timeFromReference(arguments_.exercise->lastDate());
+        setAdditionalResults(spot, forwardPrice, payoff->strike(), variance, data);
+    }
+
+    void AnalyticEuropeanEngine::calculate(Option::Type type,
+                                           Real strike,
+                                           Real forward,
+                                           Real stdDev,
+                                           Real spot,
+                                           const ExpiryData& data,
+                                           Real value,
+                                           Real forwardDerivative,
+                                           Real stdDevDerivative) const {
+        // for plain-vanilla payoffs, the greeks returned by
+        // BlackCalculator reduce to combinations of the value and
+        // of its derivatives with respect to forward and stdDev
+        results_.value = value;
+        results_.deltaForward = forwardDerivative;
+        results_.delta = forwardDerivative * forward / spot;
+        if (value > QL_EPSILON)
+            results_.elasticity = results_.delta / value * spot;
+        else if (std::fabs(results_.delta) < QL_EPSILON)
+            results_.elasticity = 0.0;
+        else if (results_.delta > 0.0)
+            results_.elasticity = QL_MAX_REAL;
+        else
+            results_.elasticity = QL_MIN_REAL;
+        results_.gamma = stdDevDerivative / (stdDev * spot * spot);
+
+        results_.rho = data.riskFreeTime * (forward * forwardDerivative - value);
+        results_.dividendRho = -data.dividendTime * forward * forwardDerivative;
+
+        Time t = data.volatilityTime;
+        results_.vega = std::sqrt(t) * stdDevDerivative;
+        if (close(t, 0.0)) {
+            results_.theta = 0.0;
+        } else {
+            results_.theta = -(std::log(data.discount) * value
+                               + std::log(forward / spot) * spot * results_.delta
+                               + 0.5 * stdDev * stdDev * spot * spot * results_.gamma) / t;
+        }
+        results_.thetaPerDay = results_.theta / 365.0;
+
+        results_.strikeSensitivity = (value - forward * forwardDerivative) / strike;
+        results_.itmCashProbability = (type == Option::Call ? 0.0 : 1.0)
+            - results_.strikeSensitivity / data.discount;
+
+        setAdditionalResults(spot, forward, strike, stdDev * stdDev, data);
+    }
+
+    void AnalyticEuropeanEngine::setAdditionalResults(Real spot,
+                                                      Real forward,
+                                                      Real strike,
+                                                      Real variance,
+                                                      const ExpiryData& data) const {
+        Real tte = data.timeToExpiry;
         results_.additionalResults["spot"] = spot;
-        results_.additionalResults["dividendDiscount"] = dividendDiscount;
-        results_.additionalResults["riskFreeDiscount"] = riskFreeDiscountForFwdEstimation;
-        results_.additionalResults["forward"] = forwardPrice;
-        results_.additionalResults["strike"] = payoff->strike();
+        results_.additionalResults["dividendDiscount"] = data.dividendDiscount;
+        results_.additionalResults["riskFreeDiscount"] = data.riskFreeDiscount;
+        results_.additionalResults["forward"] = forward;
+        results_.additionalResults["strike"] = strike;
         results_.additionalResults["volatility"] = Real(std::sqrt(variance / tte));
         results_.additionalResults["timeToExpiry"] = tte;
     }
 
 }
-
@@ -74,8 +74,46 @@ namespace QuantLib {
         AnalyticEuropeanEngine(ext::shared_ptr<GeneralizedBlackScholesProcess> process,
                                Handle<YieldTermStructure> discountCurve);
         void calculate() const override;
+        /*! Term-structure lookups depending only on the exercise
+            date are done once per distinct date in the batch, and
+            the engine results are reused across options.
+            Plain-vanilla options sharing exercise date and type are
+            priced by the strip versions of blackFormula and of its
+            forward and standard-deviation derivatives, from which
+            the other greeks are derived; other payoffs and
+            degenerate cases (null volatility or strike) are priced
+            one at a time as in calculate().
+        */
+        void calculateBatch(const std::vector<const Instrument*>& instruments) const override;
 
       private:
+        // market data depending on the exercise date only
+        struct ExpiryData {
+            DiscountFactor dividendDiscount, discount, riskFreeDiscount;
+            Time riskFreeTime, dividendTime, volatilityTime, timeToExpiry;
+        };
+        ext::shared_ptr<YieldTermStructure> discountCurve() const;
+        ExpiryData expiryData(const Date& exerciseDate,
+                              const YieldTermStructure& discountTS) const;
+        void calculate(const ext::shared_ptr<StrikedTypePayoff>& payoff,
+                       const Date& exerciseDate,
+                       Real spot,
+                       const ExpiryData& data) const;
+        void calculate(Option::Type type,
+                       Real strike,
+                       Real forward,
+                       Real stdDev,
+                       Real spot,
+                       const ExpiryData& data,
+                       Real value,
+                       Real forwardDerivative,
+                       Real stdDevDerivative) const;
+        void setAdditionalResults(Real spot,
+                                  Real forward,
+                                  Real strike,
+                                  Real variance,
+                                  const ExpiryData& data) const;
+
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Handle<YieldTermStructure> discountCurve_;
     };
@@ -41,6 +41,7 @@
 #include <boost/math/tools/minima.hpp>
 #include <boost/math/special_functions/sign.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <utility>
@@ -53,6 +54,9 @@ namespace QuantLib {
 
     namespace {
 
+        // bound on the number of slices kept by the engine
+        const Size maxCachedSlices = 256;
+
         class integrand1 {
           private:
             const Real c_inf_;
@@ -137,6 +141,9 @@ namespace QuantLib {
 
       Real operator()(Real phi) const;
 
+      // exponent of the integrand of Gatheral's formulation, phi != 0
+      std::complex<Real> exponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -180,7 +187,8 @@ namespace QuantLib {
     {
     }
 
-    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -192,33 +200,34 @@ namespace QuantLib {
         const std::complex<Real> addOnTerm =
             engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
+        if (sigma_ > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g
+                                    = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                   + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                   + std::complex<Real>(0.0, phi*(dd_-sx_))
+                   + addOnTerm;
+        }
+        else {
+            const std::complex<Real> td = phi/(2.0*t1)
+                           *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+            const std::complex<Real> p = td*sigma2_/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return v0_*td*(1.0-ex)/(1.0-p*ex)
+                   + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                   + std::complex<Real>(0.0, phi*(dd_-sx_))
+                   + addOnTerm;
+        }
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+                return std::exp(exponent(phi)).imag()/phi;
             }
             else {
                 // use l'Hospital's rule to get lim_{phi->0}
@@ -244,6 +253,16 @@ namespace QuantLib {
             }
         }
         else if (cpxLog_ == BranchCorrection) {
+            const Real rpsig(rsigma_*phi);
+
+            const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm =
+                engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
             const std::complex<Real> p = (t1+d)/(t1-d);
 
             // next term: g = std::log((1.0 - p*std::exp(d*term_))/(1.0 - p))
@@ -507,6 +526,12 @@ namespace QuantLib {
     }
 
     Real AnalyticHestonEngine::AP_Helper::operator()(Real u) const {
+        return std::exp(-u*tanPhi_*freq_)
+            *(std::exp(std::complex<Real>(0.0, u*freq_))*q(u)).real()
+            *s_alpha_;
+    }
+
+    std::complex<Real> AnalyticHestonEngine::AP_Helper::q(Real u) const {
         QL_REQUIRE(   enginePtr_->addOnTerm(u, term_, 1)
                         == std::complex<Real>(0.0)
                    && enginePtr_->addOnTerm(u, term_, 2)
@@ -527,11 +552,8 @@ namespace QuantLib {
             else if (cpxLog_ == AsymptoticChF)
                 phiBS = std::exp(u*std::complex<Real>(1, tanPhi_)*phi_ + psi_);
 
-            return std::exp(-u*tanPhi_*freq_)
-                    *(std::exp(std::complex<Real>(0.0, u*freq_))
-                      *std::complex<Real>(1, tanPhi_)
-                      *(phiBS - enginePtr_->chF(hPrime, term_))/(h_u*hPrime)
-                      ).real()*s_alpha_;
+            return std::complex<Real>(1, tanPhi_)
+                *(phiBS - enginePtr_->chF(hPrime, term_))/(h_u*hPrime);
         }
         else if (cpxLog_ == AndersenPiterbarg || cpxLog_ == AndersenPiterbargOptCV) {
             const std::complex<Real> z(u, -alpha_);
@@ -541,14 +563,16 @@ namespace QuantLib {
                         std::complex<Real>(-zPrime.imag(), zPrime.real()))
             );
 
-            return (std::exp(std::complex<Real> (0.0, u*freq_))
-                * (phiBS - enginePtr_->chF(zPrime, term_)) / (z*zPrime)
-                ).real()*s_alpha_;
+            return (phiBS - enginePtr_->chF(zPrime, term_)) / (z*zPrime);
         }
         else
             QL_FAIL("unknown control variate");
     }
 
+    Real AnalyticHestonEngine::AP_Helper::tanPhi() const {
+        return tanPhi_;
+    }
+
     Real AnalyticHestonEngine::AP_Helper::controlVariateValue() const {
         if (   cpxLog_ == AngledContour
             || cpxLog_ == AndersenPiterbarg || cpxLog_ == AndersenPiterbargOptCV) {
@@ -658,6 +682,77 @@ namespace QuantLib {
         return A+v0*B;
     }
 
+    void AnalyticHestonEngine::lnChFGradient(
+        const std::complex<Real>& z, Time t,
+        std::vector<std::complex<Real> >& grad) const {
+
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real sigma2 = sigma*sigma;
+
+        // same steps as in lnChF
+        const std::complex<Real> iz(-z.imag(), z.real());
+        const std::complex<Real> w = z*std::complex<Real>(z.real(), z.imag()+1);
+
+        const std::complex<Real> g = kappa - rho*sigma*iz;
+        const std::complex<Real> D = std::sqrt(g*g + w*sigma2);
+
+        const bool andersenLake
+            = (g.real()*D.real() + g.imag()*D.imag() > 0.0);
+        const std::complex<Real> r = (andersenLake) ? -sigma2*w/(g+D) : g-D;
+
+        const bool nonZeroD = (D.real() != 0.0 || D.imag() != 0.0);
+        const std::complex<Real> y = (nonZeroD) ? expm1(-D*t)/(2.0*D)
+                                                : std::complex<Real>(-0.5*t);
+
+        const std::complex<Real> K = r*t - 2.0*log1p(-r*y);
+        const std::complex<Real> A = kappa*theta/sigma2*K;
+        const std::complex<Real> B = w*y/(1.0-r*y);
+
+        // directional derivative of A+v0*B with respect to kappa,
+        // sigma and rho, forward mode through the steps above
+        const auto tangent = [&](Real dKappa, Real dSigma, Real dRho) {
+            const std::complex<Real> dg = dKappa - (dRho*sigma + rho*dSigma)*iz;
+            const std::complex<Real> dD = (nonZeroD)
+                ? std::complex<Real>((g*dg + w*sigma*dSigma)/D)
+                : std::complex<Real>(0.0);
+
+            const std::complex<Real> dr = (andersenLake)
+                ? r*(2.0*dSigma/sigma - (dg+dD)/(g+D)) : dg-dD;
+            const std::complex<Real> dy = (nonZeroD)
+                ? -dD*(t*(1.0+2.0*D*y) + 2.0*y)/(2.0*D)
+                : dD*0.25*t*t;
+
+            const std::complex<Real> dK = dr*t + 2.0*(dr*y + r*dy)/(1.0-r*y);
+            const std::complex<Real> dA = theta/sigma2*K*dKappa
+                - 2.0*A/sigma*dSigma + kappa*theta/sigma2*dK;
+            const std::complex<Real> dB
+                = w*(dy + y*y*dr)/((1.0-r*y)*(1.0-r*y));
+
+            return dA + v0*dB;
+        };
+
+        grad.resize(5);
+        grad[0] = kappa/sigma2*K;
+        grad[1] = tangent(1.0, 0.0, 0.0);
+        grad[2] = tangent(0.0, 1.0, 0.0);
+        grad[3] = tangent(0.0, 0.0, 1.0);
+        grad[4] = B;
+    }
+
+    void AnalyticHestonEngine::addOnTermGradient(
+        const std::complex<Real>&, Time,
+        std::complex<Real>& addOn,
+        std::vector<std::complex<Real> >& grad) const {
+
+        addOn = 0.0;
+        grad.clear();
+    }
+
     AnalyticHestonEngine::AnalyticHestonEngine(
                               const ext::shared_ptr<HestonModel>& model,
                               Size integrationOrder)
@@ -774,18 +869,37 @@ namespace QuantLib {
         switch(cpxLog_) {
           case Gatheral:
           case BranchCorrection: {
-            const Real c_inf = std::min(0.2, std::max(0.0001,
-                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*maturity);
-
-            const Real p1 = integration_->calculate(c_inf,
-                Fj_Helper(kappa, theta, sigma, v0, spot, rho, this,
-                          cpxLog_, maturity, strike, df, 1))/M_PI;
-            evaluations_ += integration_->numberOfEvaluations();
+            Real p1, p2;
+            if (cpxLog_ == Gatheral && integration_->isGaussianQuadrature()) {
+                const Slice& s = gatheralSlice(maturity, fwd);
+
+                const Real sx = std::log(strike);
+                p1 = s.s1 - s.w0*sx;
+                p2 = s.s2 - s.w0*sx;
+                for (Size i=0; i < s.x.size(); ++i) {
+                    const Real phase = s.x[i]*sx;
+                    p1 += s.c1[i]*std::sin(s.a1[i] - phase);
+                    p2 += s.c2[i]*std::sin(s.a2[i] - phase);
+                }
+                p1 /= M_PI;
+                p2 /= M_PI;
 
-            const Real p2 = integration_->calculate(c_inf,
-                Fj_Helper(kappa, theta, sigma, v0, spot, rho, this,
-                          cpxLog_, maturity, strike, df, 2))/M_PI;
-            evaluations_ += integration_->numberOfEvaluations();
+                evaluations_ += 2*integration_->numberOfEvaluations();
+            }
+            else {
+                const Real c_inf = std::min(0.2, std::max(0.0001,
+                    std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*maturity);
+
+                p1 = integration_->calculate(c_inf,
+                    Fj_Helper(kappa, theta, sigma, v0, spot, rho, this,
+                              cpxLog_, maturity, strike, df, 1))/M_PI;
+                evaluations_ += integration_->numberOfEvaluations();
+
+                p2 = integration_->calculate(c_inf,
+                    Fj_Helper(kappa, theta, sigma, v0, spot, rho, this,
+                              cpxLog_, maturity, strike, df, 2))/M_PI;
+                evaluations_ += integration_->numberOfEvaluations();
+            }
 
             switch (payoff->optionType())
             {
@@ -835,8 +949,26 @@ namespace QuantLib {
                 ? std::max(0.25, std::min(1000.0, 0.25/std::sqrt(0.5*vAvg*maturity)))
                 : Real(1.0);
 
-            const Real h_cv =
-                fwd/M_PI*integration_->calculate(c_inf, cvHelper, uM, scalingFactor);
+            Real h_cv;
+            if (integration_->isGaussianQuadrature()) {
+                const Slice& s = controlVariateSlice(
+                    maturity, fwd, c_inf, finalLog, cvHelper);
+
+                const Real freq = std::log(fwd/strike);
+                const Real tanPhi = cvHelper.tanPhi();
+
+                Real h = 0.0;
+                for (Size i=0; i < s.x.size(); ++i) {
+                    const Real phase = s.x[i]*freq;
+                    h += s.w[i]*std::exp(-phase*tanPhi)
+                        *(std::cos(phase)*s.q[i].real()
+                          - std::sin(phase)*s.q[i].imag());
+                }
+                h_cv = fwd/M_PI*h*std::exp(alpha_*freq);
+            }
+            else
+                h_cv = fwd/M_PI*integration_->calculate(
+                    c_inf, cvHelper, uM, scalingFactor);
 
             evaluations_ += integration_->numberOfEvaluations();
 
@@ -860,6 +992,335 @@ namespace QuantLib {
         return value;
     }
 
+    std::vector<Real> AnalyticHestonEngine::priceVanillaPayoffs(
+        const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+        const Date& maturity) const {
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+        const Real fwd = process->s0()->value()
+             * process->dividendYield()->discount(maturity)
+             / process->riskFreeRate()->discount(maturity);
+        const Time t = process->time(maturity);
+
+        std::vector<Real> retVal;
+        retVal.reserve(payoffs.size());
+        for (const auto& payoff: payoffs)
+            retVal.push_back(priceVanillaPayoff(payoff, t, fwd));
+
+        return retVal;
+    }
+
+    std::vector<Real> AnalyticHestonEngine::priceVanillaPayoffs(
+        const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+        Time maturity) const {
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+        const Real fwd = process->s0()->value()
+             * process->dividendYield()->discount(maturity)
+             / process->riskFreeRate()->discount(maturity);
+
+        std::vector<Real> retVal;
+        retVal.reserve(payoffs.size());
+        for (const auto& payoff: payoffs)
+            retVal.push_back(priceVanillaPayoff(payoff, maturity, fwd));
+
+        return retVal;
+    }
+
+    Array AnalyticHestonEngine::priceVanillaPayoffGradient(
+        const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+        const Date& maturity) const {
+
+        QL_REQUIRE(hasPriceGradient(),
+                   "price gradient not available for this engine");
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+        const DiscountFactor df = process->riskFreeRate()->discount(maturity);
+        const Real fwd = process->s0()->value()
+             * process->dividendYield()->discount(maturity) / df;
+        const Time t = process->time(maturity);
+        const Real strike = payoff->strike();
+
+        const Size n = model_->params().size();
+
+        if (integration_->isGaussianQuadrature()) {
+            // the strike only enters the phase of the integrand
+            const GradientSlice& s = gradientSlice(t, fwd);
+            const Real freq = std::log(fwd/strike);
+
+            Array retVal(n, 0.0);
+            for (Size i=0; i < s.x.size(); ++i) {
+                const std::complex<Real> phase
+                    = std::exp(std::complex<Real>(0.0, s.x[i]*freq));
+                for (Size k=0; k < n; ++k)
+                    retVal[k] += (phase*(s.a[i*n+k] - strike*s.b[i*n+k])).real();
+            }
+            return retVal*(df/M_PI);
+        }
+
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*t);
+
+        return vanillaPriceGradient(
+            *integration_, c_inf, fwd, strike, df, n,
+            [&](const std::complex<Real>& z,
+                std::vector<std::complex<Real> >& grad) {
+                chFGradient(z, t, grad);
+            });
+    }
+
+    void AnalyticHestonEngine::chFGradient(
+        const std::complex<Real>& z, Time t,
+        std::vector<std::complex<Real> >& grad) const {
+
+        std::complex<Real> addOn;
+        std::vector<std::complex<Real> > addOnGrad;
+
+        lnChFGradient(z, t, grad);
+        addOnTermGradient(z, t, addOn, addOnGrad);
+        QL_REQUIRE(grad.size() + addOnGrad.size() == model_->params().size(),
+                   "gradient of the add-on term has " << addOnGrad.size()
+                   << " components, "
+                   << model_->params().size() - grad.size() << " expected");
+        grad.insert(grad.end(), addOnGrad.begin(), addOnGrad.end());
+
+        const std::complex<Real> phi = std::exp(lnChF(z, t) + addOn);
+        for (auto& g: grad)
+            g *= phi;
+    }
+
+    const AnalyticHestonEngine::GradientSlice&
+    AnalyticHestonEngine::gradientSlice(Time maturity, Real fwd) const {
+        const Array params = model_->params();
+        const Size n = params.size();
+
+        const auto iter = gradientSlices_.find(maturity);
+        if (iter != gradientSlices_.end() && iter->second.fwd == fwd
+            && std::equal(params.begin(), params.end(),
+                          iter->second.params.begin(),
+                          iter->second.params.end()))
+            return iter->second;
+
+        if (gradientSlices_.size() >= maxCachedSlices
+            && gradientSlices_.count(maturity) == 0)
+            gradientSlices_.clear();
+
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*maturity);
+
+        GradientSlice& s = gradientSlices_[maturity];
+        s.fwd = fwd;
+        s.params = params;
+
+        std::vector<Real> w;
+        integration_->gaussianQuadratureNodes(c_inf, s.x, w);
+        s.a.resize(s.x.size()*n);
+        s.b.resize(s.x.size()*n);
+
+        std::vector<std::complex<Real> > g1, g2;
+        for (Size i=0; i < s.x.size(); ++i) {
+            // avoid the removable singularity at u=0
+            const Real u = std::max(
+                Real(std::numeric_limits<float>::epsilon()), s.x[i]);
+
+            chFGradient(std::complex<Real>(u, -1.0), maturity, g1);
+            chFGradient(std::complex<Real>(u, 0.0), maturity, g2);
+
+            const std::complex<Real> f = w[i]/std::complex<Real>(0.0, u);
+            for (Size k=0; k < n; ++k) {
+                s.a[i*n+k] = f*fwd*g1[k];
+                s.b[i*n+k] = f*g2[k];
+            }
+        }
+
+        return s;
+    }
+
+    bool AnalyticHestonEngine::hasPriceGradient() const {
+        return hasAddOnTermGradient();
+    }
+
+    Array AnalyticHestonEngine::vanillaPriceGradient(
+        const Integration& integration, Real c_inf,
+        Real fwd, Real strike, DiscountFactor df, Size n,
+        const std::function<void(const std::complex<Real>&,
+                                 std::vector<std::complex<Real> >&)>& gradChF) {
+
+        // The call price reads
+        //   df*((fwd-strike)/2 + 1/pi \int_0^\infty
+        //       Re(e^{iuf}(fwd*phi(u-i) - strike*phi(u))/(iu)) du)
+        // with the log-moneyness f and the normalized characteristic
+        // function phi. The put price differs by a parameter
+        // independent term, hence both share the gradient.
+        const Real freq = std::log(fwd/strike);
+
+        std::vector<std::complex<Real> > g1, g2;
+        const auto integrand = [&](Real u, Array& f) {
+            // avoid the removable singularity at u=0
+            u = std::max(Real(std::numeric_limits<float>::epsilon()), u);
+
+            gradChF(std::complex<Real>(u, -1.0), g1);
+            gradChF(std::complex<Real>(u, 0.0), g2);
+
+            const std::complex<Real> phase
+                = std::exp(std::complex<Real>(0.0, u*freq))
+                    / std::complex<Real>(0.0, u);
+
+            for (Size k=0; k < n; ++k)
+                f[k] = (phase*(fwd*g1[k] - strike*g2[k])).real();
+        };
+
+        Array retVal(n, 0.0), f(n);
+        if (integration.isGaussianQuadrature()) {
+            std::vector<Real> x, w;
+            integration.gaussianQuadratureNodes(c_inf, x, w);
+
+            for (Size i=0; i < x.size(); ++i) {
+                integrand(x[i], f);
+                for (Size k=0; k < n; ++k)
+                    retVal[k] += w[i]*f[k];
+            }
+        }
+        else {
+            for (Size k=0; k < n; ++k)
+                retVal[k] = integration.calculate(
+                    c_inf, [&](Real u) -> Real { integrand(u, f); return f[k]; });
+        }
+
+        return retVal*(df/M_PI);
+    }
+
+    AnalyticHestonEngine::Slice* AnalyticHestonEngine::cachedSlice(
+        const SliceKey& key, Real fwd) const {
+
+        const auto iter = slices_.find(key);
+        if (iter == slices_.end())
+            return nullptr;
+
+        Slice& s = iter->second;
+        if (   s.fwd == fwd
+            && s.v0 == model_->v0() && s.kappa == model_->kappa()
+            && s.theta == model_->theta() && s.sigma == model_->sigma()
+            && s.rho == model_->rho())
+            return &s;
+        else
+            return nullptr;
+    }
+
+    AnalyticHestonEngine::Slice&
+    AnalyticHestonEngine::newSlice(const SliceKey& key) const {
+        // bound on the memory held by the cache, e.g., when the
+        // engine is used for many different maturities
+        if (slices_.size() >= maxCachedSlices && slices_.count(key) == 0)
+            slices_.clear();
+
+        Slice& s = slices_[key];
+        s = Slice();
+        s.cpxLog = std::get<0>(key);
+        return s;
+    }
+
+    const AnalyticHestonEngine::Slice&
+    AnalyticHestonEngine::gatheralSlice(Time maturity, Real fwd) const {
+        const SliceKey key(Gatheral, maturity, 0);
+        if (const Slice* cached = cachedSlice(key, fwd))
+            return *cached;
+
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*maturity);
+
+        Slice& s = newSlice(key);
+        s.fwd = fwd;
+        s.v0 = v0; s.kappa = kappa; s.theta = theta;
+        s.sigma = sigma; s.rho = rho;
+
+        std::vector<Real> x, w;
+        integration_->gaussianQuadratureNodes(c_inf, x, w);
+
+        // the strike enters the integrands only via the phase
+        // -phi*log(strike), hence the helpers for strike one
+        // give the strike-independent part.
+        const Real spot = model_->process()->s0()->value();
+        const Fj_Helper f1(kappa, theta, sigma, v0, spot, rho, this,
+                           Gatheral, maturity, 1.0, spot/fwd, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, spot, rho, this,
+                           Gatheral, maturity, 1.0, spot/fwd, 2);
+
+        for (Size i=0; i < x.size(); ++i) {
+            if (x[i] != 0.0) {
+                const std::complex<Real> e1 = f1.exponent(x[i]);
+                const std::complex<Real> e2 = f2.exponent(x[i]);
+
+                s.x.push_back(x[i]);
+                s.w.push_back(w[i]);
+                s.c1.push_back(w[i]*std::exp(e1.real())/x[i]);
+                s.a1.push_back(e1.imag());
+                s.c2.push_back(w[i]*std::exp(e2.real())/x[i]);
+                s.a2.push_back(e2.imag());
+            }
+            else {
+                s.s1 += w[i]*f1(0.0);
+                s.s2 += w[i]*f2(0.0);
+                s.w0 += w[i];
+            }
+        }
+
+        return s;
+    }
+
+    const AnalyticHestonEngine::Slice&
+    AnalyticHestonEngine::controlVariateSlice(
+        Time maturity, Real fwd, Real c_inf,
+        ComplexLogFormula cpxLog, const AP_Helper& helper) const {
+
+        // the contour angle is either zero or +/- pi/12
+        const Real tanPhi = helper.tanPhi();
+        const SliceKey key(cpxLog, maturity,
+                           (tanPhi > 0.0) ? 1 : ((tanPhi < 0.0) ? -1 : 0));
+        if (const Slice* cached = cachedSlice(key, fwd))
+            return *cached;
+
+        Slice& s = newSlice(key);
+        s.fwd = fwd;
+        s.v0 = model_->v0(); s.kappa = model_->kappa();
+        s.theta = model_->theta(); s.sigma = model_->sigma();
+        s.rho = model_->rho();
+
+        integration_->gaussianQuadratureNodes(c_inf, s.x, s.w);
+
+        s.q.reserve(s.x.size());
+        for (Real u: s.x)
+            s.q.push_back(helper.q(u));
+
+        return s;
+    }
+
+    void AnalyticHestonEngine::update() {
+        slices_.clear();
+        gradientSlices_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
@@ -991,6 +1452,42 @@ namespace QuantLib {
             || intAlgo_ == ExpSinh;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return gaussianQuadrature_ != nullptr;
+    }
+
+    void AnalyticHestonEngine::Integration::gaussianQuadratureNodes(
+        Real c_inf, std::vector<Real>& x, std::vector<Real>& w) const {
+
+        QL_REQUIRE(gaussianQuadrature_ != nullptr,
+                   "Gaussian quadrature required");
+
+        const Array& xq = gaussianQuadrature_->x();
+        const Array& wq = gaussianQuadrature_->weights();
+
+        x.clear();
+        w.clear();
+        for (Integer i = Integer(gaussianQuadrature_->order())-1; i >= 0; --i) {
+            switch(intAlgo_) {
+              case GaussLaguerre:
+                x.push_back(xq[i]);
+                w.push_back(wq[i]);
+                break;
+              case GaussLegendre:
+              case GaussChebyshev:
+              case GaussChebyshev2nd:
+                // same transformation as integrand1
+                if ((1.0-xq[i])*c_inf > QL_EPSILON) {
+                    x.push_back(-std::log(0.5-0.5*xq[i])/c_inf);
+                    w.push_back(wq[i]/((1.0-xq[i])*c_inf));
+                }
+                break;
+              default:
+                QL_FAIL("unknown Gaussian quadrature");
+            }
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
         Real c_inf,
         const std::function<Real(Real)>& f,
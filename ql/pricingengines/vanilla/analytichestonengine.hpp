@@ -33,6 +33,8 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <tuple>
+#include <map>
 
 namespace QuantLib {
 
@@ -137,6 +139,7 @@ namespace QuantLib {
                              Real andersenPiterbargEpsilon = 1e-25,
                              Real alpha = -0.5);
 
+        void update() override;
         void calculate() const override;
 
         // normalized characteristic function
@@ -170,28 +173,141 @@ namespace QuantLib {
         Real priceVanillaPayoff(
            const ext::shared_ptr<PlainVanillaPayoff>& payoff, Time maturity) const;
 
+        /*! Prices several payoffs with the same maturity. Using
+            Gatheral's complex logarithm and a Gaussian quadrature,
+            the characteristic function is evaluated only once on the
+            nodes of the quadrature and shared by all strikes. These
+            evaluations are kept until the model changes, so that
+            single options with the same maturity, e.g. the
+            calibration helpers of a maturity sharing this engine,
+            reuse them as well. Otherwise the payoffs are priced one
+            by one.
+        */
+        std::vector<Real> priceVanillaPayoffs(
+           const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+           const Date& maturity) const;
+
+        std::vector<Real> priceVanillaPayoffs(
+           const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+           Time maturity) const;
+
+        /*! Gradient of the price with respect to the model
+            parameters, in the order of HestonModel::params(). It is
+            calculated from the analytic gradient of the
+            characteristic function, see
+            Y. Cui, S. del Baño Rollin, G. Germano, 2017. Full and fast
+            calibration of the Heston stochastic volatility model.
+            European Journal of Operational Research 263, 625-638.
+            It is only available if hasPriceGradient() returns true.
+        */
+        Array priceVanillaPayoffGradient(
+           const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+           const Date& maturity) const;
+
+        //! whether priceVanillaPayoffGradient() is available
+        bool hasPriceGradient() const;
+
+        // gradient of the normalized log characteristic function
+        // with respect to theta, kappa, sigma, rho and v0
+        void lnChFGradient(const std::complex<Real>& z, Time t,
+                           std::vector<std::complex<Real> >& grad) const;
+
+        /*! Integrates the gradient of a vanilla price from the
+            gradient of the normalized characteristic function, which
+            is given by gradChF. Shared with the piecewise time
+            dependent Heston engine.
+        */
+        static Array vanillaPriceGradient(
+            const Integration& integration, Real c_inf,
+            Real fwd, Real strike, DiscountFactor df, Size n,
+            const std::function<void(const std::complex<Real>&,
+                                     std::vector<std::complex<Real> >&)>&
+                gradChF);
+
         static ComplexLogFormula optimalControlVariate(
              Time t, Real v0, Real kappa, Real theta, Real sigma, Real rho);
 
       protected:
         // call back for extended stochastic volatility
-        // plus jump diffusion engines like bates model
+        // plus jump diffusion engines like bates model.  Engines
+        // overriding it must also override hasAddOnTermGradient()
+        // and, if the latter returns true, addOnTermGradient().
         virtual std::complex<Real> addOnTerm(Real phi,
                                              Time t,
                                              Size j) const;
 
+        //! whether addOnTermGradient() is available
+        /*! The default implementation returns true, since the
+            default add-on term is null.
+        */
+        virtual bool hasAddOnTermGradient() const { return true; }
+
+        /*! add-on term of the normalized log characteristic function
+            at z and its gradient with respect to the model
+            parameters following the Heston ones. The default
+            implementation handles engines without add-on term.
+        */
+        virtual void addOnTermGradient(
+            const std::complex<Real>& z, Time t,
+            std::complex<Real>& addOn,
+            std::vector<std::complex<Real> >& grad) const;
+
       private:
         class Fj_Helper;
 
+        // strike-independent part of the Fourier integrals of one
+        // maturity on the nodes x with weights w of the quadrature
+        struct Slice {
+            ComplexLogFormula cpxLog;
+            Real fwd, v0, kappa, theta, sigma, rho;
+            std::vector<Real> x, w;
+            // Gatheral: the j-th integrand at x reads
+            // c_j*sin(a_j - x*log(strike)), nodes at zero contribute
+            // s_j - w0*log(strike)
+            std::vector<Real> c1, a1, c2, a2;
+            Real s1 = 0.0, s2 = 0.0, w0 = 0.0;
+            // control variates: the factor q of AP_Helper
+            std::vector<std::complex<Real> > q;
+        };
+
         Real priceVanillaPayoff(
            const ext::shared_ptr<PlainVanillaPayoff>& payoff,
            Time maturity, Real fwd) const;
 
+        // the slices are only used with Gaussian quadratures.  They
+        // are keyed by formula, maturity and sign of the contour
+        // angle, which is the only strike dependence of the control
+        // variate integrands; hence, there are at most three slices
+        // per maturity.
+        typedef std::tuple<ComplexLogFormula, Time, Integer> SliceKey;
+        Slice* cachedSlice(const SliceKey& key, Real fwd) const;
+        Slice& newSlice(const SliceKey& key) const;
+        const Slice& gatheralSlice(Time maturity, Real fwd) const;
+        const Slice& controlVariateSlice(
+            Time maturity, Real fwd, Real c_inf,
+            ComplexLogFormula cpxLog, const AP_Helper& helper) const;
+
+        // strike-independent part of the gradient integrals of one
+        // maturity: at the i-th node x of the quadrature and for the
+        // k-th parameter, a[i*n+k] = w*fwd*dphi_k(x-i)/(ix) and
+        // b[i*n+k] = w*dphi_k(x)/(ix); see vanillaPriceGradient.
+        struct GradientSlice {
+            Real fwd;
+            Array params;
+            std::vector<Real> x;
+            std::vector<std::complex<Real> > a, b;
+        };
+        const GradientSlice& gradientSlice(Time maturity, Real fwd) const;
+        // gradient of the normalized characteristic function
+        void chFGradient(const std::complex<Real>& z, Time t,
+                         std::vector<std::complex<Real> >& grad) const;
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_, alpha_;
+        mutable std::map<SliceKey, Slice> slices_;
+        mutable std::map<Time, GradientSlice> gradientSlices_;
     };
 
 
@@ -236,6 +352,13 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
+
+        // abscissas and weights of a Gaussian quadrature in terms of
+        // the integration variable, in the order of summation
+        void gaussianQuadratureNodes(Real c_inf,
+                                     std::vector<Real>& x,
+                                     std::vector<Real>& w) const;
 
       private:
         enum Algorithm
@@ -264,13 +387,21 @@ namespace QuantLib {
         Real operator()(Real u) const;
         Real controlVariateValue() const;
 
+        /*! The integrand reads
+            \f$ e^{-u \tan\phi f} \mathrm{Re}(e^{iuf} q(u)) e^{\alpha f} \f$
+            with the log-moneyness \f$ f \f$. The factor \f$ q(u) \f$
+            depends on the strike only via the angle of the contour.
+        */
+        std::complex<Real> q(Real u) const;
+        Real tanPhi() const;
+
       private:
         const Time term_;
         const Real fwd_, strike_, freq_;
         const ComplexLogFormula cpxLog_;
         const AnalyticHestonEngine* const enginePtr_;
         const Real alpha_, s_alpha_;
-        Real vAvg_, tanPhi_;
+        Real vAvg_, tanPhi_ = 0.0;
         std::complex<Real> phi_, psi_;
     };
 
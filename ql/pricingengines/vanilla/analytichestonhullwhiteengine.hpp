@@ -80,6 +80,7 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTermGradient() const override { return false; }
 
         const ext::shared_ptr<HullWhite> hullWhiteModel_;
 
@@ -208,6 +208,161 @@ namespace QuantLib {
         return std::exp(lnChF(z, T));
     }
 
+    void AnalyticPTDHestonEngine::lnChFGradient(
+        const std::complex<Real>& z, Time T,
+        std::vector<std::complex<Real> >& grad) const {
+
+        const Real v0 = model_->v0();
+
+        const TimeGrid& timeGrid = model_->timeGrid();
+        const Time lastModelTime = timeGrid.back();
+
+        QL_REQUIRE(T <= lastModelTime,
+                   "maturity (" << T << ") is too large, "
+                   "time grid is bounded by " << lastModelTime);
+
+        const Size lastI = std::distance(timeGrid.begin(),
+            std::lower_bound(timeGrid.begin(), timeGrid.end(), T));
+
+        // position of theta, kappa, sigma, rho and v0 in params()
+        Size offset[6] = { 0 };
+        for (Size a=0; a < 5; ++a)
+            offset[a+1] = offset[a] + model_->argument(a).size();
+        const Size n = offset[5];
+
+        const std::complex<Real> iz(-z.imag(), z.real());
+        const std::complex<Real> w
+            = z*std::complex<Real>(z.real(), z.imag()+1);
+
+        std::complex<Real> D = 0.0;
+        std::complex<Real> C = 0.0;
+        std::vector<std::complex<Real> > dD(n, 0.0), dC(n, 0.0);
+
+        for (Integer i=lastI-1; i >= 0; --i) {
+            const Time begin = timeGrid[i];
+            const Time end = std::min(T, timeGrid[i+1]);
+            const Time tau = end - begin;
+
+            const Time t     = 0.5*(end+begin);
+            const Real kappa = model_->kappa(t);
+            const Real sigma = model_->sigma(t);
+            const Real theta = model_->theta(t);
+            const Real rho   = model_->rho(t);
+
+            const Real sigma2 = sigma*sigma;
+
+            // same steps as in lnChF
+            const std::complex<Real> k = kappa - rho*sigma*iz;
+            const std::complex<Real> d = std::sqrt(k*k + w*sigma2);
+            const std::complex<Real> g = (k-d)/(k+d);
+            const std::complex<Real> gt = (k-d-D*sigma2)/(k+d-D*sigma2);
+            const std::complex<Real> e = std::exp(-d*tau);
+
+            const std::complex<Real> M
+                = (k-d)*tau - 2.0*std::log((1.0-gt*e)/(1.0-gt));
+            const std::complex<Real> Q = (g - gt*e)/(1.0 - gt*e);
+
+            // derivatives of theta, kappa, sigma and rho at t
+            // with respect to the j-th model parameter
+            Real dArg[4];
+            for (Size j=0; j < offset[4]; ++j) {
+                std::fill(dArg, dArg+4, 0.0);
+                Size a = 0;
+                while (j >= offset[a+1])
+                    ++a;
+
+                const Parameter& p = model_->argument(a);
+                const Real h = 1e-6*std::max(1.0, std::fabs(p.params()[j-offset[a]]));
+                Array x = p.params();
+                x[j-offset[a]] += h;
+                const Real up = p.implementation()->value(x, t);
+                x[j-offset[a]] -= 2*h;
+                dArg[a] = (up - p.implementation()->value(x, t))/(2*h);
+
+                if (dArg[a] == 0.0 && dD[j] == 0.0)
+                    continue;
+
+                const Real dTheta = dArg[0], dKappa = dArg[1];
+                const Real dSigma = dArg[2], dRho = dArg[3];
+
+                // forward mode through the steps above
+                const std::complex<Real> dk
+                    = dKappa - (dRho*sigma + rho*dSigma)*iz;
+                const std::complex<Real> dd = (k*dk + w*sigma*dSigma)/d;
+                const std::complex<Real> dg = 2.0*(d*dk - k*dd)/((k+d)*(k+d));
+
+                const std::complex<Real> num = k-d-D*sigma2;
+                const std::complex<Real> den = k+d-D*sigma2;
+                const std::complex<Real> dDs = dD[j]*sigma2 + 2.0*D*sigma*dSigma;
+                const std::complex<Real> dgt
+                    = ((dk-dd-dDs)*den - num*(dk+dd-dDs))/(den*den);
+                const std::complex<Real> de = -tau*e*dd;
+
+                const std::complex<Real> dM = (dk-dd)*tau
+                    + 2.0*(dgt*e + gt*de)/(1.0-gt*e) - 2.0*dgt/(1.0-gt);
+                const std::complex<Real> dQ
+                    = ((dg - dgt*e - gt*de)*(1.0-gt*e)
+                       + (g - gt*e)*(dgt*e + gt*de))
+                      /((1.0-gt*e)*(1.0-gt*e));
+
+                dC[j] += (dKappa*theta + kappa*dTheta)/sigma2*M
+                    - 2.0*kappa*theta/(sigma2*sigma)*dSigma*M
+                    + kappa*theta/sigma2*dM;
+                dD[j] = (dk+dd)/sigma2*Q
+                    - 2.0*(k+d)/(sigma2*sigma)*dSigma*Q + (k+d)/sigma2*dQ;
+            }
+
+            C += kappa*theta/sigma2*M;
+            D = (k+d)/sigma2*Q;
+        }
+
+        grad.resize(n);
+        for (Size j=0; j < n; ++j)
+            grad[j] = dD[j]*v0 + dC[j];
+        grad[offset[4]] += D;
+    }
+
+    Array AnalyticPTDHestonEngine::priceVanillaPayoffGradient(
+        const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+        const Date& maturity) const {
+
+        const Real term
+            = model_->riskFreeRate()->dayCounter().yearFraction(
+                                     model_->riskFreeRate()->referenceDate(),
+                                     maturity);
+        const DiscountFactor df = model_->riskFreeRate()->discount(maturity);
+        const Real fwd
+            = model_->s0()*model_->dividendYield()->discount(maturity)/df;
+
+        const TimeGrid& timeGrid = model_->timeGrid();
+        const Size m = timeGrid.size()-1;
+        Real kappaAvg = 0.0, thetaAvg = 0.0,  sigmaAvg=0.0, rhoAvg = 0.0;
+        for (Size i=1; i <= m; ++i) {
+            const Time t = 0.5*(timeGrid[i-1] + timeGrid[i]);
+            kappaAvg += model_->kappa(t);
+            thetaAvg += model_->theta(t);
+            sigmaAvg += model_->sigma(t);
+            rhoAvg   += model_->rho(t);
+        }
+        kappaAvg/=m; thetaAvg/=m; sigmaAvg/=m; rhoAvg/=m;
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-squared(rhoAvg))/sigmaAvg))
+            *(model_->v0() + kappaAvg*thetaAvg*term);
+
+        return AnalyticHestonEngine::vanillaPriceGradient(
+            *integration_, c_inf, fwd, payoff->strike(), df,
+            model_->params().size(),
+            [&](const std::complex<Real>& z,
+                std::vector<std::complex<Real> >& grad) {
+                lnChFGradient(z, term, grad);
+
+                const std::complex<Real> phi = chF(z, term);
+                for (auto& g: grad)
+                    g *= phi;
+            });
+    }
+
     AnalyticPTDHestonEngine::AnalyticPTDHestonEngine(
         const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
         Size integrationOrder)
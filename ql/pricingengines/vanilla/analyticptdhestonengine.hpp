@@ -87,6 +87,22 @@ namespace QuantLib {
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
+        // gradient of the normalized log characteristic function
+        // with respect to the model parameters
+        void lnChFGradient(const std::complex<Real>& z, Time t,
+                           std::vector<std::complex<Real> >& grad) const;
+
+        /*! Gradient of the price with respect to the model
+            parameters, in the order of
+            PiecewiseTimeDependentHestonModel::params(). The
+            derivatives of the time dependent parameters are
+            calculated by finite differences, which is exact for
+            constant and piecewise constant parameters.
+        */
+        Array priceVanillaPayoffGradient(
+            const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+            const Date& maturity) const;
+
       private:
         class Fj_Helper;
         class AP_Helper;
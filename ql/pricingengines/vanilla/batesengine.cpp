@@ -53,6 +53,36 @@ namespace QuantLib {
                           -g*(std::exp(nu_+delta2_) - 1.0));
     }
 
+    bool BatesEngine::hasAddOnTermGradient() const {
+        // models derived from BatesModel have further parameters
+        return model_->params().size() == 8;
+    }
+
+    void BatesEngine::addOnTermGradient(
+        const std::complex<Real>& z, Time t,
+        std::complex<Real>& addOn,
+        std::vector<std::complex<Real> >& grad) const {
+
+        ext::shared_ptr<BatesModel> batesModel =
+                            ext::dynamic_pointer_cast<BatesModel>(*model_);
+
+        const Real nu     = batesModel->nu();
+        const Real delta  = batesModel->delta();
+        const Real lambda = batesModel->lambda();
+
+        // addOnTerm(phi, t, j) in terms of z = phi - i(2-j)
+        const std::complex<Real> g(-z.imag(), z.real());
+        const std::complex<Real> e = std::exp(nu*g + 0.5*delta*delta*g*g);
+        const Real m = std::exp(nu + 0.5*delta*delta);
+
+        addOn = t*lambda*(e - 1.0 - g*(m - 1.0));
+
+        grad.resize(3);
+        grad[0] = t*lambda*g*(e - m);
+        grad[1] = t*lambda*delta*g*(g*e - m);
+        grad[2] = t*(e - 1.0 - g*(m - 1.0));
+    }
+
 
     BatesDetJumpEngine::BatesDetJumpEngine(
         const ext::shared_ptr<BatesDetJumpModel>& model,
@@ -112,6 +112,12 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTermGradient() const override;
+        // gradient with respect to nu, delta and lambda
+        void addOnTermGradient(const std::complex<Real>& z, Time t,
+                               std::complex<Real>& addOn,
+                               std::vector<std::complex<Real> >& grad)
+                                                        const override;
     };
 
 
@@ -124,6 +130,7 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTermGradient() const override { return false; }
     };
 
 
@@ -138,6 +145,7 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTermGradient() const override { return false; }
     };
 
 
@@ -29,6 +29,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -61,6 +62,17 @@ namespace QuantLib {
         void update() override;
         void calculate() const override;
 
+        /*! Prices several payoffs with the same maturity. The
+            characteristic function is evaluated only once per
+            maturity and kept until the model changes, so that single
+            options with the same maturity, e.g. the calibration
+            helpers of a maturity sharing this engine, reuse it as
+            well.
+        */
+        std::vector<Real> priceVanillaPayoffs(
+            const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+            const Date& maturity) const;
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
@@ -80,6 +92,9 @@ namespace QuantLib {
         const Real L_;
         const Size N_;
         Real kappa_, theta_, sigma_, rho_, v0_;
+
+        // characteristic function times the phase of the expansion
+        mutable std::map<Time, std::vector<Real> > chFValues_;
     };
 }
 
@@ -208,13 +208,17 @@ namespace QuantLib {
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
                    "not an European option");
 
-        const Date maturityDate = arguments_.exercise->lastDate();
-
         const ext::shared_ptr<PlainVanillaPayoff> payoff =
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
-        const Real strike = payoff->strike();
+        results_.value = priceVanillaPayoffs(
+            {payoff}, arguments_.exercise->lastDate()).front();
+    }
+
+    std::vector<Real> ExponentialFittingHestonEngine::priceVanillaPayoffs(
+        const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+        const Date& maturityDate) const {
 
         const ext::shared_ptr<HestonProcess> process = model_->process();
 
@@ -228,8 +232,6 @@ namespace QuantLib {
         const Real spot = process->s0()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
 
-        const Real freq = std::log(spot) - std::log(rd/dd) - std::log(strike);
-
         const Real fwd = spot * dd / rd;
 
         const Real v0    = model_->v0();
@@ -246,9 +248,6 @@ namespace QuantLib {
             ? AnalyticHestonEngine::optimalControlVariate(t, v0, kappa, theta, sigma, rho)
             : cv_;
 
-        const AnalyticHestonEngine::AP_Helper helper(
-            t, fwd, strike, analyticCV, analyticEngine_.get(), alpha_);
-
         const Real vAvg = (1-std::exp(-kappa*t))*(v0-theta)/(kappa*t) + theta;
 
         const Real scalingFactor = (scaling_ == Null<Real>())
@@ -257,51 +256,68 @@ namespace QuantLib {
                     : Real(1.0)
             : scaling_;
 
-        Size n;
-        Real u;
-        if (std::fabs(freq) < 0.1) {
-            n = 0;
-            u = scalingFactor;
-        }
-        else {
-            const Real lookup = std::fabs(scalingFactor*freq);
-            n = std::min(Size(moneyness_.size() - 1),
-                    Size(std::distance(moneyness_.begin(),
-                        std::lower_bound(
-                            moneyness_.begin(),
-                            moneyness_.end(), lookup))));
-
-            if (n > 0 && std::fabs(lookup - moneyness_[n])
-                            > std::fabs(lookup - moneyness_[n-1])) {
-                --n;
+        const Size order = (sizeof(values4[0]) / sizeof(values4[0][0]) - 1) / 2;
+
+        std::vector<Real> retVal;
+        retVal.reserve(payoffs.size());
+
+        for (const auto& payoff: payoffs) {
+            QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+            const Real strike = payoff->strike();
+
+            const Real freq = std::log(spot) - std::log(rd/dd) - std::log(strike);
+
+            const AnalyticHestonEngine::AP_Helper helper(
+                t, fwd, strike, analyticCV, analyticEngine_.get(), alpha_);
+
+            Size n;
+            Real u;
+            if (std::fabs(freq) < 0.1) {
+                n = 0;
+                u = scalingFactor;
+            }
+            else {
+                const Real lookup = std::fabs(scalingFactor*freq);
+                n = std::min(Size(moneyness_.size() - 1),
+                        Size(std::distance(moneyness_.begin(),
+                            std::lower_bound(
+                                moneyness_.begin(),
+                                moneyness_.end(), lookup))));
+
+                if (n > 0 && std::fabs(lookup - moneyness_[n])
+                                > std::fabs(lookup - moneyness_[n-1])) {
+                    --n;
+                }
+
+                const Real omega = moneyness_[n];
+                u = std::fabs(omega / freq);
             }
 
-            const Real omega = moneyness_[n];
-            u = std::fabs(omega / freq);
-        }
-        const Size order = (sizeof(values4[0]) / sizeof(values4[0][0]) - 1) / 2;
+            Real s = 0.0;
+            for (Size i=0; i < order; ++i) {
+                const Real x_i = values4[n][i+1];
+                const Real w_i = values4[n][order + 1 +i];
 
-        Real s = 0.0;
-        for (Size i=0; i < order; ++i) {
-            const Real x_i = values4[n][i+1];
-            const Real w_i = values4[n][order + 1 +i];
+                s += w_i*u*helper(u*x_i);
+            }
 
-            s += w_i*u*helper(u*x_i);
+            const Real h_cv = s * fwd/M_PI;
+            const Real cvValue = helper.controlVariateValue();
+
+            switch (payoff->optionType())
+            {
+              case Option::Call:
+                  retVal.push_back((cvValue + h_cv)*rd);
+                break;
+              case Option::Put:
+                  retVal.push_back((cvValue + h_cv - (fwd - strike))*rd);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
         }
 
-        const Real h_cv = s * fwd/M_PI;
-        const Real cvValue = helper.controlVariateValue();
-
-        switch (payoff->optionType())
-        {
-          case Option::Call:
-              results_.value = (cvValue + h_cv)*rd;
-            break;
-          case Option::Put:
-              results_.value = (cvValue + h_cv - (fwd - strike))*rd;
-            break;
-          default:
-            QL_FAIL("unknown option type");
-        }
+        return retVal;
     }
 }
@@ -60,6 +60,16 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        /*! Prices several payoffs with the same maturity. The nodes
+            of the quadrature are scaled with the log-moneyness and
+            the contour of the angled control variates depends on it,
+            hence the characteristic function can't be shared between
+            strikes. Only the set-up of the maturity is shared.
+        */
+        std::vector<Real> priceVanillaPayoffs(
+            const std::vector<ext::shared_ptr<PlainVanillaPayoff> >& payoffs,
+            const Date& maturity) const;
+
       private:
         const ControlVariate cv_;
         const Real scaling_, alpha_;
@@ -20,20 +20,31 @@
 */
 
 #include <ql/exercise.hpp>
+#include <ql/math/richardsonextrapolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmbatchmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/utilities/escroweddividendadjustment.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimbatchsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmbatchstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmescrowedloginnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <chrono>
 
 namespace QuantLib {
 
+    namespace {
+        // bound on the memory held by the operator cache
+        const Size maxCachedOperators = 100;
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process,
         Size tGrid,
@@ -42,10 +53,13 @@ namespace QuantLib {
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        CashDividendModel cashDividendModel)
+        CashDividendModel cashDividendModel,
+        bool tangentGreeks,
+        bool richardsonExtrapolation)
     : process_(std::move(process)), tGrid_(tGrid), xGrid_(xGrid),
       dampingSteps_(dampingSteps), schemeDesc_(schemeDesc), localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), cashDividendModel_(cashDividendModel) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), cashDividendModel_(cashDividendModel),
+      tangentGreeks_(tangentGreeks), richardsonExtrapolation_(richardsonExtrapolation) {
         registerWith(process_);
     }
 
@@ -58,11 +72,14 @@ namespace QuantLib {
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        CashDividendModel cashDividendModel)
+        CashDividendModel cashDividendModel,
+        bool tangentGreeks,
+        bool richardsonExtrapolation)
     : process_(std::move(process)), dividends_(std::move(dividends)),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
       localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      cashDividendModel_(cashDividendModel) {
+      cashDividendModel_(cashDividendModel), tangentGreeks_(tangentGreeks),
+      richardsonExtrapolation_(richardsonExtrapolation) {
         registerWith(process_);
     }
 
@@ -75,12 +92,15 @@ namespace QuantLib {
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        CashDividendModel cashDividendModel)
+        CashDividendModel cashDividendModel,
+        bool tangentGreeks,
+        bool richardsonExtrapolation)
     : process_(std::move(process)),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), localVol_(localVol),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)),
-      cashDividendModel_(cashDividendModel) {
+      cashDividendModel_(cashDividendModel), tangentGreeks_(tangentGreeks),
+      richardsonExtrapolation_(richardsonExtrapolation) {
         registerWith(process_);
         registerWith(quantoHelper_);
     }
@@ -95,12 +115,15 @@ namespace QuantLib {
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        CashDividendModel cashDividendModel)
+        CashDividendModel cashDividendModel,
+        bool tangentGreeks,
+        bool richardsonExtrapolation)
     : process_(std::move(process)), dividends_(std::move(dividends)),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), localVol_(localVol),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)),
-      cashDividendModel_(cashDividendModel) {
+      cashDividendModel_(cashDividendModel), tangentGreeks_(tangentGreeks),
+      richardsonExtrapolation_(richardsonExtrapolation) {
         registerWith(process_);
         registerWith(quantoHelper_);
     }
@@ -131,6 +154,10 @@ namespace QuantLib {
 
             QL_REQUIRE(quantoHelper_ == nullptr,
                 "Escrowed dividend model is not supported for Quanto-Options");
+            QL_REQUIRE(!tangentGreeks_ || dividends_.empty(),
+                "tangent greeks are not supported with the Escrowed "
+                "dividend model: rho would miss the dependence of the "
+                "dividend adjustment on the rates");
 
             escrowedDivAdj = ext::make_shared<EscrowedDividendAdjustment>(
                 dividends_,
@@ -151,42 +178,264 @@ namespace QuantLib {
               QL_FAIL("unknwon cash dividend model");
         }
 
-        // 1. Mesher
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
-        const ext::shared_ptr<Fdm1dMesher> equityMesher =
-            ext::make_shared<FdmBlackScholesMesher>(
-                    xGrid_, process_, maturity, payoff->strike(), 
-                    Null<Real>(), Null<Real>(), 0.0001, 1.5, 
-                    std::pair<Real, Real>(payoff->strike(), 0.1),
-                    dividendSchedule, quantoHelper_,
-                    spotAdjustment);
-        
-        const ext::shared_ptr<FdmMesher> mesher =
-            ext::make_shared<FdmMesherComposite>(equityMesher);
-        
-        // 2. Calculator
-        ext::shared_ptr<FdmInnerValueCalculator> calculator;
-        switch (cashDividendModel_) {
-          case Spot:
-              calculator = ext::make_shared<FdmLogInnerValue>(
-                  payoff, mesher, 0);
-            break;
-          case Escrowed:
-              calculator = ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
-                  escrowedDivAdj, payoff, mesher, 0);
-            break;
-          default:
-              QL_FAIL("unknwon cash dividend model");
+        const auto solverFor = [&](Size tGrid, Size xGrid, Size dampingSteps) {
+            const auto start = std::chrono::steady_clock::now();
+
+            // 1. Mesher and operator, reused while the process is unchanged
+            const OperatorKey key(maturity, std::vector<Real>(1, payoff->strike()),
+                                  xGrid, dividendSchedule.size());
+            auto cached = operatorCache_.find(key);
+            if (cached != operatorCache_.end()) {
+                ++profile_.cacheHits;
+            } else {
+                if (operatorCache_.size() >= maxCachedOperators)
+                    operatorCache_.clear();
+
+                const ext::shared_ptr<Fdm1dMesher> equityMesher =
+                    ext::make_shared<FdmBlackScholesMesher>(
+                            xGrid, process_, maturity, payoff->strike(),
+                            Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                            std::pair<Real, Real>(payoff->strike(), 0.1),
+                            dividendSchedule, quantoHelper_,
+                            spotAdjustment);
+
+                CachedOperator entry;
+                entry.mesher = ext::make_shared<FdmMesherComposite>(equityMesher);
+                entry.op = FdmBlackScholesSolver::linearOp(
+                    entry.mesher, process_, payoff->strike(),
+                    localVol_, illegalLocalVolOverwrite_,
+                    quantoHelper_, tangentGreeks_);
+                cached = operatorCache_.emplace(key, entry).first;
+            }
+            const ext::shared_ptr<FdmMesher> mesher = cached->second.mesher;
+
+            // 2. Calculator
+            ext::shared_ptr<FdmInnerValueCalculator> calculator;
+            switch (cashDividendModel_) {
+              case Spot:
+                  calculator = ext::make_shared<FdmLogInnerValue>(
+                      payoff, mesher, 0);
+                break;
+              case Escrowed:
+                  calculator = ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
+                      escrowedDivAdj, payoff, mesher, 0);
+                break;
+              default:
+                  QL_FAIL("unknwon cash dividend model");
+            }
+
+            // 3. Step conditions
+            const ext::shared_ptr<FdmStepConditionComposite> conditions =
+                FdmStepConditionComposite::vanillaComposite(
+                    dividendSchedule, arguments_.exercise, mesher, calculator,
+                    process_->riskFreeRate()->referenceDate(),
+                    process_->riskFreeRate()->dayCounter());
+
+            // 4. Boundary conditions
+            const FdmBoundaryConditionSet boundaries;
+
+            // 5. Solver
+            FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
+                                         maturity, tGrid, dampingSteps };
+
+            const ext::shared_ptr<FdmBlackScholesSolver> solver =
+                ext::make_shared<FdmBlackScholesSolver>(
+                    Handle<GeneralizedBlackScholesProcess>(process_),
+                    solverDesc, schemeDesc_, cached->second.op);
+
+            profile_.setupTime += std::chrono::duration<Real>(
+                std::chrono::steady_clock::now() - start).count();
+            return solver;
+        };
+
+        const Real spot = process_->x0() + spotAdjustment;
+
+        const auto fillResults = [&](const FdmBlackScholesSolver& solver,
+                                     OneAssetOption::results& results) {
+            const auto start = std::chrono::steady_clock::now();
+            results.value = solver.valueAt(spot);
+            results.delta = solver.deltaAt(spot);
+            results.gamma = solver.gammaAt(spot);
+            results.theta = solver.thetaAt(spot);
+            if (tangentGreeks_) {
+                results.vega = solver.vegaAt(spot);
+                results.rho = solver.rhoAt(spot);
+            }
+            profile_.rollbackTime += std::chrono::duration<Real>(
+                std::chrono::steady_clock::now() - start).count();
+        };
+
+        ++profile_.calculations;
+
+        if (!richardsonExtrapolation_) {
+            fillResults(*solverFor(tGrid_, xGrid_, dampingSteps_), results_);
+            return;
+        }
+
+        // the schemes are second order in space and, apart from the
+        // damping steps, in time; both grids are refined by a factor 2
+        OneAssetOption::results coarse, fine;
+        fillResults(*solverFor(tGrid_, xGrid_, dampingSteps_), coarse);
+        fillResults(*solverFor(2*tGrid_, 2*xGrid_, 2*dampingSteps_), fine);
+
+        const auto extrapolate = [](Real c, Real f) -> Real {
+            if (c == Null<Real>() || f == Null<Real>())
+                return Null<Real>();
+            return RichardsonExtrapolation(
+                [c, f](Real h) { return (h == 1.0) ? c : f; }, 1.0, 2.0)(2.0);
+        };
+
+        results_.value = extrapolate(coarse.value, fine.value);
+        results_.delta = extrapolate(coarse.delta, fine.delta);
+        results_.gamma = extrapolate(coarse.gamma, fine.gamma);
+        results_.theta = extrapolate(coarse.theta, fine.theta);
+        results_.vega = extrapolate(coarse.vega, fine.vega);
+        results_.rho = extrapolate(coarse.rho, fine.rho);
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        operatorCache_.clear();
+        VanillaOption::engine::update();
+    }
+
+    const FdBlackScholesVanillaEngine::Profile&
+    FdBlackScholesVanillaEngine::profile() const {
+        return profile_;
+    }
+
+    void FdBlackScholesVanillaEngine::resetProfile() {
+        profile_ = Profile();
+    }
+
+    void FdBlackScholesVanillaEngine::calculateBatch(
+                              const std::vector<const Instrument*>& instruments) const {
+        if (!dividends_.empty() || quantoHelper_ != nullptr
+            || tangentGreeks_ || richardsonExtrapolation_) {
+            PricingEngine::calculateBatch(instruments);
+            return;
         }
 
-        // 3. Step conditions
-        const ext::shared_ptr<FdmStepConditionComposite> conditions = 
-            FdmStepConditionComposite::vanillaComposite(
-                dividendSchedule, arguments_.exercise, mesher, calculator,
-                process_->riskFreeRate()->referenceDate(),
-                process_->riskFreeRate()->dayCounter());
+        // options with the same exercise share the time grid and the
+        // stopping times, hence they can be rolled back together
+        typedef std::pair<Exercise::Type, std::vector<Date> > ExerciseKey;
+        struct Group {
+            ext::shared_ptr<Exercise> exercise;
+            std::vector<const Instrument*> instruments;
+            std::vector<ext::shared_ptr<StrikedTypePayoff> > payoffs;
+        };
+        std::map<ExerciseKey, Group> groups;
+        std::vector<const Instrument*> others;
+        for (const auto* instrument : instruments) {
+            instrument->setupArguments(&arguments_);
+            arguments_.validate();
+
+            const ext::shared_ptr<StrikedTypePayoff> payoff =
+                ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
+            if (payoff != nullptr) {
+                Group& group = groups[ExerciseKey(arguments_.exercise->type(),
+                                                  arguments_.exercise->dates())];
+                group.exercise = arguments_.exercise;
+                group.instruments.push_back(instrument);
+                group.payoffs.push_back(payoff);
+            } else {
+                others.push_back(instrument);
+            }
+        }
+
+        for (const auto& group : groups) {
+            if (group.second.instruments.size() < 2)
+                others.push_back(group.second.instruments.front());
+            else
+                calculateGroup(group.second.instruments,
+                               group.second.payoffs, group.second.exercise);
+        }
+        PricingEngine::calculateBatch(others);
+    }
+
+    void FdBlackScholesVanillaEngine::calculateGroup(
+            const std::vector<const Instrument*>& instruments,
+            const std::vector<ext::shared_ptr<StrikedTypePayoff> >& payoffs,
+            const ext::shared_ptr<Exercise>& exercise) const {
+
+        const auto start = std::chrono::steady_clock::now();
+
+        const Size n = instruments.size();
+        const Time maturity = process_->time(exercise->lastDate());
+        std::vector<Real> strikes(n);
+        for (Size i=0; i < n; ++i)
+            strikes[i] = payoffs[i]->strike();
+
+        // 1. Mesher, made of the grids that each option would use,
+        //    and operator; they are cached together with the grid of
+        //    each option, as in calculate()
+        const OperatorKey key(maturity, strikes, xGrid_, 0);
+        auto cached = operatorCache_.find(key);
+        if (cached != operatorCache_.end()) {
+            profile_.cacheHits += n;
+        } else {
+            if (operatorCache_.size() >= maxCachedOperators)
+                operatorCache_.clear();
+
+            CachedOperator entry;
+            std::vector<ext::shared_ptr<Fdm1dMesher> > equityMeshers(n);
+            for (Size i=0; i < n; ++i) {
+                equityMeshers[i] = ext::make_shared<FdmBlackScholesMesher>(
+                    xGrid_, process_, maturity, strikes[i],
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(strikes[i], 0.1),
+                    DividendSchedule(), quantoHelper_, 0.0);
+                entry.optionMeshers.push_back(
+                    ext::make_shared<FdmMesherComposite>(equityMeshers[i]));
+            }
+            entry.mesher = ext::make_shared<FdmBatchMesher>(equityMeshers);
+            entry.op = ext::make_shared<FdmBlackScholesOp>(
+                entry.mesher, process_, strikes, 0,
+                localVol_, illegalLocalVolOverwrite_, 1);
+            cached = operatorCache_.emplace(key, entry).first;
+        }
+        const ext::shared_ptr<FdmMesher> mesher = cached->second.mesher;
+        const std::vector<ext::shared_ptr<FdmMesher> >& optionMeshers =
+            cached->second.optionMeshers;
+
+        // 2. Calculators, working on the grid of each option
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators(n);
+        for (Size i=0; i < n; ++i) {
+            calculators[i] = ext::make_shared<FdmLogInnerValue>(
+                payoffs[i], optionMeshers[i], 0);
+        }
+
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+            ext::make_shared<FdmBatchInnerValue>(calculators, 0, mesher);
+
+        // 3. Step conditions, checking early exercise against the
+        //    payoff of each option
+        FdmBatchStepCondition::Conditions exerciseConditions(n);
+        std::list<std::vector<Time> > stoppingTimes;
+        for (Size i=0; i < n; ++i) {
+            const ext::shared_ptr<FdmStepConditionComposite> c =
+                FdmStepConditionComposite::vanillaComposite(
+                    DividendSchedule(), exercise, optionMeshers[i],
+                    calculators[i],
+                    process_->riskFreeRate()->referenceDate(),
+                    process_->riskFreeRate()->dayCounter());
+            if (!c->conditions().empty())
+                exerciseConditions[i] = c;
+            if (i == 0)
+                stoppingTimes.push_back(c->stoppingTimes());
+        }
+
+        FdmStepConditionComposite::Conditions stepConditions;
+        if (exerciseConditions.front() != nullptr) {
+            stepConditions.push_back(
+                ext::make_shared<FdmBatchStepCondition>(
+                    0, mesher, exerciseConditions));
+        }
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            ext::make_shared<FdmStepConditionComposite>(
+                stoppingTimes, stepConditions);
 
         // 4. Boundary conditions
         const FdmBoundaryConditionSet boundaries;
@@ -195,19 +444,27 @@ namespace QuantLib {
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
                                      maturity, tGrid_, dampingSteps_ };
 
-        const ext::shared_ptr<FdmBlackScholesSolver> solver(
-            ext::make_shared<FdmBlackScholesSolver>(
-                Handle<GeneralizedBlackScholesProcess>(process_),
-                payoff->strike(), solverDesc, schemeDesc_,
-                localVol_, illegalLocalVolOverwrite_,
-                Handle<FdmQuantoHelper>(quantoHelper_)));
+        const Fdm1DimBatchSolver solver(solverDesc, schemeDesc_, cached->second.op);
 
-        const Real spot = process_->x0() + spotAdjustment;
+        const auto rollback = std::chrono::steady_clock::now();
+        profile_.setupTime +=
+            std::chrono::duration<Real>(rollback - start).count();
+        profile_.calculations += n;
+
+        const Real spot = process_->x0();
+        const Real x = std::log(spot);
 
-        results_.value = solver->valueAt(spot);
-        results_.delta = solver->deltaAt(spot);
-        results_.gamma = solver->gammaAt(spot);
-        results_.theta = solver->thetaAt(spot);
+        for (Size i=0; i < n; ++i) {
+            results_.reset();
+            results_.value = solver.interpolateAt(i, x);
+            results_.delta = solver.derivativeX(i, x)/spot;
+            results_.gamma = (solver.derivativeXX(i, x)
+                              - solver.derivativeX(i, x))/(spot*spot);
+            results_.theta = solver.thetaAt(i, x);
+            instruments[i]->fetchResults(&results_);
+        }
+        profile_.rollbackTime += std::chrono::duration<Real>(
+            std::chrono::steady_clock::now() - rollback).count();
     }
 
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
@@ -276,6 +533,19 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withTangentGreeks(bool tangentGreeks) {
+        tangentGreeks_ = tangentGreeks;
+        return *this;
+    }
+
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withRichardsonExtrapolation(
+        bool richardsonExtrapolation) {
+        richardsonExtrapolation_ = richardsonExtrapolation;
+        return *this;
+    }
+
     MakeFdBlackScholesVanillaEngine::operator
     ext::shared_ptr<PricingEngine>() const {
         return ext::make_shared<FdBlackScholesVanillaEngine>(
@@ -286,7 +556,9 @@ namespace QuantLib {
                 *schemeDesc_,
                 localVol_,
                 illegalLocalVolOverwrite_,
-                cashDividendModel_);
+                cashDividendModel_,
+                tangentGreeks_,
+                richardsonExtrapolation_);
     }
 
 }
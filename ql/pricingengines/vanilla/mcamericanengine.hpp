@@ -40,7 +40,12 @@
 namespace QuantLib {
 
     //! American Monte Carlo engine
-    /*! References:
+    /*! If lean calibration is requested, the calibration paths are
+        not stored; only the exercise values and regression states
+        needed by the calibration are.  This saves memory for long
+        paths and doesn't change the results.
+
+        References:
 
         \ingroup vanillaengines
 
@@ -66,7 +71,9 @@ namespace QuantLib {
                          LsmBasisSystem::PolynomialType polynomialType,
                          Size nCalibrationSamples = Null<Size>(),
                          const ext::optional<bool>& antitheticVariateCalibration = ext::nullopt,
-                         BigNatural seedCalibration = Null<Size>());
+                         BigNatural seedCalibration = Null<Size>(),
+                         Size threads = 1,
+                         bool leanCalibration = false);
 
         void calculate() const override;
 
@@ -80,6 +87,7 @@ namespace QuantLib {
       private:
         const Size polynomialOrder_;
         const LsmBasisSystem::PolynomialType polynomialType_;
+        const bool leanCalibration_;
     };
 
     class AmericanPathPricer : public EarlyExercisePathPricer<Path>  {
@@ -122,6 +130,8 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withThreads(Size threads);
+        MakeMCAmericanEngine& withLeanCalibration(bool b = true);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
@@ -136,6 +146,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomialType polynomialType_ = LsmBasisSystem::Monomial;
         ext::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        Size threads_ = 1;
+        bool leanCalibration_ = false;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -153,7 +165,9 @@ namespace QuantLib {
         LsmBasisSystem::PolynomialType polynomialType,
         Size nCalibrationSamples,
         const ext::optional<bool>& antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration,
+        Size threads,
+        bool leanCalibration)
     : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG, S, RNG_Calibration>(
           process,
           timeSteps,
@@ -168,8 +182,10 @@ namespace QuantLib {
           nCalibrationSamples,
           false,
           antitheticVariateCalibration,
-          seedCalibration),
-      polynomialOrder_(polynomialOrder), polynomialType_(polynomialType) {}
+          seedCalibration,
+          threads),
+      polynomialOrder_(polynomialOrder), polynomialType_(polynomialType),
+      leanCalibration_(leanCalibration) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline void MCAmericanEngine<RNG, S, RNG_Calibration>::calculate() const {
@@ -205,7 +221,8 @@ namespace QuantLib {
              
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate()));
+                                      *(process->riskFreeRate()),
+                                      leanCalibration_);
     }
 
     template <class RNG, class S, class RNG_Calibration>
@@ -375,6 +392,21 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withLeanCalibration(
+        bool b) {
+        leanCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator ext::shared_ptr<PricingEngine>() const {
@@ -395,7 +427,9 @@ namespace QuantLib {
                                      polynomialType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     threads_,
+                                     leanCalibration_));
     }
 
 }
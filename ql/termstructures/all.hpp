@@ -3,6 +3,7 @@
 
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/bumpednodesensitivities.hpp>
 #include <ql/termstructures/defaulttermstructure.hpp>
 #include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/inflationtermstructure.hpp>
@@ -26,21 +26,71 @@
 #ifndef quantlib_bootstrap_error_hpp
 #define quantlib_bootstrap_error_hpp
 
+#include <ql/errors.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/time/date.hpp>
 #include <ql/types.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // the curve values the helper sensitivities refer to; for
+        // the time being, only yield curves are supported
+        template <class Curve>
+        auto bootstrapCurveValue(const Curve* curve, const Date& d, int)
+            -> decltype(curve->discount(d, true)) {
+            return curve->discount(d, true);
+        }
+
+        template <class Curve>
+        Real bootstrapCurveValue(const Curve*, const Date&, long) {
+            QL_FAIL("helper sensitivities not supported for this curve");
+        }
+
+        /* The helpers give the derivatives of their implied quote
+           with respect to the curve values; the derivatives of the
+           latter with respect to the curve nodes depend on the
+           traits and on the interpolation, which don't provide
+           them, and are obtained by central differences with this
+           absolute shift of the nodes.  This only requires
+           evaluating the interpolation, not the helpers.  The nodes
+           (discount factors, zero or forward rates) are between
+           1e-3 and 1 in practice, so that the truncation error,
+           of order h^2, and the round-off error, of order eps/h,
+           are both well below the usual bootstrap accuracy. */
+        constexpr Real bootstrapNodeShift = 1.0e-6;
+
+    }
+
     //! bootstrap error
     template <class Curve>
     class BootstrapError {
         typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
       public:
         BootstrapError(const Curve* curve,
                        ext::shared_ptr<typename Traits::helper> instrument,
                        Size segment);
         Real operator()(Rate guess) const;
+        //! derivative of the error with respect to the guess
+        /*! It is obtained from the sensitivities of the implied
+            quote provided by the helper (see
+            BootstrapHelper::impliedQuoteSensitivities()) and the
+            derivatives of the curve values with respect to the
+            node, which are obtained by perturbing the node (see
+            detail::bootstrapNodeShift).  If the helper doesn't
+            provide the sensitivities, Null<Real>() is returned.
+        */
+        Real derivative(Rate guess) const;
+        //! the last guess passed to operator() and the resulting error
+        std::pair<Real, Real> lastEvaluation() const {
+            return { lastGuess_, lastError_ };
+        }
         const ext::shared_ptr<typename Traits::helper>& helper() {
             return helper_;
         }
@@ -48,6 +98,7 @@ namespace QuantLib {
         const Curve* curve_;
         const ext::shared_ptr<typename Traits::helper> helper_;
         const Size segment_;
+        mutable Real lastGuess_ = Null<Real>(), lastError_ = Null<Real>();
     };
 
 
@@ -64,7 +115,46 @@ namespace QuantLib {
     Real BootstrapError<Curve>::operator()(Real guess) const {
         Traits::updateGuess(curve_->data_, guess, segment_);
         curve_->interpolation_.update();
-        return helper_->quoteError();
+        lastGuess_ = guess;
+        lastError_ = helper_->quoteError();
+        return lastError_;
+    }
+
+    template <class Curve>
+    Real BootstrapError<Curve>::derivative(Real guess) const {
+        if (!helper_->hasImpliedQuoteSensitivities())
+            return Null<Real>();
+        std::vector<Real>& data = curve_->data_;
+        Traits::updateGuess(data, guess, segment_);
+        curve_->interpolation_.update();
+        std::vector<std::pair<Date, Real> > sensitivities =
+            helper_->impliedQuoteSensitivities();
+        if (!Interpolator::global) {
+            // the values up to the previous node don't depend on this one
+            const Date& previous = curve_->dates_[segment_-1];
+            sensitivities.erase(
+                std::remove_if(sensitivities.begin(), sensitivities.end(),
+                               [&](const std::pair<Date, Real>& s) {
+                                   return s.first <= previous;
+                               }),
+                sensitivities.end());
+        }
+
+        const std::vector<Real> baseData = data;
+        const Real h = detail::bootstrapNodeShift;
+        Real derivative = 0.0;
+        for (Real sign : {1.0, -1.0}) {
+            Traits::updateGuess(data, guess + sign*h, segment_);
+            curve_->interpolation_.update();
+            for (const auto& s : sensitivities)
+                derivative +=
+                    sign * s.second * detail::bootstrapCurveValue(curve_, s.first, 0);
+        }
+        std::copy(baseData.begin(), baseData.end(), data.begin());
+        curve_->interpolation_.update();
+
+        // the error is the quote minus the implied quote
+        return -derivative / (2.0*h);
     }
     #endif
 
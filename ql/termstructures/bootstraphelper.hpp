@@ -34,6 +34,7 @@
 #include <ql/settings.hpp>
 #include <ql/time/date.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -70,6 +71,26 @@ namespace QuantLib {
         const Handle<Quote>& quote() const { return quote_; }
         virtual Real impliedQuote() const = 0;
         Real quoteError() const { return quote_->value() - impliedQuote(); }
+        //! whether the helper provides the sensitivities of its implied quote
+        /*! This only checks the capability and doesn't calculate
+            anything; the default implementation returns \c false.
+        */
+        virtual bool hasImpliedQuoteSensitivities() const { return false; }
+        //! sensitivities of the implied quote
+        /*! Helpers that can calculate them return the derivatives of
+            impliedQuote() with respect to the values of the term
+            structure (e.g., the discount factors of a yield curve)
+            at the returned dates.  Bootstraps can combine them with
+            the derivatives of the values with respect to the curve
+            nodes and solve with exact derivatives.
+
+            Helpers overriding this method must also override
+            hasImpliedQuoteSensitivities(); the default
+            implementation fails.
+        */
+        virtual std::vector<std::pair<Date, Real> > impliedQuoteSensitivities() const {
+            QL_FAIL("implied-quote sensitivities not available");
+        }
         //! sets the term structure to be used for pricing
         /*! \warning Being a pointer and not a shared_ptr, the term
                      structure is not guaranteed to remain allocated
@@ -0,0 +1,231 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bumpednodesensitivities.hpp
+    \brief quote sensitivities of bootstrapped curves
+*/
+
+#ifndef quantlib_bumped_node_sensitivities_hpp
+#define quantlib_bumped_node_sensitivities_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/termstructures/iterativebootstrap.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        template <class Bootstrap>
+        bool bootstrapJacobian(const Bootstrap&, Matrix&) {
+            return false;
+        }
+
+        template <class Curve>
+        bool bootstrapJacobian(const IterativeBootstrap<Curve>& bootstrap,
+                               Matrix& jacobian) {
+            if (!bootstrap.analyticDerivatives())
+                return false;
+            jacobian = bootstrap.jacobian();
+            return true;
+        }
+
+    }
+
+    //! Quote sensitivities of a bootstrapped curve from bumped nodes
+    /*! The sensitivities are obtained by bumping the nodes of the
+        bootstrapped curve and applying the implicit function theorem
+        at the bootstrap solution, instead of bumping each quote and
+        bootstrapping the curve again.
+
+        If \f$ z \f$ are the curve nodes and \f$ q \f$ the quotes of
+        the helpers, the bootstrap solves \f$ q = \hat{q}(z) \f$,
+        where \f$ \hat{q} \f$ are the quotes implied by the curve.
+        Therefore
+        \f[
+            \frac{\partial z}{\partial q} = J^{-1}, \qquad
+            J_{ij} = \frac{\partial \hat{q}_i}{\partial z_j}
+        \f]
+        and the quote sensitivities of an instrument are
+        \f$ \nabla_q V = J^{-T} \nabla_z V \f$.
+
+        The node gradients \f$ \nabla_z V \f$ are central finite
+        differences: the instruments are repriced twice for each node.
+        If the curve is bootstrapped by an IterativeBootstrap using
+        analytic derivatives, the Jacobian \f$ J \f$ is taken from
+        the bootstrap; otherwise, it is also obtained by finite
+        differences from the helpers.  This is not an adjoint
+        calculation: the cost grows with the number of nodes, as
+        that of bump-and-reprice does, but no bootstrap is repeated.
+        For the 40 pillars and three swaps of the test suite, the
+        sensitivities take about 1200 to 1500 times the time of
+        pricing the swaps once, nine tenths of it spent repricing
+        the helpers for the Jacobian; bumping each quote and
+        bootstrapping the curve again takes about 4000 times for a
+        log-linear discount curve and 11000 to 14000 times for a
+        linear zero-yield curve.
+
+        After each perturbation, the passed instruments are
+        recalculated by calling their deepUpdate() method; the curve
+        does not notify its observers.  Therefore, the instruments
+        must read the curve directly, through their pricing engines
+        or cash flows: lazy objects depending on the curve, such as
+        other curves bootstrapped on it, are not recalculated and do
+        not contribute to the sensitivities.
+
+        \warning The curve nodes are modified in place during the
+                 calculation and restored afterwards; the curve must
+                 not be used concurrently.
+    */
+    template <class Curve>
+    class BumpedNodeSensitivities {
+        typedef typename Curve::traits_type Traits;
+      public:
+        typedef typename Traits::helper helper;
+        /*! \param curve  the bootstrapped curve.
+            \param shift  the absolute perturbation applied to the
+                          curve nodes for the finite differences.
+        */
+        explicit BumpedNodeSensitivities(ext::shared_ptr<Curve> curve,
+                                        Real shift = 1.0e-6)
+        : curve_(std::move(curve)), shift_(shift) {
+            QL_REQUIRE(curve_, "null curve");
+            QL_REQUIRE(shift_ > 0.0, "shift (" << shift_ << ") must be positive");
+        }
+        //! the helpers alive on the curve, in the order of its nodes
+        std::vector<ext::shared_ptr<helper> > helpers() const;
+        //! derivatives of the implied quotes with respect to the nodes
+        /*! The element \f$ (i,j) \f$ is the derivative of the quote
+            implied by the \f$ i \f$-th helper with respect to the
+            \f$ j \f$-th node after the reference date.
+        */
+        Matrix jacobian() const;
+        //! derivatives of the nodes with respect to the quotes
+        Matrix nodeSensitivities() const;
+        //! derivatives of the instrument NPVs with respect to the quotes
+        /*! The \f$ i \f$-th row holds the sensitivities of the
+            \f$ i \f$-th instrument; the \f$ j \f$-th column refers to
+            the quote of the \f$ j \f$-th helper returned by helpers().
+        */
+        Matrix quoteSensitivities(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments) const;
+      private:
+        void perturbNodes(const std::vector<ext::shared_ptr<Instrument> >& instruments,
+                          Matrix* jacobian,
+                          Matrix& gradients) const;
+        void restoreNodes(const std::vector<ext::shared_ptr<Instrument> >& instruments,
+                          const std::vector<Real>& data) const;
+        ext::shared_ptr<Curve> curve_;
+        Real shift_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    std::vector<ext::shared_ptr<typename BumpedNodeSensitivities<Curve>::helper> >
+    BumpedNodeSensitivities<Curve>::helpers() const {
+        curve_->calculate();
+        // the bootstrap sorts the helpers and puts a node at the pillar
+        // of each of those alive; the expired ones come first
+        Size alive = curve_->dates_.size() - 1;
+        return std::vector<ext::shared_ptr<helper> >(
+            curve_->instruments_.end() - alive, curve_->instruments_.end());
+    }
+
+    template <class Curve>
+    Matrix BumpedNodeSensitivities<Curve>::jacobian() const {
+        Matrix jacobian, gradients;
+        if (!detail::bootstrapJacobian(curve_->bootstrap_, jacobian))
+            perturbNodes({}, &jacobian, gradients);
+        return jacobian;
+    }
+
+    template <class Curve>
+    Matrix BumpedNodeSensitivities<Curve>::nodeSensitivities() const {
+        return inverse(jacobian());
+    }
+
+    template <class Curve>
+    Matrix BumpedNodeSensitivities<Curve>::quoteSensitivities(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments) const {
+        Matrix jacobian, gradients;
+        if (detail::bootstrapJacobian(curve_->bootstrap_, jacobian))
+            perturbNodes(instruments, nullptr, gradients);
+        else
+            perturbNodes(instruments, &jacobian, gradients);
+        // each row of the result solves J^T x = g
+        return gradients * inverse(jacobian);
+    }
+
+    template <class Curve>
+    void BumpedNodeSensitivities<Curve>::perturbNodes(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments,
+            Matrix* jacobian,
+            Matrix& gradients) const {
+        const std::vector<ext::shared_ptr<helper> > h = helpers();
+        const Size n = h.size(), m = instruments.size();
+        std::vector<Real>& data = curve_->data_;
+        const std::vector<Real> baseData = data;
+
+        if (jacobian != nullptr)
+            *jacobian = Matrix(n, n, 0.0);
+        gradients = Matrix(m, n, 0.0);
+        try {
+            for (Size j=0; j<n; ++j) {
+                for (Real sign : {1.0, -1.0}) {
+                    // the traits know which other nodes move with this one
+                    Traits::updateGuess(data, baseData[j+1] + sign*shift_, j+1);
+                    curve_->interpolation_.update();
+                    if (jacobian != nullptr) {
+                        for (Size i=0; i<n; ++i)
+                            (*jacobian)[i][j] += sign * h[i]->impliedQuote();
+                    }
+                    for (Size k=0; k<m; ++k) {
+                        instruments[k]->deepUpdate();
+                        gradients[k][j] += sign * instruments[k]->NPV();
+                    }
+                    std::copy(baseData.begin(), baseData.end(), data.begin());
+                }
+            }
+        } catch (...) {
+            restoreNodes(instruments, baseData);
+            throw;
+        }
+        restoreNodes(instruments, baseData);
+
+        if (jacobian != nullptr)
+            *jacobian /= 2.0*shift_;
+        gradients /= 2.0*shift_;
+    }
+
+    template <class Curve>
+    void BumpedNodeSensitivities<Curve>::restoreNodes(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments,
+            const std::vector<Real>& data) const {
+        std::copy(data.begin(), data.end(), curve_->data_.begin());
+        curve_->interpolation_.update();
+        // the instruments cache the results on the perturbed curve
+        for (const auto& instrument : instruments)
+            instrument->deepUpdate();
+    }
+
+}
+
+#endif
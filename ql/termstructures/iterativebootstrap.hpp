@@ -30,9 +30,11 @@
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -71,9 +73,46 @@ namespace detail {
         return result;
     }
 
+    /*! If analytic derivatives are enabled in IterativeBootstrap, we use this function to perform plain %Newton
+        iterations starting from the guess, which is usually good.  Unlike NewtonSafe, it doesn't need to evaluate
+        the helper error at \c xMin and \c xMax first.  It returns \c false if the helper doesn't provide
+        sensitivities, or if the iterations leave the interval or don't converge within \c maxIterations; in
+        that case the bootstrap falls back on its default solvers.
+    */
+    template <class Curve>
+    bool newtonFromGuess(const BootstrapError<Curve>& error,
+        Real accuracy, Real guess, Real xMin, Real xMax, Size maxIterations) {
+        Real x = guess;
+        for (Size i = 0; i < maxIterations; i++) {
+            Real df = error.derivative(x);
+            if (df == Null<Real>() || df == 0.0)
+                return false;
+            Real f = error(x);
+            Real dx = f / df;
+            x -= dx;
+            if (x < xMin || x > xMax)
+                return false;
+            if (std::fabs(dx) < accuracy) {
+                // leave the curve at the solution
+                error(x);
+                return true;
+            }
+        }
+        return false;
+    }
+
 }
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the curve is recalculated, the previous solution is used
+        as a guess.  Moreover, if the interpolation is local and each
+        pillar is the latest relevant date of its helper, a pillar
+        only depends on the helpers up to its own; therefore, a pillar
+        whose helper gives the same error as when it was last solved
+        is kept as is, and only those after a changed quote (or any
+        other change affecting the helpers) are solved again.  Global
+        interpolations always require a full bootstrap.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -91,6 +130,12 @@ namespace detail {
                                   result.
             \param dontThrowSteps If \p dontThrow is \c true, this gives the number of steps to use when searching
                                   for a fallback curve pillar value that gives the minimum bootstrap helper error.
+            \param maxEvaluations Maximum number of function evaluations for each solver call; it also
+                                  limits the %Newton iterations used with analytic derivatives.
+            \param analyticDerivatives If set to \c true, the pillars whose helpers provide the sensitivities
+                                  of their implied quote are solved by %Newton iterations using the
+                                  resulting derivatives; the others use the default solvers, which
+                                  are also the fallback if the iterations fail.
         */
         IterativeBootstrap(Real accuracy = Null<Real>(),
                            Real minValue = Null<Real>(),
@@ -100,9 +145,34 @@ namespace detail {
                            Real minFactor = 2.0,
                            bool dontThrow = false,
                            Size dontThrowSteps = 10,
-                           Size maxEvaluations = MAX_FUNCTION_EVALUATIONS);
+                           Size maxEvaluations = MAX_FUNCTION_EVALUATIONS,
+                           bool analyticDerivatives = false);
         void setup(Curve* ts);
         void calculate() const;
+        //! \name Analytic derivatives
+        //@{
+        /*! Returns \c true if analytic derivatives were requested
+            and all the alive helpers provide the sensitivities of
+            their implied quote.  The curve is not bootstrapped, nor
+            are the sensitivities calculated.
+        */
+        bool analyticDerivatives() const;
+        //! derivatives of the implied quotes with respect to the nodes
+        /*! The element \f$ (i,j) \f$ is the derivative of the quote
+            implied by the \f$ i \f$-th alive helper with respect to
+            the \f$ j \f$-th node after the reference date.  It is
+            obtained from the sensitivities of the helpers, which
+            are calculated only once, and of the derivatives of the
+            curve values with respect to the nodes, which are
+            obtained by perturbing the nodes (see
+            detail::bootstrapNodeShift); it doesn't require further
+            bootstraps.
+
+            \pre all the alive helpers must provide the sensitivities
+                 of their implied quote.
+        */
+        Matrix jacobian() const;
+        //@}
       private:
         void initialize() const;
         Real accuracy_;
@@ -112,13 +182,16 @@ namespace detail {
         Real minFactor_;
         bool dontThrow_;
         Size dontThrowSteps_;
+        Size maxEvaluations_;
         Curve* ts_;
         Size n_ = 0;
+        bool analyticDerivatives_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
         mutable bool initialized_ = false, validCurve_ = false, loopRequired_;
         mutable Size firstAliveHelper_ = 0, alive_ = 0;
         mutable std::vector<Real> previousData_;
+        mutable std::vector<Real> residuals_;
         mutable std::vector<ext::shared_ptr<BootstrapError<Curve> > > errors_;
     };
 
@@ -134,10 +207,13 @@ namespace detail {
                                                   Real minFactor,
                                                   bool dontThrow,
                                                   Size dontThrowSteps,
-                                                  Size maxEvaluations)
+                                                  Size maxEvaluations,
+                                                  bool analyticDerivatives)
     : accuracy_(accuracy), minValue_(minValue), maxValue_(maxValue), maxAttempts_(maxAttempts),
       maxFactor_(maxFactor), minFactor_(minFactor), dontThrow_(dontThrow),
-      dontThrowSteps_(dontThrowSteps), ts_(nullptr), loopRequired_(Interpolator::global) {
+      dontThrowSteps_(dontThrowSteps), maxEvaluations_(maxEvaluations), ts_(nullptr),
+      analyticDerivatives_(analyticDerivatives),
+      loopRequired_(Interpolator::global) {
         QL_REQUIRE(maxFactor_ >= 1.0, "Expected that maxFactor would be at least 1.0 but got " << maxFactor_);
         QL_REQUIRE(minFactor_ >= 1.0, "Expected that minFactor would be at least 1.0 but got " << minFactor_);
         firstSolver_.setMaxEvaluations(maxEvaluations);
@@ -224,6 +300,7 @@ namespace detail {
             // because, e.g., of interpolation's early checks
             ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
             previousData_.resize(alive_+1);
+            residuals_ = std::vector<Real>(alive_+1, Null<Real>());
             validCurve_ = false;
         }
         initialized_ = true;
@@ -264,6 +341,11 @@ namespace detail {
         // there might be a valid curve state to use as guess
         bool validData = validCurve_;
 
+        // if so, and if pillars don't depend on later ones, those
+        // whose helpers didn't change don't need to be solved again
+        bool incremental = validData && !loopRequired_;
+        bool changed = false;
+
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
@@ -274,6 +356,19 @@ namespace detail {
 
             for (Size i=1; i<=alive_; ++i) { // pillar loop
 
+                // the error is the same as at the previous solution
+                // only if neither the helper nor the previous pillars
+                // changed; the check is skipped on retries
+                if (incremental && attempts[i] == 1) {
+                    if ((*errors_[i])(data[i]) == residuals_[i])
+                        continue;
+                    // if a second pillar changed, the change is most
+                    // likely propagating along the curve and checking
+                    // the following pillars would be a waste
+                    incremental = !changed;
+                    changed = true;
+                }
+
                 // shorter aliases for readability and to avoid duplication
                 Real& min = minValues[i];
                 Real& max = maxValues[i];
@@ -320,10 +415,16 @@ namespace detail {
                 }
 
                 try {
-                    if (validData)
-                        solver_.solve(*errors_[i], accuracy, guess, min, max);
-                    else
-                        firstSolver_.solve(*errors_[i], accuracy, guess, min, max);
+                    bool solved = analyticDerivatives_ &&
+                        errors_[i]->helper()->hasImpliedQuoteSensitivities() &&
+                        detail::newtonFromGuess(*errors_[i], accuracy, guess, min, max,
+                                                maxEvaluations_);
+                    if (!solved) {
+                        if (validData)
+                            solver_.solve(*errors_[i], accuracy, guess, min, max);
+                        else
+                            firstSolver_.solve(*errors_[i], accuracy, guess, min, max);
+                    }
                 } catch (std::exception &e) {
                     if (validCurve_) {
                         // the previous curve state might have been a
@@ -361,6 +462,11 @@ namespace detail {
                                 ": " << e.what());
                     }
                 }
+
+                // the error at the solution, if it was the last one
+                // calculated, for the next incremental bootstrap
+                std::pair<Real, Real> last = errors_[i]->lastEvaluation();
+                residuals_[i] = last.first == data[i] ? last.second : Null<Real>();
             }
 
             if (!loopRequired_)
@@ -389,6 +495,76 @@ namespace detail {
         validCurve_ = true;
     }
 
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::analyticDerivatives() const {
+        if (!analyticDerivatives_)
+            return false;
+        QL_REQUIRE(ts_ != nullptr, "no curve set to the bootstrap");
+        // the alive helpers are only known after initialization
+        if (!initialized_ || ts_->moving_)
+            initialize();
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            if (!ts_->instruments_[j]->hasImpliedQuoteSensitivities())
+                return false;
+        }
+        return true;
+    }
+
+    template <class Curve>
+    Matrix IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(ts_ != nullptr, "no curve set to the bootstrap");
+        ts_->calculate();
+
+        std::vector<std::vector<std::pair<Date, Real> > > sensitivities(alive_);
+        std::vector<Date> latestDates(alive_);
+        for (Size i=0; i<alive_; ++i) {
+            const auto& helper = errors_[i+1]->helper();
+            QL_REQUIRE(helper->hasImpliedQuoteSensitivities(),
+                       io::ordinal(i+1) << " alive instrument (pillar " <<
+                       helper->pillarDate() << ") doesn't provide sensitivities");
+            sensitivities[i] = helper->impliedQuoteSensitivities();
+            if (!sensitivities[i].empty())
+                latestDates[i] = std::max_element(sensitivities[i].begin(),
+                                                  sensitivities[i].end())->first;
+        }
+
+        // each node is perturbed once, and the curve values
+        // required by all the helpers are calculated
+        std::vector<Real>& data = ts_->data_;
+        const std::vector<Real> baseData = data;
+        const Real h = detail::bootstrapNodeShift;
+        Matrix jacobian(alive_, alive_, 0.0);
+        try {
+            for (Size j=1; j<=alive_; ++j) {
+                for (Real sign : {1.0, -1.0}) {
+                    Traits::updateGuess(data, baseData[j] + sign*h, j);
+                    ts_->interpolation_.update();
+                    for (Size i=0; i<alive_; ++i) {
+                        // with a local interpolation, the values up to
+                        // the previous node don't depend on this one
+                        if (!Interpolator::global && latestDates[i] <= ts_->dates_[j-1])
+                            continue;
+                        Real d = 0.0;
+                        for (const auto& s : sensitivities[i]) {
+                            if (Interpolator::global || s.first > ts_->dates_[j-1])
+                                d += s.second * detail::bootstrapCurveValue(ts_, s.first, 0);
+                        }
+                        jacobian[i][j-1] += sign * d;
+                    }
+                    std::copy(baseData.begin(), baseData.end(), data.begin());
+                }
+            }
+        } catch (...) {
+            std::copy(baseData.begin(), baseData.end(), data.begin());
+            ts_->interpolation_.update();
+            throw;
+        }
+        ts_->interpolation_.update();
+
+        jacobian /= 2.0*h;
+        return jacobian;
+    }
+
 }
 
 #endif
@@ -35,6 +35,7 @@
 namespace QuantLib {
 
     class MultiCurveSensitivities;
+    template <class Curve> class BumpedNodeSensitivities;
 
     //! Piecewise yield term structure
     /*! This term structure is bootstrapped on a number of interest
@@ -185,6 +186,7 @@ namespace QuantLib {
         // it would increase the complexity---which is high enough
         // already.
         friend class MultiCurveSensitivities;
+        friend class BumpedNodeSensitivities<this_curve>;
         friend class Bootstrap<this_curve>;
         friend class BootstrapError<this_curve> ;
         friend class PenaltyFunction<this_curve>;
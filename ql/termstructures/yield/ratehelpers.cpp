@@ -36,6 +36,7 @@
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -64,6 +65,30 @@ namespace QuantLib {
                                            earliestDate, maturityDate);
         }
 
+        // derivatives of the forward rate (P(d1)/P(d2) - 1)/t
+        // with respect to the two discount factors
+        std::vector<std::pair<Date, Real> >
+        forwardRateSensitivities(const YieldTermStructure& ts,
+                                 const Date& d1,
+                                 const Date& d2,
+                                 Time t) {
+            DiscountFactor disc1 = ts.discount(d1);
+            DiscountFactor disc2 = ts.discount(d2);
+            return { { d1, 1.0 / (disc2 * t) },
+                     { d2, -disc1 / (disc2 * disc2 * t) } };
+        }
+
+        std::vector<std::pair<Date, Real> >
+        indexFixingSensitivities(const IborIndex& index,
+                                 const Date& fixingDate) {
+            // same dates as IborIndex::forecastFixing
+            Date d1 = index.valueDate(fixingDate);
+            Date d2 = index.maturityDate(d1);
+            Time t = index.dayCounter().yearFraction(d1, d2);
+            return forwardRateSensitivities(**index.forwardingTermStructure(),
+                                            d1, d2, t);
+        }
+
     } // namespace
 
     FuturesRateHelper::FuturesRateHelper(const Handle<Quote>& price,
@@ -247,6 +272,16 @@ namespace QuantLib {
         return iborIndex_->fixing(fixingDate_, true);
     }
 
+    bool DepositRateHelper::hasImpliedQuoteSensitivities() const {
+        return true;
+    }
+
+    std::vector<std::pair<Date, Real> >
+    DepositRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        return indexFixingSensitivities(*iborIndex_, fixingDate_);
+    }
+
     void DepositRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -432,6 +467,20 @@ namespace QuantLib {
                    spanningTime_;
     }
 
+    bool FraRateHelper::hasImpliedQuoteSensitivities() const {
+        return true;
+    }
+
+    std::vector<std::pair<Date, Real> >
+    FraRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+        if (useIndexedCoupon_)
+            return indexFixingSensitivities(*iborIndex_, fixingDate_);
+        else
+            return forwardRateSensitivities(*termStructure_, earliestDate_,
+                                            maturityDate_, spanningTime_);
+    }
+
     void FraRateHelper::setTermStructure(YieldTermStructure* t) {
         // do not set the relinkable handle as an observer -
         // force recalculation when needed---the index is not lazy
@@ -687,6 +736,116 @@ namespace QuantLib {
         return result;
     }
 
+    bool SwapRateHelper::hasImpliedQuoteSensitivities() const {
+        // the coupons are valued below as in IborCoupon
+        const Leg& leg = swap_->floatingLeg();
+        return std::all_of(leg.begin(), leg.end(),
+                           [](const ext::shared_ptr<CashFlow>& cf) {
+                               return ext::dynamic_pointer_cast<IborCoupon>(cf) != nullptr;
+                           });
+    }
+
+    std::vector<std::pair<Date, Real> >
+    SwapRateHelper::impliedQuoteSensitivities() const {
+        QL_REQUIRE(termStructure_ != nullptr, "term structure not set");
+
+        // The implied quote is q = -(F + sB)/A, where F is the NPV of
+        // the floating leg and A and B are the BPS of the fixed and
+        // floating leg divided by one basis point; therefore,
+        // dq = -(dF + s dB + q dA)/A.  The legs are valued here with
+        // the same coupon selection and rates as in the swap engine,
+        // which would be slower to go through.
+        const YieldTermStructure& discountCurve = **discountRelinkableHandle_;
+        Date settlementDate = discountCurve.referenceDate();
+        bool includeRefDateFlows =
+            Settings::instance().includeReferenceDateEvents();
+        auto isAlive = [&](const ext::shared_ptr<CashFlow>& cf) {
+            return !cf->hasOccurred(settlementDate, includeRefDateFlows) &&
+                   !cf->tradingExCoupon(settlementDate);
+        };
+        Spread spread = spread_.empty() ? 0.0 : spread_->value();
+
+        std::vector<std::pair<ext::shared_ptr<Coupon>, DiscountFactor> > fixed;
+        Real fixedSign = swap_->payer(0) ? -1.0 : 1.0;
+        Real annuity = 0.0;
+        for (const auto& cf : swap_->fixedLeg()) {
+            auto c = ext::dynamic_pointer_cast<Coupon>(cf);
+            if (c == nullptr || !isAlive(cf))
+                continue;
+            DiscountFactor df = discountCurve.discount(cf->date());
+            annuity += fixedSign * c->nominal() * c->accrualPeriod() * df;
+            fixed.emplace_back(c, df);
+        }
+
+        // coupon, discount factor, rate and, for the coupons not yet
+        // fixed, the forecast discount factors used for the fixing
+        struct FloatingCoupon {
+            ext::shared_ptr<IborCoupon> coupon;
+            DiscountFactor discount;
+            Rate rate;
+            bool forecast;
+            DiscountFactor startDiscount, endDiscount;
+        };
+        std::vector<FloatingCoupon> floating;
+        Real floatingSign = swap_->payer(1) ? -1.0 : 1.0;
+        Real floatingNPV = 0.0, floatingBPS = 0.0;
+        for (const auto& cf : swap_->floatingLeg()) {
+            auto c = ext::dynamic_pointer_cast<IborCoupon>(cf);
+            QL_REQUIRE(c != nullptr, "floating coupon other than IborCoupon");
+            if (!isAlive(cf))
+                continue;
+            FloatingCoupon f = { c, discountCurve.discount(cf->date()), 0.0,
+                                 !c->hasFixed(), 1.0, 1.0 };
+            Rate fixing;
+            if (f.forecast) {
+                // same forecast as in IborCoupon::indexFixing
+                f.startDiscount = termStructure_->discount(c->fixingValueDate());
+                f.endDiscount = termStructure_->discount(c->fixingEndDate());
+                fixing = (f.startDiscount / f.endDiscount - 1.0) / c->spanningTime();
+            } else {
+                fixing = c->indexFixing();
+            }
+            f.rate = c->gearing() * fixing + c->spread();
+            Real accrual = c->nominal() * c->accrualPeriod();
+            floatingNPV += floatingSign * f.rate * accrual * f.discount;
+            floatingBPS += floatingSign * accrual * f.discount;
+            floating.push_back(f);
+        }
+
+        Real quote = -(floatingNPV + spread * floatingBPS) / annuity;
+
+        // the discount factors depend on the bootstrapped curve
+        // only if no discount curve was given
+        bool discountSensitivities = discountHandle_.empty();
+        std::vector<std::pair<Date, Real> > result;
+        if (discountSensitivities) {
+            for (const auto& f : fixed) {
+                const Coupon& c = *f.first;
+                result.emplace_back(c.date(), -quote * fixedSign * c.nominal() *
+                                                  c.accrualPeriod() / annuity);
+            }
+        }
+        for (const auto& f : floating) {
+            const IborCoupon& c = *f.coupon;
+            Real accrual = c.nominal() * c.accrualPeriod();
+            if (discountSensitivities)
+                result.emplace_back(c.date(),
+                                    -floatingSign * (f.rate + spread) * accrual / annuity);
+            if (f.forecast) {
+                // the coupon rate is the gearing times the forecast
+                // (P(d1)/P(d2) - 1)/t
+                Real weight = -floatingSign * c.gearing() * accrual * f.discount /
+                              (annuity * c.spanningTime());
+                result.emplace_back(c.fixingValueDate(), weight / f.endDiscount);
+                result.emplace_back(c.fixingEndDate(),
+                                    -weight * f.startDiscount /
+                                        (f.endDiscount * f.endDiscount));
+            }
+        }
+
+        return result;
+    }
+
     void SwapRateHelper::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<SwapRateHelper>*>(&v);
         if (v1 != nullptr)
@@ -132,6 +132,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        bool hasImpliedQuoteSensitivities() const override;
+        std::vector<std::pair<Date, Real> > impliedQuoteSensitivities() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
         //! \name Visitability
@@ -234,6 +236,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        bool hasImpliedQuoteSensitivities() const override;
+        std::vector<std::pair<Date, Real> > impliedQuoteSensitivities() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
         //! \name Visitability
@@ -316,6 +320,8 @@ namespace QuantLib {
         //! \name RateHelper interface
         //@{
         Real impliedQuote() const override;
+        bool hasImpliedQuoteSensitivities() const override;
+        std::vector<std::pair<Date, Real> > impliedQuoteSensitivities() const override;
         void setTermStructure(YieldTermStructure*) override;
         //@}
         //! \name SwapRateHelper inspectors
@@ -0,0 +1,49 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file vectorization.hpp
+    \brief macros controlling the vectorization of loops
+
+    This header is meant to be included by source files only.
+*/
+
+#ifndef quantlib_vectorization_hpp
+#define quantlib_vectorization_hpp
+
+// clang-format off
+
+/* QL_SIMD_LOOP asks for the vectorization of the loop that follows;
+   the request is only made when OpenMP 4.0 or later is enabled. */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#  define QL_SIMD_LOOP _Pragma("omp simd")
+#else
+#  define QL_SIMD_LOOP
+#endif
+
+/* QL_SIMD_INLINE replaces inline for functions called in such loops;
+   it forces them to be inlined, since a call prevents vectorization. */
+#if defined(_MSC_VER)
+#  define QL_SIMD_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#  define QL_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#  define QL_SIMD_INLINE inline
+#endif
+
+// clang-format on
+
+#endif
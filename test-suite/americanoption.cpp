@@ -557,6 +557,89 @@ BOOST_AUTO_TEST_CASE(testFdAmericanGreeks) {
     testFdGreeks<FdBlackScholesVanillaEngine>();
 }
 
+BOOST_AUTO_TEST_CASE(testFdStrikeLadder) {
+
+    BOOST_TEST_MESSAGE("Testing finite-difference pricing of a ladder of "
+                       "American and Bermudan options in one batch...");
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS));
+
+    const Size tGrid = 100, xGrid = 200;
+    ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochProcess, tGrid, xGrid);
+
+    Date maturities[] = { today + Period(6, Months), today + Period(1, Years) };
+    Option::Type types[] = { Option::Call, Option::Put };
+    std::vector<ext::shared_ptr<Instrument> > portfolio;
+    std::vector<ext::shared_ptr<VanillaOption> > options, expected;
+    for (auto& maturity : maturities) {
+        std::vector<Date> exerciseDates;
+        for (Size i=1; i<=12 && today + Period(i, Months) <= maturity; ++i)
+            exerciseDates.push_back(today + Period(i, Months));
+
+        ext::shared_ptr<Exercise> exercises[] = {
+            ext::make_shared<AmericanExercise>(today, maturity),
+            ext::make_shared<BermudanExercise>(exerciseDates),
+            ext::make_shared<EuropeanExercise>(maturity)
+        };
+        for (auto& exercise : exercises) {
+            for (auto& type : types) {
+                for (Real strike = 80.0; strike <= 120.0; strike += 5.0) {
+                    ext::shared_ptr<StrikedTypePayoff> payoff(
+                        new PlainVanillaPayoff(type, strike));
+                    options.push_back(
+                        ext::make_shared<VanillaOption>(payoff, exercise));
+                    options.back()->setPricingEngine(engine);
+                    portfolio.push_back(options.back());
+
+                    expected.push_back(
+                        ext::make_shared<VanillaOption>(payoff, exercise));
+                    expected.back()->setPricingEngine(
+                        ext::make_shared<FdBlackScholesVanillaEngine>(
+                            stochProcess, tGrid, xGrid));
+                }
+            }
+        }
+    }
+
+    calculateInstruments(portfolio);
+
+    // each option is rolled back on its own grid, hence the results
+    // only differ by rounding errors
+    Real tolerance[] = { 1.0e-10, 1.0e-10, 1.0e-10, 1.0e-10 };
+    for (Size k=0; k<options.size(); k++) {
+        Real calculated[] = { options[k]->NPV(), options[k]->delta(),
+                              options[k]->gamma(), options[k]->theta() };
+        Real reference[] = { expected[k]->NPV(), expected[k]->delta(),
+                             expected[k]->gamma(), expected[k]->theta() };
+        for (Size m=0; m<LENGTH(calculated); m++) {
+            if (std::fabs(calculated[m] - reference[m]) > tolerance[m]) {
+                BOOST_FAIL("batch result #" << m << " of option #" << k
+                           << " differs from single pricing:"
+                           << std::setprecision(12)
+                           << "\n    exercise:   "
+                           << exerciseTypeToString(options[k]->exercise())
+                           << "\n    calculated: " << calculated[m]
+                           << "\n    expected:   " << reference[m]
+                           << "\n    tolerance:  " << tolerance[m]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdShoutGreeks, *precondition(if_speed(Fast))) {
     BOOST_TEST_MESSAGE("Testing finite-differences shout option greeks...");
     testFdGreeks<FdBlackScholesShoutEngine>();
@@ -2181,6 +2264,105 @@ BOOST_AUTO_TEST_CASE(testSingleBjerksundStenslandGreeks) {
         BOOST_FAIL("American exercise type expected");
 }
 
+BOOST_AUTO_TEST_CASE(testFdTangentGreeks) {
+    BOOST_TEST_MESSAGE("Testing tangent vega and rho of American options "
+                       "with finite differences...");
+
+    const Date today = Date(20, January, 2023);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const auto spot = ext::make_shared<SimpleQuote>(100.0);
+    const auto vol = ext::make_shared<SimpleQuote>(0.25);
+    const auto qRate = ext::make_shared<SimpleQuote>(0.02);
+    const auto rRate = ext::make_shared<SimpleQuote>(0.05);
+
+    const auto bsProcess = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(qRate, dc)),
+        Handle<YieldTermStructure>(flatRate(rRate, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+
+    const auto exercise = ext::make_shared<AmericanExercise>(
+        today, today + Period(1, Years));
+
+    const Size tGrid = 200, xGrid = 200;
+    const DividendSchedule dividendSchedules[] = {
+        DividendSchedule(),
+        DividendVector({ today + Period(6, Months) }, { 2.0 })
+    };
+
+    for (const auto& dividends : dividendSchedules) {
+        const auto engine = ext::make_shared<FdBlackScholesVanillaEngine>(
+            bsProcess, dividends, tGrid, xGrid);
+        const auto tangentEngine =
+            ext::make_shared<FdBlackScholesVanillaEngine>(
+                bsProcess, dividends, tGrid, xGrid, 0,
+                FdmSchemeDesc::Douglas(), false, -Null<Real>(),
+                FdBlackScholesVanillaEngine::Spot, true);
+
+        for (Real strike : { 90.0, 100.0, 110.0 }) {
+            const auto payoff
+                = ext::make_shared<PlainVanillaPayoff>(Option::Put, strike);
+            VanillaOption option(payoff, exercise);
+
+            option.setPricingEngine(tangentEngine);
+            const Real npv = option.NPV();
+            const Real vega = option.vega();
+            const Real rho = option.rho();
+
+            // shifting the parameters moves the mesher as well, hence
+            // the tolerances
+            option.setPricingEngine(engine);
+            const Real expectedNpv = option.NPV();
+
+            const Real h = 1e-4;
+            vol->setValue(0.25 + h);
+            Real up = option.NPV();
+            vol->setValue(0.25 - h);
+            Real down = option.NPV();
+            vol->setValue(0.25);
+            const Real expectedVega = (up - down)/(2*h);
+
+            rRate->setValue(0.05 + h);
+            up = option.NPV();
+            rRate->setValue(0.05 - h);
+            down = option.NPV();
+            rRate->setValue(0.05);
+            const Real expectedRho = (up - down)/(2*h);
+
+            const Real calculated[] = { npv, vega, rho };
+            const Real expected[] = { expectedNpv, expectedVega, expectedRho };
+            const std::string names[] = { "npv", "vega", "rho" };
+            const Real tolerance[] = { 1e-10, 5e-2, 1e-2 };
+
+            for (Size i=0; i < LENGTH(calculated); ++i) {
+                const Real error = std::fabs(calculated[i] - expected[i]);
+                if (error > tolerance[i])
+                    BOOST_ERROR("failed to reproduce " << names[i]
+                                << " of American option"
+                                << "\n    strike:     " << strike
+                                << "\n    dividends:  " << dividends.size()
+                                << std::setprecision(8)
+                                << "\n    calculated: " << calculated[i]
+                                << "\n    expected:   " << expected[i]
+                                << "\n    error:      " << error
+                                << "\n    tolerance:  " << tolerance[i]);
+            }
+        }
+    }
+
+    // the tangent rho would miss the dependence of the escrowed
+    // dividends on the rates
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0), exercise);
+    option.setPricingEngine(ext::make_shared<FdBlackScholesVanillaEngine>(
+        bsProcess, dividendSchedules[1], tGrid, xGrid, 0,
+        FdmSchemeDesc::Douglas(), false, -Null<Real>(),
+        FdBlackScholesVanillaEngine::Escrowed, true));
+    BOOST_CHECK_THROW(option.NPV(), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
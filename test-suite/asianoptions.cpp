@@ -2394,6 +2394,97 @@ BOOST_AUTO_TEST_CASE(testDiscreteGeometricAveragePriceHestonPastFixings) {
         }
     }
 }
+BOOST_AUTO_TEST_CASE(testMultiThreadedMCDiscreteArithmeticAveragePrice) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multi-threaded Monte Carlo discrete arithmetic average-price Asians...");
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(90.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.06, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.025, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.13, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    // Levy, 1997: 12 fixings over 11 months
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Put, 87.0));
+    const Size fixings = 12;
+    Time dt = (11.0/12.0) / (fixings - 1);
+    std::vector<Date> fixingDates(fixings);
+    for (Size i = 0; i < fixings; i++)
+        fixingDates[i] = today + timeToDays(i * dt);
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(fixingDates.back()));
+
+    DiscreteAveragingAsianOption option(Average::Arithmetic, 0.0, 0,
+                                        fixingDates, payoff, exercise);
+    Real expected = 1.6980019214;
+
+    const Size threads = 4;
+
+    for (bool controlVariate : {false, true}) {
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(20001)
+            .withControlVariate(controlVariate)
+            .withSeed(42)
+            .withThreads(threads));
+        Real calculated = option.NPV();
+        Real errorEstimate = option.errorEstimate();
+
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(20001)
+            .withControlVariate(controlVariate)
+            .withSeed(42)
+            .withThreads(threads));
+        Real recalculated = option.NPV();
+
+        if (calculated != recalculated)
+            BOOST_ERROR("multi-threaded Asian simulation not reproducible:"
+                        << std::setprecision(12)
+                        << "\n    control variate: " << controlVariate
+                        << "\n    first run:       " << calculated
+                        << "\n    second run:      " << recalculated);
+        // the quoted value carries its own discretization error
+        // of about 1.0e-3
+        if (std::fabs(calculated - expected) > 4.0*errorEstimate + 2.0e-3)
+            BOOST_ERROR("multi-threaded Asian simulation failed:"
+                        << "\n    control variate: " << controlVariate
+                        << "\n    calculated:      " << calculated
+                        << "\n    expected:        " << expected
+                        << "\n    error estimate:  " << errorEstimate);
+
+        // a single thread reproduces the plain sequential simulation
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(1001)
+            .withControlVariate(controlVariate)
+            .withSeed(42));
+        Real sequential = option.NPV();
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(1001)
+            .withControlVariate(controlVariate)
+            .withSeed(42)
+            .withThreads(1));
+        calculated = option.NPV();
+        if (calculated != sequential)
+            BOOST_ERROR("single-threaded Asian simulation changed:"
+                        << std::setprecision(12)
+                        << "\n    control variate: " << controlVariate
+                        << "\n    calculated:      " << calculated
+                        << "\n    expected:        " << sequential);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1514,6 +1514,85 @@ BOOST_AUTO_TEST_CASE(testVannaVolgaSimpleBarrierValues) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMultiThreadedMcBarrierEngine) {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded Monte Carlo barrier engine...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot = ext::make_shared<SimpleQuote>(100.0);
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+                                      Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years));
+    BarrierOption option(Barrier::DownOut, 90.0, 0.0, payoff, exercise);
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticBarrierEngine>(stochProcess));
+    Real expected = option.NPV();
+
+    const Size threads = 4;
+
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withSamples(40001)
+        .withSeed(42)
+        .withThreads(threads));
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withSamples(40001)
+        .withSeed(42)
+        .withThreads(threads));
+    Real recalculated = option.NPV();
+
+    if (calculated != recalculated)
+        BOOST_ERROR("multi-threaded barrier simulation not reproducible:"
+                    << std::setprecision(12)
+                    << "\n    first run:  " << calculated
+                    << "\n    second run: " << recalculated);
+    if (std::fabs(calculated - expected) > 4.0*errorEstimate)
+        BOOST_ERROR("multi-threaded barrier simulation failed:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << errorEstimate);
+
+    // a single thread reproduces the plain sequential simulation
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withSamples(1001)
+        .withSeed(42));
+    expected = option.NPV();
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withSamples(1001)
+        .withSeed(42)
+        .withThreads(1));
+    calculated = option.NPV();
+    if (calculated != expected)
+        BOOST_ERROR("single-threaded barrier simulation changed:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
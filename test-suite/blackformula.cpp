@@ -442,6 +442,82 @@ BOOST_AUTO_TEST_CASE(testBachelierBlackFormulaForwardDerivativeWithZeroVolatilit
     assertBachelierBlackFormulaForwardDerivative(Option::Put, strikes, vol);
 }
 
+BOOST_AUTO_TEST_CASE(testBlackFormulaStrip) {
+
+    BOOST_TEST_MESSAGE("Testing Black formula on a strip of options...");
+
+    const Real forward = 0.03;
+    const Real discount = 0.95;
+    const Size n = 2000;
+
+    for (Real displacement : {0.0, 0.01}) {
+        std::vector<Real> strikes(n), stdDevs(n);
+        for (Size i=0; i<n; ++i) {
+            strikes[i] = forward * (0.4 + 1.6*i/(n-1));
+            stdDevs[i] = 0.2 + 0.6*((i*37)%n)/n;
+        }
+        // degenerate entries, handled by the scalar formula
+        stdDevs[n/2] = 0.0;
+        strikes[0] = -displacement;
+
+        for (auto type : {Option::Call, Option::Put}) {
+            std::vector<Real> prices =
+                blackFormula(type, strikes, forward, stdDevs, discount, displacement);
+            std::vector<Real> deltas =
+                blackFormulaForwardDerivative(type, strikes, forward, stdDevs,
+                                              discount, displacement);
+            std::vector<Real> vegas =
+                blackFormulaStdDevDerivative(strikes, forward, stdDevs,
+                                             discount, displacement);
+
+            for (Size i=0; i<n; ++i) {
+                Real price = blackFormula(type, strikes[i], forward, stdDevs[i],
+                                          discount, displacement);
+                Real delta = blackFormulaForwardDerivative(
+                    type, strikes[i], forward, stdDevs[i], discount, displacement);
+                Real vega = blackFormulaStdDevDerivative(
+                    strikes[i], forward, stdDevs[i], discount, displacement);
+                if (std::fabs(prices[i] - price) > 1.0e-14
+                    || std::fabs(deltas[i] - delta) > 1.0e-13
+                    || std::fabs(vegas[i] - vega) > 1.0e-14)
+                    BOOST_ERROR("mismatch between strip and scalar Black formula"
+                                << "\n    option type:  " << type
+                                << "\n    strike:       " << strikes[i]
+                                << "\n    stdDev:       " << stdDevs[i]
+                                << "\n    displacement: " << displacement
+                                << "\n    price:        " << prices[i] << " vs " << price
+                                << "\n    delta:        " << deltas[i] << " vs " << delta
+                                << "\n    vega:         " << vegas[i] << " vs " << vega);
+            }
+
+            const Real accuracy = 1.0e-10;
+            std::vector<Real> implied =
+                blackFormulaImpliedStdDev(type, strikes, forward, prices,
+                                          discount, displacement, accuracy);
+            for (Size i=1; i<n; ++i) {
+                if (stdDevs[i] == 0.0)
+                    continue;
+                Real expected = blackFormulaImpliedStdDev(
+                    type, strikes[i], forward, prices[i], discount,
+                    displacement, Null<Real>(), accuracy);
+                if (std::fabs(implied[i] - stdDevs[i]) > 1.0e-8
+                    || std::fabs(implied[i] - expected) > 1.0e-8)
+                    BOOST_ERROR("failed to recover stdDev from strip of prices"
+                                << "\n    option type:  " << type
+                                << "\n    strike:       " << strikes[i]
+                                << "\n    displacement: " << displacement
+                                << "\n    stdDev:       " << stdDevs[i]
+                                << "\n    implied:      " << implied[i]
+                                << "\n    scalar:       " << expected);
+            }
+        }
+    }
+
+    std::vector<Real> strikes(3, forward), stdDevs(2, 0.2);
+    BOOST_CHECK_THROW(blackFormula(Option::Call, strikes, forward, stdDevs),
+                      Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
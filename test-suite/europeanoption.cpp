@@ -81,6 +81,18 @@ struct EuropeanOptionData {
     Real tol;      // tolerance
 };
 
+// an option doing more than running its pricing engine
+class DoubledOption : public EuropeanOption {
+  public:
+    using EuropeanOption::EuropeanOption;
+  protected:
+    bool calculatedByEngine() const override { return false; }
+    void performCalculations() const override {
+        EuropeanOption::performCalculations();
+        NPV_ *= 2.0;
+    }
+};
+
 enum EngineType { Analytic,
                   JR, CRR, EQP, TGEO, TIAN, LR, JOSHI,
                   FiniteDifferences,
@@ -1292,6 +1304,544 @@ BOOST_AUTO_TEST_CASE(testQmcEngines) {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+BOOST_AUTO_TEST_CASE(testMultiThreadedMcEngines) {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded Monte Carlo European engines...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Call, 105.0));
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(stochProcess));
+    Real expected = option.NPV();
+
+    const Size threads = 4;
+
+    // pseudo-random streams: reproducible for a given seed and
+    // number of threads, and consistent with the analytic value
+    ext::shared_ptr<PricingEngine> mcEngine =
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(40001)
+        .withSeed(42)
+        .withThreads(threads);
+    option.setPricingEngine(mcEngine);
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(40001)
+        .withSeed(42)
+        .withThreads(threads));
+    Real recalculated = option.NPV();
+
+    if (calculated != recalculated)
+        BOOST_ERROR("multi-threaded pseudo-random simulation not reproducible:"
+                    << std::setprecision(12)
+                    << "\n    first run:  " << calculated
+                    << "\n    second run: " << recalculated);
+    if (std::fabs(calculated - expected) > 4.0*errorEstimate)
+        BOOST_ERROR("multi-threaded pseudo-random simulation failed:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << errorEstimate);
+
+    // the adaptive loop works on the merged statistics
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withAbsoluteTolerance(0.05)
+        .withSeed(42)
+        .withThreads(threads));
+    calculated = option.NPV();
+    errorEstimate = option.errorEstimate();
+    if (errorEstimate > 0.05)
+        BOOST_ERROR("multi-threaded simulation did not reach the tolerance:"
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    tolerance:      " << 0.05);
+    if (std::fabs(calculated - expected) > 4.0*errorEstimate)
+        BOOST_ERROR("multi-threaded simulation with tolerance failed:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << errorEstimate);
+
+    // low-discrepancy streams use disjoint blocks of the sequence
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<LowDiscrepancy>(stochProcess)
+        .withSteps(1)
+        .withSamples(4*4096)
+        .withThreads(threads));
+    calculated = option.NPV();
+    if (std::fabs(calculated - expected) > 0.01*expected)
+        BOOST_ERROR("multi-threaded low-discrepancy simulation failed:"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    // user-defined traits without stream factories still work
+    // in single-threaded simulations
+    struct PlainPseudoRandom : PseudoRandom {
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            return PseudoRandom::make_sequence_generator(dimension, seed);
+        }
+    };
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(1001)
+        .withSeed(42));
+    expected = option.NPV();
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PlainPseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(1001)
+        .withSeed(42));
+    calculated = option.NPV();
+    if (calculated != expected)
+        BOOST_ERROR("single-threaded simulation with plain traits failed:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PlainPseudoRandom>(stochProcess)
+        .withSteps(1)
+        .withSamples(1001)
+        .withSeed(42)
+        .withThreads(threads));
+    BOOST_CHECK_THROW(option.NPV(), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testBatchPricing) {
+
+    BOOST_TEST_MESSAGE("Testing batch pricing of European options...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+    ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AnalyticEuropeanEngine>(stochProcess);
+
+    // the same options priced one by one, each with its own engine
+    Option::Type types[] = { Option::Call, Option::Put };
+    const Size nStrikes = 250, nExpiries = 10;
+    std::vector<ext::shared_ptr<Instrument> > portfolio;
+    std::vector<ext::shared_ptr<VanillaOption> > options, expected;
+    for (auto& type : types) {
+        for (Size i=0; i<nExpiries; i++) {
+            ext::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(today + Period(3*(i+1), Months)));
+            for (Size j=0; j<nStrikes; j++) {
+                ext::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(type, 50.0 + 0.4*j));
+                options.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+                options.back()->setPricingEngine(engine);
+                portfolio.push_back(options.back());
+
+                expected.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+                expected.back()->setPricingEngine(
+                    ext::make_shared<AnalyticEuropeanEngine>(stochProcess));
+            }
+        }
+    }
+
+    // digital options are priced one by one by the same engine
+    for (auto& type : types) {
+        ext::shared_ptr<StrikedTypePayoff> payoff(
+            new CashOrNothingPayoff(type, 100.0, 10.0));
+        ext::shared_ptr<Exercise> exercise(
+            new EuropeanExercise(today + Period(6, Months)));
+        options.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+        options.back()->setPricingEngine(engine);
+        portfolio.push_back(options.back());
+
+        expected.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+        expected.back()->setPricingEngine(
+            ext::make_shared<AnalyticEuropeanEngine>(stochProcess));
+    }
+
+    // an expired option, one with a different engine and one
+    // overriding performCalculations can be passed along with
+    // the others
+    ext::shared_ptr<VanillaOption> expired = ext::make_shared<EuropeanOption>(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        ext::make_shared<EuropeanExercise>(today - 1));
+    expired->setPricingEngine(engine);
+    portfolio.push_back(expired);
+    ext::shared_ptr<VanillaOption> other = ext::make_shared<EuropeanOption>(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    other->setPricingEngine(ext::make_shared<IntegralEngine>(stochProcess));
+    portfolio.push_back(other);
+    ext::shared_ptr<VanillaOption> doubled = ext::make_shared<DoubledOption>(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    doubled->setPricingEngine(engine);
+    portfolio.push_back(doubled);
+    EuropeanOption single(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    single.setPricingEngine(engine);
+
+    Real spots[] = { 100.0, 90.0 };
+    for (Real s : spots) {
+        spot->setValue(s);
+
+        calculateInstruments(portfolio);
+
+        for (Size k=0; k<options.size(); k++) {
+            Real calculated[] = { options[k]->NPV(), options[k]->delta(),
+                                  options[k]->gamma(), options[k]->vega(),
+                                  options[k]->theta(), options[k]->rho(),
+                                  options[k]->dividendRho(),
+                                  options[k]->deltaForward(),
+                                  options[k]->thetaPerDay(),
+                                  options[k]->strikeSensitivity(),
+                                  options[k]->itmCashProbability(),
+                                  options[k]->result<Real>("forward") };
+            Real reference[] = { expected[k]->NPV(), expected[k]->delta(),
+                                 expected[k]->gamma(), expected[k]->vega(),
+                                 expected[k]->theta(), expected[k]->rho(),
+                                 expected[k]->dividendRho(),
+                                 expected[k]->deltaForward(),
+                                 expected[k]->thetaPerDay(),
+                                 expected[k]->strikeSensitivity(),
+                                 expected[k]->itmCashProbability(),
+                                 expected[k]->result<Real>("forward") };
+            for (Size m=0; m<LENGTH(calculated); m++) {
+                // the strips compute the values with their own kernels
+                if (std::fabs(calculated[m] - reference[m])
+                    > 1.0e-12 * std::max(1.0, std::fabs(reference[m]))) {
+                    BOOST_FAIL("batch result #" << m << " of option #" << k
+                               << " differs from single pricing:"
+                               << std::setprecision(12)
+                               << "\n    spot:       " << s
+                               << "\n    calculated: " << calculated[m]
+                               << "\n    expected:   " << reference[m]);
+                }
+            }
+            // the elasticity divides by the value, which the strips
+            // reproduce to the same absolute (not relative) accuracy
+            Real value = expected[k]->NPV();
+            if (std::fabs(options[k]->elasticity() - expected[k]->elasticity())
+                    * std::fabs(value)
+                > 1.0e-12 * std::max(1.0, std::fabs(expected[k]->elasticity() * value))) {
+                BOOST_FAIL("batch elasticity of option #" << k
+                           << " differs from single pricing:"
+                           << std::setprecision(12)
+                           << "\n    spot:       " << s
+                           << "\n    calculated: " << options[k]->elasticity()
+                           << "\n    expected:   " << expected[k]->elasticity());
+            }
+        }
+
+        if (expired->NPV() != 0.0)
+            BOOST_ERROR("expired option has non-null value: " << expired->NPV());
+        if (!other->isCalculated())
+            BOOST_ERROR("option with different engine was not calculated");
+        if (std::fabs(doubled->NPV() - 2.0*single.NPV()) > 1.0e-12)
+            BOOST_ERROR("performCalculations override was not called:"
+                        << "\n    calculated: " << doubled->NPV()
+                        << "\n    expected:   " << 2.0*single.NPV());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdBatchPricing) {
+
+    BOOST_TEST_MESSAGE("Testing batch pricing of European options "
+                       "with finite differences...");
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+
+    // a volatility smile, so that each option needs its own volatility
+    std::vector<Date> dates = { today + Period(6, Months),
+                                today + Period(1, Years),
+                                today + Period(2, Years) };
+    std::vector<Real> strikes = { 60.0, 80.0, 100.0, 120.0, 140.0 };
+    Matrix vols(strikes.size(), dates.size());
+    for (Size i=0; i<strikes.size(); ++i)
+        for (Size j=0; j<dates.size(); ++j)
+            vols[i][j] = 0.2 + 0.1*std::fabs(strikes[i]-100.0)/40.0 + 0.01*j;
+    ext::shared_ptr<BlackVolTermStructure> volTS =
+        ext::make_shared<BlackVarianceSurface>(today, TARGET(), dates,
+                                               strikes, vols, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    const Size tGrid = 100, xGrid = 200;
+    ext::shared_ptr<FdBlackScholesVanillaEngine> engine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochProcess, tGrid, xGrid);
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    std::vector<ext::shared_ptr<Instrument> > portfolio;
+    std::vector<ext::shared_ptr<VanillaOption> > options, expected;
+    for (auto& type : types) {
+        for (const auto& date : dates) {
+            ext::shared_ptr<Exercise> exercise(new EuropeanExercise(date));
+            for (Real strike = 70.0; strike <= 130.0; strike += 5.0) {
+                ext::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(type, strike));
+                options.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+                options.back()->setPricingEngine(engine);
+                portfolio.push_back(options.back());
+
+                expected.push_back(ext::make_shared<EuropeanOption>(payoff, exercise));
+                expected.back()->setPricingEngine(
+                    ext::make_shared<FdBlackScholesVanillaEngine>(
+                        stochProcess, tGrid, xGrid));
+            }
+        }
+    }
+
+    calculateInstruments(portfolio);
+
+    // each option is rolled back on its own grid, hence the results
+    // only differ by rounding errors
+    Real tolerance[] = { 1.0e-10, 1.0e-10, 1.0e-10, 1.0e-10 };
+    for (Size k=0; k<options.size(); k++) {
+        Real calculated[] = { options[k]->NPV(), options[k]->delta(),
+                              options[k]->gamma(), options[k]->theta() };
+        Real reference[] = { expected[k]->NPV(), expected[k]->delta(),
+                             expected[k]->gamma(), expected[k]->theta() };
+        for (Size m=0; m<LENGTH(calculated); m++) {
+            if (std::fabs(calculated[m] - reference[m]) > tolerance[m]) {
+                BOOST_FAIL("batch result #" << m << " of option #" << k
+                           << " differs from single pricing:"
+                           << std::setprecision(12)
+                           << "\n    calculated: " << calculated[m]
+                           << "\n    expected:   " << reference[m]
+                           << "\n    tolerance:  " << tolerance[m]);
+            }
+        }
+    }
+
+    // the groups are cached and profiled as single options are
+    const FdBlackScholesVanillaEngine::Profile& profile = engine->profile();
+    if (profile.calculations != options.size() || profile.cacheHits != 0)
+        BOOST_ERROR("unexpected profile after the first batch:"
+                    << "\n    calculations: " << profile.calculations
+                    << "\n    cache hits:   " << profile.cacheHits
+                    << "\n    options:      " << options.size());
+
+    std::vector<Real> npvs;
+    for (const auto& option : options) {
+        npvs.push_back(option->NPV());
+        option->update();
+    }
+    calculateInstruments(portfolio);
+
+    if (profile.calculations != 2*options.size()
+        || profile.cacheHits != options.size())
+        BOOST_ERROR("unexpected profile after the second batch:"
+                    << "\n    calculations: " << profile.calculations
+                    << "\n    cache hits:   " << profile.cacheHits
+                    << "\n    options:      " << options.size());
+    for (Size k=0; k<options.size(); k++) {
+        if (options[k]->NPV() != npvs[k])
+            BOOST_ERROR("cached operator gave a different result for option #"
+                        << k << std::setprecision(12)
+                        << "\n    calculated: " << options[k]->NPV()
+                        << "\n    expected:   " << npvs[k]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdTangentGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing tangent vega and rho of the "
+                       "finite-difference Black-Scholes engine...");
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+
+    // a volatility surface, so that the forward variance changes
+    // from step to step
+    std::vector<Date> dates = { today + Period(6, Months),
+                                today + Period(1, Years),
+                                today + Period(2, Years) };
+    std::vector<Real> strikes = { 60.0, 80.0, 100.0, 120.0, 140.0 };
+    Matrix vols(strikes.size(), dates.size());
+    for (Size i=0; i<strikes.size(); ++i)
+        for (Size j=0; j<dates.size(); ++j)
+            vols[i][j] = 0.2 + 0.1*std::fabs(strikes[i]-100.0)/40.0 + 0.02*j;
+    ext::shared_ptr<BlackVolTermStructure> volTS =
+        ext::make_shared<BlackVarianceSurface>(today, TARGET(), dates,
+                                               strikes, vols, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<AnalyticEuropeanEngine>(stochProcess);
+    ext::shared_ptr<PricingEngine> tangentEngine =
+        MakeFdBlackScholesVanillaEngine(stochProcess)
+        .withTGrid(100).withXGrid(200)
+        .withTangentGreeks();
+    ext::shared_ptr<PricingEngine> richardsonEngine =
+        MakeFdBlackScholesVanillaEngine(stochProcess)
+        .withTGrid(50).withXGrid(100)
+        .withTangentGreeks()
+        .withRichardsonExtrapolation();
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    for (auto& type : types) {
+        for (const auto& date : dates) {
+            ext::shared_ptr<Exercise> exercise(new EuropeanExercise(date));
+            for (Real strike = 80.0; strike <= 120.0; strike += 10.0) {
+                EuropeanOption option(
+                    ext::make_shared<PlainVanillaPayoff>(type, strike),
+                    exercise);
+
+                option.setPricingEngine(analyticEngine);
+                const Real expected[] = {
+                    option.NPV(), option.vega(), option.rho() };
+
+                option.setPricingEngine(tangentEngine);
+                const Real tangent[] = {
+                    option.NPV(), option.vega(), option.rho() };
+
+                option.setPricingEngine(richardsonEngine);
+                const Real extrapolated[] = {
+                    option.NPV(), option.vega(), option.rho() };
+
+                const std::string names[] = { "value", "vega", "rho" };
+                const Real tolerance[] = { 1e-2, 3e-2, 5e-2 };
+                const Real richardsonTolerance[] = { 5e-4, 1e-3, 2e-3 };
+                for (Size m=0; m<LENGTH(expected); ++m) {
+                    if (std::fabs(tangent[m] - expected[m]) > tolerance[m]
+                        || std::fabs(extrapolated[m] - expected[m])
+                               > richardsonTolerance[m]) {
+                        BOOST_FAIL("failed to reproduce analytic " << names[m]
+                                   << "\n    type:         " << type
+                                   << "\n    strike:       " << strike
+                                   << "\n    maturity:     " << date
+                                   << std::setprecision(8)
+                                   << "\n    tangent:      " << tangent[m]
+                                   << "\n    extrapolated: " << extrapolated[m]
+                                   << "\n    expected:     " << expected[m]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdOperatorCache) {
+
+    BOOST_TEST_MESSAGE("Testing the operator cache of the "
+                       "finite-difference Black-Scholes engine...");
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const ext::shared_ptr<FdBlackScholesVanillaEngine> engine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(stochProcess, 100, 100);
+
+    const Date maturity = today + Period(1, Years);
+    const ext::shared_ptr<Exercise> exercises[] = {
+        ext::make_shared<EuropeanExercise>(maturity),
+        ext::make_shared<AmericanExercise>(today, maturity)
+    };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<ext::shared_ptr<VanillaOption> > options;
+    for (const auto& exercise : exercises)
+        for (auto type : types)
+            options.push_back(ext::make_shared<VanillaOption>(
+                ext::make_shared<PlainVanillaPayoff>(type, 105.0), exercise));
+
+    // the options share strike and maturity, hence the mesher and operator
+    for (Real s : { 100.0, 110.0 }) {
+        spot->setValue(s);
+        engine->resetProfile();
+
+        for (const auto& option : options) {
+            option->setPricingEngine(engine);
+            const Real calculated = option->NPV();
+
+            option->setPricingEngine(
+                ext::make_shared<FdBlackScholesVanillaEngine>(
+                    stochProcess, 100, 100));
+            const Real expected = option->NPV();
+
+            if (std::fabs(calculated - expected) > 1e-12)
+                BOOST_FAIL("cached operator gives a different price"
+                           << std::setprecision(12)
+                           << "\n    spot:       " << s
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+
+        const FdBlackScholesVanillaEngine::Profile& profile =
+            engine->profile();
+        if (profile.calculations != options.size()
+            || profile.cacheHits != options.size()-1)
+            BOOST_FAIL("unexpected use of the operator cache"
+                       << "\n    calculations: " << profile.calculations
+                       << "\n    cache hits:   " << profile.cacheHits);
+        if (profile.setupTime < 0.0 || profile.rollbackTime <= 0.0)
+            BOOST_FAIL("unexpected profiling times"
+                       << "\n    setup:    " << profile.setupTime
+                       << "\n    rollback: " << profile.rollbackTime);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolatility) {
     BOOST_TEST_MESSAGE("Testing finite-differences with local volatility...");
 
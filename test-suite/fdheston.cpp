@@ -1052,6 +1052,75 @@ BOOST_AUTO_TEST_CASE(testAmericanCallPutParity) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testAdaptiveTimeStepping) {
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping with TR-BDF2 "
+                       "for the Heston model...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(15, April, 2022);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.01, dc));
+
+    const ext::shared_ptr<HestonModel> model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 1.5, 0.04, 0.5, -0.7));
+
+    const Date maturity = today + Period(5, Years);
+    const ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0);
+
+    VanillaOption europeanOption(
+        payoff, ext::make_shared<EuropeanExercise>(maturity));
+
+    europeanOption.setPricingEngine(
+        ext::make_shared<AnalyticHestonEngine>(model));
+    const Real expectedEuropean = europeanOption.NPV();
+
+    europeanOption.setPricingEngine(
+        ext::make_shared<FdHestonVanillaEngine>(
+            model, 10, 100, 50, 0, FdmSchemeDesc::AdaptiveTrBDF2(1e-5)));
+    const Real calculatedEuropean = europeanOption.NPV();
+
+    const Real tolEuropean = 1e-2;
+    if (std::fabs(calculatedEuropean - expectedEuropean) > tolEuropean) {
+        BOOST_ERROR("failed to reproduce European option price "
+                    "with adaptive time stepping"
+                    << "\n   calculated: " << calculatedEuropean
+                    << "\n   expected:   " << expectedEuropean
+                    << "\n   tolerance:  " << tolEuropean);
+    }
+
+    // the exercise dates are stopping times of the rollback
+    std::vector<Date> exerciseDates;
+    for (Integer i=1; i <= 5; ++i)
+        exerciseDates.push_back(today + Period(i, Years));
+
+    VanillaOption bermudanOption(
+        payoff, ext::make_shared<BermudanExercise>(exerciseDates));
+
+    bermudanOption.setPricingEngine(
+        ext::make_shared<FdHestonVanillaEngine>(
+            model, 500, 100, 50, 0, FdmSchemeDesc::Hundsdorfer()));
+    const Real expectedBermudan = bermudanOption.NPV();
+
+    bermudanOption.setPricingEngine(
+        ext::make_shared<FdHestonVanillaEngine>(
+            model, 10, 100, 50, 0, FdmSchemeDesc::AdaptiveTrBDF2(1e-5)));
+    const Real calculatedBermudan = bermudanOption.NPV();
+
+    const Real tolBermudan = 2e-3;
+    if (std::fabs(calculatedBermudan - expectedBermudan) > tolBermudan) {
+        BOOST_ERROR("failed to reproduce Bermudan option price "
+                    "with adaptive time stepping"
+                    << "\n   calculated: " << calculatedBermudan
+                    << "\n   expected:   " << expectedBermudan
+                    << "\n   tolerance:  " << tolBermudan);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
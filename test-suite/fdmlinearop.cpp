@@ -27,6 +27,7 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
@@ -73,7 +74,9 @@
 #include <boost/numeric/ublas/operation.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <functional>
+#include <iomanip>
 #include <numeric>
+#include <thread>
 #include <utility>
 
 using namespace QuantLib;
@@ -833,6 +836,50 @@ BOOST_AUTO_TEST_CASE(testTripleBandMapSolve) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testTripleBandMapSolveAlongEachDirection) {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map solution along each direction...");
+
+    // the dimensions are not multiples of the number of
+    // lines solved together, so that partial blocks are tested
+    const std::vector<Size> dim = {13, 10, 7};
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries = {
+        {0.0, 1.0}, {-1.0, 1.0}, {0.5, 2.0}};
+
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    const Size n = layout->size();
+    Array u(n), sigma(n);
+    for (Size i=0; i < n; ++i) {
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+        sigma[i] = 0.2 + 0.1*std::sin(0.7*i);
+    }
+
+    const Real a = -0.05, b = 1.0;
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        const TripleBandLinearOp op =
+            SecondDerivativeOp(direction, mesher).mult(sigma)
+            .add(FirstDerivativeOp(direction, mesher));
+
+        const Array r = b*u + a*op.apply(u);
+        const Array t = op.solve_splitting(r, a, b);
+
+        for (Size i=0; i < n; ++i) {
+            if (std::fabs(u[i] - t[i]) > 1e-10) {
+                BOOST_FAIL("solve and apply are not consistent "
+                    << "\n direction     : " << direction
+                    << "\n index         : " << i
+                    << "\n expected      : " << u[i]
+                    << "\n calculated    : " << t[i]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdmHestonBarrier) {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1196,6 +1243,178 @@ BOOST_AUTO_TEST_CASE(testFdmHestonHullWhiteOp, *precondition(if_speed(Fast))) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testInPlaceOperatorApplication) {
+    BOOST_TEST_MESSAGE("Testing in-place application of FDM operators...");
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Size> dim = {21, 11, 9};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries = {
+        {3.5, 5.5}, {0.0, 0.5}, {-0.1, 0.1}};
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+        = createHestonHullWhite(1.0);
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+        = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    ext::shared_ptr<FdmLinearOpComposite> op(
+        new FdmHestonHullWhiteOp(mesher, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta()));
+    op->setTime(0.5, 0.6);
+
+    const Size n = layout->size();
+    Array r(n);
+    for (Size i=0; i < n; ++i)
+        r[i] = std::sin(0.1*i) + 0.5*std::cos(0.37*i);
+
+    // the output arrays are reused on purpose, and start empty
+    Array out, expected;
+    const auto check = [&](const std::string& method) {
+        if (out.size() != expected.size())
+            BOOST_FAIL(method << ": wrong size of result"
+                       << "\n    size:     " << out.size()
+                       << "\n    expected: " << expected.size());
+        for (Size i=0; i < n; ++i) {
+            if (std::fabs(out[i] - expected[i]) > 1e-12*std::max(1.0, std::fabs(expected[i])))
+                BOOST_FAIL(method << ": in-place result differs"
+                           << std::setprecision(16)
+                           << "\n    index:      " << i
+                           << "\n    calculated: " << out[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+    };
+
+    for (Size k=0; k < 2; ++k) {
+        expected = op->apply(r);
+        op->apply_into(r, out);
+        check("apply");
+
+        expected = op->apply_mixed(r);
+        op->apply_mixed_into(r, out);
+        check("apply_mixed");
+
+        for (Size d=0; d < op->size(); ++d) {
+            expected = op->apply_direction(d, r);
+            op->apply_direction_into(d, r, out);
+            check("apply_direction");
+
+            expected = op->solve_splitting(d, r, -0.01);
+            op->solve_splitting_into(d, r, -0.01, out);
+            check("solve_splitting");
+        }
+    }
+
+    // one step of the Douglas and Hundsdorfer schemes, written
+    // with the operators returning their results
+    const Time t = 0.6, dt = 0.1;
+    const Real theta = 0.5+std::sqrt(3.0)/6., mu = 0.5;
+
+    op->setTime(t-dt, t);
+    Array y = r + dt*op->apply(r);
+    for (Size d=0; d < op->size(); ++d)
+        y = op->solve_splitting(d, y - theta*dt*op->apply_direction(d, r), -theta*dt);
+
+    out = r;
+    DouglasScheme douglas(theta, op);
+    douglas.setStep(dt);
+    douglas.step(out, t);
+    expected = y;
+    check("Douglas scheme");
+
+    Array yt = (r + dt*op->apply(r)) + mu*dt*op->apply(y-r);
+    for (Size d=0; d < op->size(); ++d)
+        yt = op->solve_splitting(d, yt - theta*dt*op->apply_direction(d, y), -theta*dt);
+
+    out = r;
+    HundsdorferScheme hundsdorfer(theta, mu, op);
+    hundsdorfer.setStep(dt);
+    // a second step reuses the scheme workspace
+    for (Size k=0; k < 2; ++k) {
+        out = r;
+        hundsdorfer.step(out, t);
+        expected = yt;
+        check("Hundsdorfer scheme");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentOperatorApplication) {
+    BOOST_TEST_MESSAGE("Testing concurrent application of FDM operators...");
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Size> dim = {21, 11, 9};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries = {
+        {3.5, 5.5}, {0.0, 0.5}, {-0.1, 0.1}};
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+        = createHestonHullWhite(1.0);
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+        = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    FdmHestonHullWhiteOp op(mesher, jointProcess->hestonProcess(),
+                            hwProcess, jointProcess->eta());
+    op.setTime(0.5, 0.6);
+
+    // each thread applies the same operator to its own array
+    const Size threads = 4, n = layout->size();
+    std::vector<Array> r(threads, Array(n));
+    std::vector<std::vector<Array> > expected(threads), calculated(threads);
+    for (Size k=0; k < threads; ++k) {
+        for (Size i=0; i < n; ++i)
+            r[k][i] = std::sin(0.1*i + k) + 0.5*std::cos(0.37*i);
+        expected[k].push_back(op.apply(r[k]));
+        for (Size d=0; d < op.size(); ++d)
+            expected[k].push_back(op.solve_splitting(d, r[k], -0.01));
+    }
+
+    std::vector<std::thread> workers;
+    for (Size k=0; k < threads; ++k) {
+        workers.emplace_back([&, k]() {
+            Array out;
+            for (Size iteration=0; iteration < 20; ++iteration) {
+                calculated[k].clear();
+                op.apply_into(r[k], out);
+                calculated[k].push_back(out);
+                for (Size d=0; d < op.size(); ++d) {
+                    op.solve_splitting_into(d, r[k], -0.01, out);
+                    calculated[k].push_back(out);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    for (Size k=0; k < threads; ++k) {
+        for (Size j=0; j < expected[k].size(); ++j) {
+            for (Size i=0; i < n; ++i) {
+                if (calculated[k][j][i] != expected[k][j][i])
+                    BOOST_FAIL("concurrent result differs"
+                               << std::setprecision(16)
+                               << "\n    thread:     " << k
+                               << "\n    result:     " << j
+                               << "\n    index:      " << i
+                               << "\n    calculated: " << calculated[k][j][i]
+                               << "\n    expected:   " << expected[k][j][i]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testBiCGstab) {
     BOOST_TEST_MESSAGE(
         "Testing bi-conjugated gradient stabilized algorithm...");
@@ -1441,6 +1660,116 @@ BOOST_AUTO_TEST_CASE(testSparseMatrixZeroAssignment) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCsrMatrix) {
+    BOOST_TEST_MESSAGE("Testing compressed sparse row matrices of FDM operators...");
+
+    const std::vector<Size> dim = {40, 20};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries = {{3.8, 4.905274778}, {0.0, 1.0}};
+    ext::shared_ptr<FdmMesher> mesher(new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(ext::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+    ext::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    FdmHestonOp op(mesher, hestonProcess);
+    op.setTime(0.5, 0.6);
+
+    // the band operators assemble their matrices directly, the
+    // composite one converts its ublas representation
+    const SecondDerivativeOp dxx(0, mesher);
+    const SecondOrderMixedDerivativeOp dxy(0, 1, mesher);
+
+    const Size n = layout->size();
+    const SparseMatrix expected = op.toMatrix() + dxx.toMatrix() + dxy.toMatrix();
+    const CsrMatrix calculated = op.toCsrMatrix() + dxx.toCsrMatrix() + dxy.toCsrMatrix();
+
+    if (calculated.rows() != n || calculated.columns() != n)
+        BOOST_FAIL("wrong dimensions of the CSR matrix");
+
+    for (Size i=0; i < n; ++i) {
+        for (Size j=0; j < n; ++j) {
+            if (std::fabs(calculated(i, j) - Real(expected(i, j))) > 1e-12) {
+                BOOST_FAIL("CSR matrix differs from the ublas matrix in " <<
+                           "element (" << i << ", " << j << ")" <<
+                           "\n expected  : " << Real(expected(i, j)) <<
+                           "\n calculated: " << calculated(i, j));
+            }
+        }
+    }
+
+    Array r(n);
+    for (Size i=0; i < n; ++i)
+        r[i] = std::sin(0.1*i) + 0.5*std::cos(0.37*i);
+
+    const Array applied = op.apply(r) + dxx.apply(r) + dxy.apply(r);
+    const Array product = prod(calculated, r);
+    for (Size i=0; i < n; ++i) {
+        if (std::fabs(product[i] - applied[i]) > 1e-10*std::max(1.0, std::fabs(applied[i])))
+            BOOST_FAIL("CSR matrix-vector product differs from operator application" <<
+                       "\n index:      " << i <<
+                       "\n expected:   " << applied[i] <<
+                       "\n calculated: " << product[i]);
+    }
+
+    // the incomplete factorization of a tridiagonal matrix is exact
+    CsrMatrix m = (-0.1)*SecondDerivativeOp(0, mesher).toCsrMatrix();
+    m.addToDiagonal(1.0);
+    const CsrILUPreconditioner ilu(m);
+    const Array x = ilu.apply(r);
+    const Array residual = r - prod(m, x);
+    const Real error = std::sqrt(DotProduct(residual, residual)/DotProduct(r, r));
+    if (error > 1e-12)
+        BOOST_FAIL("ILU(0) of a tridiagonal matrix is not exact" <<
+                   "\n error: " << error);
+
+    const BiCGstab biCGstab(
+        [&](const Array& v) { return prod(m, v); }, n, 1e-10,
+        [&](const Array& v) { return ilu.apply(v); });
+    const BiCGStabResult result = biCGstab.solve(r);
+    if (result.iterations > 1)
+        BOOST_FAIL("BiCGstab with exact preconditioner needed "
+                   << result.iterations << " iterations");
+
+    // the compressed row storage is checked on construction
+    BOOST_CHECK_THROW((CsrMatrix(3, {0, 2, 3}, {1, 0, 2}, {1.0, 2.0, 3.0})), Error);
+    BOOST_CHECK_THROW((CsrMatrix(3, {0, 2, 3}, {1, 1, 2}, {1.0, 2.0, 3.0})), Error);
+    BOOST_CHECK_THROW((CsrMatrix(3, {0, 2, 3}, {0, 3, 2}, {1.0, 2.0, 3.0})), Error);
+    BOOST_CHECK_THROW((CsrMatrix(3, {0, 2, 1, 3}, {0, 1, 2}, {1.0, 2.0, 3.0})), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testCsrMatrixAddToDiagonal) {
+    BOOST_TEST_MESSAGE("Testing addition to the diagonal of CSR matrices "
+                       "with missing diagonal entries...");
+
+    // the diagonal of the first rows is stored, the one of the
+    // last row is not
+    const CsrMatrix a(3, {0, 2, 4, 5}, {0, 1, 0, 1, 0},
+                      {1.0, 2.0, 3.0, 4.0, 5.0});
+
+    CsrMatrix m = a;
+    m.addToDiagonal(0.5);
+
+    const Real expected[3][3] = { { 1.5, 2.0, 0.0 },
+                                  { 3.0, 4.5, 0.0 },
+                                  { 5.0, 0.0, 0.5 } };
+    for (Size i=0; i < 3; ++i) {
+        for (Size j=0; j < 3; ++j) {
+            if (m(i, j) != expected[i][j])
+                BOOST_FAIL("wrong element (" << i << ", " << j << ")"
+                           " after addition to the diagonal"
+                           << "\n expected  : " << expected[i][j]
+                           << "\n calculated: " << m(i, j));
+        }
+    }
+    if (m.nonZeros() != a.nonZeros() + 1)
+        BOOST_FAIL("the missing diagonal entry was not added to the pattern"
+                   << "\n expected non-zeros  : " << a.nonZeros() + 1
+                   << "\n calculated non-zeros: " << m.nonZeros());
+}
+
 BOOST_AUTO_TEST_CASE(testFdmMesherIntegral) {
     BOOST_TEST_MESSAGE("Testing integrals over meshers functions...");
 
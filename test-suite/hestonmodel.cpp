@@ -31,6 +31,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
@@ -40,6 +41,7 @@
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/exponentialfittinghestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -58,6 +60,7 @@
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/period.hpp>
 #include <cmath>
+#include <map>
 #include <utility>
 
 using namespace QuantLib;
@@ -372,6 +375,390 @@ BOOST_AUTO_TEST_CASE(testDAXCalibration) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testParallelCalibration) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with concurrent helpers...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options =
+        marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const Array initialParams = model->params();
+    const auto calibrate = [&](Size threads) {
+        model->setParams(initialParams);
+        model->setCalibrationThreads(threads);
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+        return model->params();
+    };
+
+    // a single engine shared by all helpers: they are evaluated
+    // by the same thread, one after the other
+    const ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(engine);
+
+    const Array expected = calibrate(1);
+    const auto check = [&](Size threads) {
+        const Array calculated = calibrate(threads);
+
+        for (Size i=0; i < expected.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > 1e-12)
+                BOOST_ERROR("Failed to reproduce serial calibration"
+                            << std::setprecision(12)
+                            << "\n    threads:    " << threads
+                            << "\n    parameter:  " << i
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+        }
+    };
+
+    check(4);
+
+    // one engine per maturity, shared by the helpers of that maturity
+    // and reusing their integration slices; the maturities are
+    // evaluated concurrently
+    std::map<Time, ext::shared_ptr<PricingEngine> > engines;
+    for (const auto& option : options) {
+        const auto helper =
+            ext::dynamic_pointer_cast<HestonModelHelper>(option);
+        ext::shared_ptr<PricingEngine>& e = engines[helper->maturity()];
+        if (e == nullptr)
+            e = ext::make_shared<AnalyticHestonEngine>(model, 64);
+        helper->setPricingEngine(e);
+    }
+
+    for (Size threads : {1, 2, 4})
+        check(threads);
+}
+
+BOOST_AUTO_TEST_CASE(testBatchPricing) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston pricing of all strikes of a maturity at once...");
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7)));
+
+    const ext::shared_ptr<AnalyticHestonEngine> referenceEngine =
+        ext::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLobatto(1e-12, 1e-14, 100000));
+
+    const auto gatheral = ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Integration::gaussLegendre(256));
+    const auto optimalCV = ext::make_shared<AnalyticHestonEngine>(model, 144);
+    const auto andersenPiterbarg = ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::AndersenPiterbarg,
+        AnalyticHestonEngine::Integration::gaussLaguerre(128));
+    // the contour angle changes with the strike
+    const auto angledContour = ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::AngledContour,
+        AnalyticHestonEngine::Integration::gaussLaguerre(144));
+    const auto cos = ext::make_shared<COSHestonEngine>(model, 25, 600);
+    const auto exponentialFitting =
+        ext::make_shared<ExponentialFittingHestonEngine>(model);
+
+    std::vector<ext::shared_ptr<PlainVanillaPayoff> > payoffs;
+    for (Real strike = 50.0; strike <= 200.0; strike += 10.0)
+        payoffs.push_back(ext::make_shared<PlainVanillaPayoff>(
+            (strike < 100.0) ? Option::Put : Option::Call, strike));
+
+    const auto check = [&](const std::string& name,
+                           const std::vector<Real>& calculated,
+                           const Date& maturity) {
+        for (Size i=0; i < payoffs.size(); ++i) {
+            const Real expected =
+                referenceEngine->priceVanillaPayoff(payoffs[i], maturity);
+            if (std::fabs(calculated[i] - expected) > 1e-7)
+                BOOST_ERROR("Failed to price strikes of a maturity at once"
+                            << std::setprecision(12)
+                            << "\n    engine:     " << name
+                            << "\n    maturity:   " << maturity
+                            << "\n    strike:     " << payoffs[i]->strike()
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected);
+        }
+    };
+
+    const Array params = model->params();
+    for (Size k=0; k < 2; ++k) {
+        // the characteristic functions kept by the engines
+        // must not survive a change of the model parameters
+        if (k == 1)
+            model->setParams({0.05, 0.6, 0.4, -0.4, 0.08});
+
+        for (const Period& p: {1*Months, 1*Years, 5*Years}) {
+            const Date maturity = settlementDate + p;
+
+            check("Gatheral",
+                  gatheral->priceVanillaPayoffs(payoffs, maturity), maturity);
+            check("OptimalCV",
+                  optimalCV->priceVanillaPayoffs(payoffs, maturity), maturity);
+            check("AndersenPiterbarg",
+                  andersenPiterbarg->priceVanillaPayoffs(payoffs, maturity),
+                  maturity);
+            check("AngledContour",
+                  angledContour->priceVanillaPayoffs(payoffs, maturity),
+                  maturity);
+            check("COS", cos->priceVanillaPayoffs(payoffs, maturity), maturity);
+            check("ExponentialFitting",
+                  exponentialFitting->priceVanillaPayoffs(payoffs, maturity),
+                  maturity);
+
+            const ext::shared_ptr<Exercise> exercise =
+                ext::make_shared<EuropeanExercise>(maturity);
+            std::vector<Real> npvs;
+            for (const auto& payoff: payoffs) {
+                VanillaOption option(payoff, exercise);
+                option.setPricingEngine(optimalCV);
+                npvs.push_back(option.NPV());
+            }
+            check("OptimalCV, single options", npvs, maturity);
+        }
+    }
+    model->setParams(params);
+
+    // the number of cached slices is bounded; the ones dropped
+    // are calculated again when needed
+    std::vector<Real> first;
+    for (Size i=1; i <= 400; ++i) {
+        const Date maturity = settlementDate + i*Weeks;
+        const std::vector<Real> npvs =
+            angledContour->priceVanillaPayoffs(payoffs, maturity);
+        if (i == 1)
+            first = npvs;
+    }
+    const std::vector<Real> again = angledContour->priceVanillaPayoffs(
+        payoffs, settlementDate + 1*Weeks);
+    for (Size i=0; i < payoffs.size(); ++i) {
+        if (again[i] != first[i])
+            BOOST_ERROR("Failed to reproduce price after dropping the slices"
+                        << std::setprecision(16)
+                        << "\n    strike:     " << payoffs[i]->strike()
+                        << "\n    calculated: " << again[i]
+                        << "\n    expected:   " << first[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testAnalyticGradients) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing analytic gradients of Heston and Bates prices...");
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const auto hestonModel = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7));
+
+    const auto batesModel = ext::make_shared<BatesModel>(
+        ext::make_shared<BatesProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7,
+            0.5, -0.1, 0.15));
+
+    ConstantParameter theta(0.05, PositiveConstraint());
+    ConstantParameter sigma(0.6, PositiveConstraint());
+    ConstantParameter rho(-0.7, BoundaryConstraint(-1.0, 1.0));
+    PiecewiseConstantParameter kappa(std::vector<Time>(1, 0.5),
+                                     PositiveConstraint());
+    kappa.setParam(0, 1.5);
+    kappa.setParam(1, 3.0);
+
+    const std::vector<Time> modelTimes = {0.25, 0.5, 1.0, 5.0};
+    const auto ptdModel = ext::make_shared<PiecewiseTimeDependentHestonModel>(
+        riskFreeTS, dividendTS, s0, 0.04, theta, kappa, sigma, rho,
+        TimeGrid(modelTimes.begin(), modelTimes.end()));
+
+    const auto hestonLaguerre =
+        ext::make_shared<AnalyticHestonEngine>(hestonModel, 144);
+    const auto hestonLobatto = ext::make_shared<AnalyticHestonEngine>(
+        hestonModel, AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Integration::gaussLobatto(1e-12, 1e-14, 100000));
+    const auto bates = ext::make_shared<BatesEngine>(batesModel, 144);
+    const auto ptd = ext::make_shared<AnalyticPTDHestonEngine>(ptdModel, 144);
+
+    const auto check = [&](const std::string& name,
+                           CalibratedModel& model,
+                           const ext::shared_ptr<PricingEngine>& engine,
+                           const std::function<Array(
+                               const ext::shared_ptr<PlainVanillaPayoff>&,
+                               const Date&)>& gradient) {
+        const Array params = model.params();
+
+        for (const Period& p: {3*Months, 1*Years, 3*Years}) {
+            const Date maturity = settlementDate + p;
+            for (Real strike: {80.0, 100.0, 120.0}) {
+                const auto payoff = ext::make_shared<PlainVanillaPayoff>(
+                    (strike < 100.0) ? Option::Put : Option::Call, strike);
+
+                VanillaOption option(
+                    payoff, ext::make_shared<EuropeanExercise>(maturity));
+                option.setPricingEngine(engine);
+
+                const Array calculated = gradient(payoff, maturity);
+                BOOST_REQUIRE(calculated.size() == params.size());
+
+                for (Size i=0; i < params.size(); ++i) {
+                    const Real h = 1e-5;
+                    Array x = params;
+                    x[i] += h;
+                    model.setParams(x);
+                    const Real up = option.NPV();
+                    x[i] -= 2*h;
+                    model.setParams(x);
+                    const Real down = option.NPV();
+                    model.setParams(params);
+
+                    const Real expected = (up - down)/(2*h);
+                    if (std::fabs(calculated[i] - expected) > 1e-5)
+                        BOOST_ERROR("Failed to reproduce price gradient"
+                                    << std::setprecision(12)
+                                    << "\n    engine:     " << name
+                                    << "\n    maturity:   " << maturity
+                                    << "\n    strike:     " << strike
+                                    << "\n    parameter:  " << i
+                                    << "\n    calculated: " << calculated[i]
+                                    << "\n    expected:   " << expected);
+                }
+            }
+        }
+    };
+
+    check("Heston, Gauss-Laguerre", *hestonModel, hestonLaguerre,
+          [&](const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+              const Date& maturity) {
+              return hestonLaguerre->priceVanillaPayoffGradient(
+                  payoff, maturity);
+          });
+    check("Heston, Gauss-Lobatto", *hestonModel, hestonLobatto,
+          [&](const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+              const Date& maturity) {
+              return hestonLobatto->priceVanillaPayoffGradient(
+                  payoff, maturity);
+          });
+    check("Bates", *batesModel, bates,
+          [&](const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+              const Date& maturity) {
+              return bates->priceVanillaPayoffGradient(payoff, maturity);
+          });
+    check("piecewise time dependent Heston", *ptdModel, ptd,
+          [&](const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+              const Date& maturity) {
+              return ptd->priceVanillaPayoffGradient(payoff, maturity);
+          });
+
+    // engines with add-on terms without gradient, or with further
+    // model parameters, don't provide the price gradient
+    const auto detJumpModel = ext::make_shared<BatesDetJumpModel>(
+        ext::make_shared<BatesProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7,
+            0.5, -0.1, 0.15));
+    const auto detJump = ext::make_shared<BatesDetJumpEngine>(detJumpModel);
+    const auto batesWithDetJumpModel = ext::make_shared<BatesEngine>(detJumpModel);
+
+    BOOST_CHECK(hestonLaguerre->hasPriceGradient());
+    BOOST_CHECK(hestonLobatto->hasPriceGradient());
+    BOOST_CHECK(bates->hasPriceGradient());
+    BOOST_CHECK(!detJump->hasPriceGradient());
+    BOOST_CHECK(!batesWithDetJumpModel->hasPriceGradient());
+    BOOST_CHECK_THROW(
+        detJump->priceVanillaPayoffGradient(
+            ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+            settlementDate + 1*Years),
+        Error);
+}
+
+BOOST_AUTO_TEST_CASE(testCalibrationWithAnalyticJacobian) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with analytic Jacobian...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options =
+        marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+            ->setPricingEngine(engine);
+
+    const Array initialParams = model->params();
+    const auto calibrate = [&](bool useCostFunctionsJacobian) {
+        model->setParams(initialParams);
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8, useCostFunctionsJacobian);
+        model->calibrate(options, om,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        Real sse = 0;
+        for (const auto& option : options) {
+            const Real diff = option->calibrationError()*100.0;
+            sse += diff*diff;
+        }
+        return sse;
+    };
+
+    for (const auto& option : options)
+        BOOST_REQUIRE(option->hasCalibrationErrorGradient());
+
+    const Real expected = calibrate(false);
+    const Real calculated = calibrate(true);
+
+    if (std::fabs(calculated - expected) > 0.1)
+        BOOST_ERROR("Failed to reproduce calibration error "
+                    "with analytic Jacobian"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    // no analytic gradient with the COS engine
+    const auto helper =
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(options.front());
+    helper->setPricingEngine(ext::make_shared<COSHestonEngine>(model));
+    BOOST_CHECK(!helper->hasCalibrationErrorGradient());
+}
+
 BOOST_AUTO_TEST_CASE(testAnalyticVsBlack) {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -26,6 +26,7 @@
 #include <ql/math/randomnumbers/burley2020sobolrsg.hpp>
 #include <ql/math/randomnumbers/faurersg.hpp>
 #include <ql/math/randomnumbers/haltonrsg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/primitivepolynomials.hpp>
@@ -1068,6 +1069,148 @@ BOOST_AUTO_TEST_CASE(testSobolSkipping) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBurley2020SobolSkipping) {
+
+    BOOST_TEST_MESSAGE("Testing scrambled Sobol sequence skipping...");
+
+    Size dimensionality[] = { 1, 10, 100 };
+    std::uint32_t skip[] = { 0, 1, 42, 512 };
+
+    for (Size dim : dimensionality) {
+        for (std::uint32_t k : skip) {
+
+            // extract k+1 samples
+            Burley2020SobolRsg rsg1(dim);
+            std::vector<std::uint32_t> s1;
+            for (Size l = 0; l <= k; l++)
+                s1 = rsg1.nextInt32Sequence();
+
+            // skip to the k-th sample at once
+            Burley2020SobolRsg rsg2(dim);
+            std::vector<std::uint32_t> s2 = rsg2.skipTo(k);
+
+            // compare the skipped and the next 10 samples
+            for (Size m = 0; m <= 10; m++) {
+                if (s1 != s2)
+                    BOOST_ERROR("Mismatch after skipping:"
+                                << "\n  size:     " << dim
+                                << "\n  skipped:  " << k
+                                << "\n  sample:   " << m);
+                s1 = rsg1.nextInt32Sequence();
+                s2 = rsg2.nextInt32Sequence();
+            }
+        }
+    }
+}
+
+namespace {
+
+    template <class USG>
+    void checkNextSample(const std::string& name, const USG& usg) {
+        // reference samples
+        USG rsg1(usg);
+        std::vector<std::vector<std::uint32_t>> expected(100);
+        for (auto& s : expected)
+            s = rsg1.nextInt32Sequence();
+
+        Size starts[] = { 0, 1, 42, 99 };
+        for (Size first : starts) {
+            for (Size used : { 0, 10 }) {
+                USG rsg2(usg);
+                for (Size i = 0; i < used; ++i)
+                    rsg2.nextInt32Sequence();
+                rsg2.setNextSample(static_cast<std::uint32_t>(first));
+                for (Size i = first; i < expected.size(); ++i) {
+                    if (rsg2.nextInt32Sequence() != expected[i])
+                        BOOST_FAIL(name << ": mismatch after setting the next sample"
+                                   << "\n  next sample:   " << first
+                                   << "\n  samples drawn: " << used
+                                   << "\n  at sample:     " << i);
+                }
+            }
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testSettingNextSample) {
+
+    BOOST_TEST_MESSAGE("Testing setting the next low-discrepancy sample...");
+
+    checkNextSample("Sobol", SobolRsg(10, 42));
+    checkNextSample("Sobol without Gray code",
+                    SobolRsg(10, 42, SobolRsg::JoeKuoD7, false));
+    checkNextSample("Burley2020 Sobol", Burley2020SobolRsg(10));
+}
+
+namespace {
+
+    template <class USG>
+    void checkGaussianBlocks(const std::string& name, const USG& usg) {
+        typedef InverseCumulativeRsg<USG, InverseCumulativeNormal> rsg_type;
+        const Size dim = usg.dimension(), samples = 1000;
+        const Real tolerance = 1.0e-15;
+
+        // one sample at a time...
+        rsg_type rsg(usg);
+        Matrix expected(samples, dim);
+        for (Size i = 0; i < samples; ++i) {
+            const std::vector<Real>& x = rsg.nextSequence().value;
+            std::copy(x.begin(), x.end(), expected.row_begin(i));
+        }
+
+        // ...or all at once
+        Matrix block(samples, dim);
+        rsg_type(usg).nextSequences(block);
+        for (Size i = 0; i < samples; ++i) {
+            for (Size j = 0; j < dim; ++j) {
+                if (std::fabs(block[i][j] - expected[i][j]) > tolerance)
+                    BOOST_FAIL(name << ": mismatch in block of samples"
+                               << "\n  sample:     " << i
+                               << "\n  dimension:  " << j
+                               << "\n  expected:   " << expected[i][j]
+                               << "\n  calculated: " << block[i][j]);
+            }
+        }
+
+        // blocks drawn by separate workers after skipping
+        Size starts[] = { 0, 1, 250, 999 };
+        for (Size first : starts) {
+            rsg_type worker(usg);
+            if (first == 999) {
+                // skipping must also work on a generator already in use
+                for (Size i = 0; i < 10; ++i)
+                    worker.nextSequence();
+            }
+            worker.skipTo(first);
+            Matrix part(samples - first, dim);
+            worker.nextSequences(part);
+            for (Size i = 0; i < part.rows(); ++i) {
+                for (Size j = 0; j < dim; ++j) {
+                    if (std::fabs(part[i][j] - expected[first+i][j]) > tolerance)
+                        BOOST_FAIL(name << ": mismatch in block after skipping"
+                                   << "\n  skipped to: " << first
+                                   << "\n  sample:     " << first + i
+                                   << "\n  dimension:  " << j
+                                   << "\n  expected:   " << expected[first+i][j]
+                                   << "\n  calculated: " << part[i][j]);
+                }
+            }
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testGaussianSobolBlocks) {
+
+    BOOST_TEST_MESSAGE("Testing blocks of Gaussian low-discrepancy samples...");
+
+    for (Size dim : { 1, 7, 64 }) {
+        checkGaussianBlocks("Sobol", SobolRsg(dim, 42));
+        checkGaussianBlocks("Burley2020 Sobol", Burley2020SobolRsg(dim, 42));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testHighDimensionalIntegrals, *precondition(if_speed(Slow))) {
     BOOST_TEST_MESSAGE("Testing high-dimensional integrals...");
 
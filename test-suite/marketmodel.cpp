@@ -26,6 +26,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
@@ -43,6 +44,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcblock.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -108,6 +110,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/products/pathwise/pathwiseproductinversefloater.hpp>
 #include <ql/models/marketmodels/products/multistep/multisteppathwisewrapper.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <sstream>
 
@@ -4528,6 +4531,213 @@ BOOST_AUTO_TEST_CASE(testDriftCalculator) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testParallelAccountingEngine) {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded accounting engine "
+                       "against the serial one...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    product.finalize();
+
+    const EvolutionDescription& evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarketPlus);
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3, ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    Size paths = 1000;
+
+    std::vector<ext::shared_ptr<BrownianGeneratorFactory> > generatorFactories = {
+        ext::make_shared<MTBrownianGeneratorFactory>(seed_),
+        ext::make_shared<SobolBrownianGeneratorFactory>(
+            SobolBrownianGenerator::Diagonal, seed_),
+        ext::make_shared<Burley2020SobolBrownianGeneratorFactory>(
+            SobolBrownianGenerator::Diagonal, seed_)
+    };
+    std::string generatorNames[] = { "MT", "Sobol", "Burley 2020 Sobol" };
+    EvolverType evolvers[] = { Pc, Balland };
+    Size threads[] = { 1, 2, 3, 8 };
+
+    for (Size k=0; k<generatorFactories.size(); ++k) {
+        for (auto evolverType : evolvers) {
+            std::atomic<Size> evolversBuilt(0);
+            ParallelAccountingEngine::EvolverFactory evolverFactory =
+                [&, evolverType](const BrownianGeneratorFactory& factory) {
+                    ++evolversBuilt;
+                    return makeMarketModelEvolver(marketModel, numeraires,
+                                                  factory, evolverType);
+                };
+
+            AccountingEngine serialEngine(evolverFactory(*generatorFactories[k]),
+                                          product, initialNumeraireValue);
+            SequenceStatisticsInc expected(product.numberOfProducts());
+            serialEngine.multiplePathValues(expected, paths);
+
+            for (auto n : threads) {
+                ParallelAccountingEngine engine(evolverFactory, generatorFactories[k],
+                                                product, initialNumeraireValue, n);
+                SequenceStatisticsInc calculated(product.numberOfProducts());
+                // later calls must continue the sequence of paths, also
+                // after a call with fewer paths than threads
+                evolversBuilt = 0;
+                engine.multiplePathValues(calculated, paths/3);
+                engine.multiplePathValues(calculated, 2);
+                engine.multiplePathValues(calculated, paths - paths/3 - 2);
+
+                // the evolvers are kept between calls
+                if (evolversBuilt > n)
+                    BOOST_ERROR("evolvers rebuilt between calls"
+                                << "\n    generator:  " << generatorNames[k]
+                                << "\n    evolver:    " << evolverTypeToString(evolverType)
+                                << "\n    threads:    " << n
+                                << "\n    built:      " << evolversBuilt.load());
+
+                std::vector<Real> expectedMeans = expected.mean();
+                std::vector<Real> calculatedMeans = calculated.mean();
+                std::vector<Real> expectedErrors = expected.errorEstimate();
+                std::vector<Real> calculatedErrors = calculated.errorEstimate();
+                for (Size i=0; i<product.numberOfProducts(); ++i) {
+                    if (calculatedMeans[i] != expectedMeans[i]
+                        || calculatedErrors[i] != expectedErrors[i])
+                        BOOST_ERROR("failed to reproduce serial results"
+                                    << "\n    generator:  " << generatorNames[k]
+                                    << "\n    evolver:    " << evolverTypeToString(evolverType)
+                                    << "\n    threads:    " << n
+                                    << "\n    product:    " << i
+                                    << std::setprecision(16)
+                                    << "\n    serial:     " << expectedMeans[i]
+                                    << " +/- " << expectedErrors[i]
+                                    << "\n    parallel:   " << calculatedMeans[i]
+                                    << " +/- " << calculatedErrors[i]);
+                }
+            }
+        }
+    }
+
+    // a failed call leaves the engine usable: the next call
+    // simulates the same paths again from new evolvers
+    for (Size k=0; k<generatorFactories.size(); ++k) {
+        std::atomic<Size> evolversBuilt(0);
+        bool failing = true;
+        ParallelAccountingEngine::EvolverFactory evolverFactory =
+            [&](const BrownianGeneratorFactory& factory) {
+                QL_REQUIRE(!(failing && ++evolversBuilt == 2),
+                           "evolver construction failed");
+                return makeMarketModelEvolver(marketModel, numeraires,
+                                              factory, Pc);
+            };
+
+        failing = false;
+        AccountingEngine serialEngine(evolverFactory(*generatorFactories[k]),
+                                      product, initialNumeraireValue);
+        SequenceStatisticsInc expected(product.numberOfProducts());
+        serialEngine.multiplePathValues(expected, paths/3);
+        serialEngine.multiplePathValues(expected, paths - paths/3);
+
+        failing = true;
+        ParallelAccountingEngine engine(evolverFactory, generatorFactories[k],
+                                        product, initialNumeraireValue, 3);
+        SequenceStatisticsInc calculated(product.numberOfProducts());
+        BOOST_CHECK_THROW(engine.multiplePathValues(calculated, paths/3), Error);
+        failing = false;
+        engine.multiplePathValues(calculated, paths/3);
+        engine.multiplePathValues(calculated, paths - paths/3);
+
+        std::vector<Real> expectedMeans = expected.mean();
+        std::vector<Real> calculatedMeans = calculated.mean();
+        for (Size i=0; i<product.numberOfProducts(); ++i) {
+            if (calculatedMeans[i] != expectedMeans[i])
+                BOOST_ERROR("failed to reproduce serial results after an error"
+                            << "\n    generator:  " << generatorNames[k]
+                            << "\n    product:    " << i
+                            << std::setprecision(16)
+                            << "\n    serial:     " << expectedMeans[i]
+                            << "\n    parallel:   " << calculatedMeans[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testBlockEvolver) {
+
+    BOOST_TEST_MESSAGE("Testing predictor-corrector evolution "
+                       "of blocks of paths...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    product.finalize();
+
+    const EvolutionDescription& evolution = product.evolution();
+    // not a multiple of the block sizes
+    Size paths = 101;
+
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    MeasureType measures[] = { MoneyMarket, Terminal };
+    Size blockSizes[] = { 1, 8, 16 };
+
+    for (auto factors : testedFactors) {
+        ext::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, factors,
+                            ExponentialCorrelationAbcdVolatility);
+        for (auto measure : measures) {
+            std::vector<Size> numeraires = makeMeasure(product, measure);
+            Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+            for (Size k=0; k<2; ++k) {
+                ext::shared_ptr<BrownianGeneratorFactory> generatorFactory;
+                if (k == 0)
+                    generatorFactory = ext::make_shared<MTBrownianGeneratorFactory>(seed_);
+                else
+                    generatorFactory = ext::make_shared<SobolBrownianGeneratorFactory>(
+                        SobolBrownianGenerator::Diagonal, seed_);
+
+                auto evolver = ext::make_shared<LogNormalFwdRatePc>(
+                    marketModel, *generatorFactory, numeraires);
+                AccountingEngine engine(evolver, product, initialNumeraireValue);
+                SequenceStatisticsInc expected(product.numberOfProducts());
+                engine.multiplePathValues(expected, paths);
+
+                for (auto blockSize : blockSizes) {
+                    auto blockEvolver = ext::make_shared<LogNormalFwdRatePcBlock>(
+                        marketModel, *generatorFactory, numeraires, 0, blockSize);
+                    AccountingEngine blockEngine(blockEvolver, product,
+                                                 initialNumeraireValue);
+                    SequenceStatisticsInc calculated(product.numberOfProducts());
+                    blockEngine.multiplePathValues(calculated, paths);
+
+                    // the paths, and thus the results, must be the same
+                    std::vector<Real> expectedMeans = expected.mean();
+                    std::vector<Real> calculatedMeans = calculated.mean();
+                    std::vector<Real> expectedErrors = expected.errorEstimate();
+                    std::vector<Real> calculatedErrors = calculated.errorEstimate();
+                    for (Size i=0; i<product.numberOfProducts(); ++i) {
+                        if (calculatedMeans[i] != expectedMeans[i]
+                            || calculatedErrors[i] != expectedErrors[i])
+                            BOOST_ERROR("failed to reproduce single-path evolution"
+                                        << "\n    factors:    " << factors
+                                        << "\n    measure:    " << measureTypeToString(measure)
+                                        << "\n    generator:  " << (k == 0 ? "MT" : "Sobol")
+                                        << "\n    block size: " << blockSize
+                                        << "\n    product:    " << i
+                                        << std::setprecision(16)
+                                        << "\n    single:     " << expectedMeans[i]
+                                        << " +/- " << expectedErrors[i]
+                                        << "\n    block:      " << calculatedMeans[i]
+                                        << " +/- " << calculatedErrors[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testIsInSubset) {
 
     // Performance test for isInSubset function (temporary)
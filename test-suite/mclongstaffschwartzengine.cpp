@@ -222,6 +222,136 @@ BOOST_AUTO_TEST_CASE(testAmericanOption, *precondition(if_speed(Fast))) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMultiThreadedAmericanOption) {
+    BOOST_TEST_MESSAGE("Testing multi-threaded Monte-Carlo pricing "
+                       "of American options...");
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(36.0)),
+            Handle<YieldTermStructure>(
+                ext::make_shared<FlatForward>(today, 0.0, dayCounter)),
+            Handle<YieldTermStructure>(
+                ext::make_shared<FlatForward>(today, 0.06, dayCounter)),
+            Handle<BlackVolTermStructure>(
+                ext::make_shared<BlackConstantVol>(
+                    today, NullCalendar(), 0.2, dayCounter)));
+
+    VanillaOption americanOption(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    americanOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 401, 200));
+    const Real expected = americanOption.NPV();
+
+    const auto engine = [&](Size threads) {
+        return MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(20000)
+            .withSeed(42)
+            .withPolynomialOrder(3)
+            .withThreads(threads);
+    };
+
+    americanOption.setPricingEngine(engine(1));
+    const Real singleThreaded = americanOption.NPV();
+    const Real singleThreadedExProb =
+        americanOption.result<Real>("exerciseProbability");
+
+    for (Size threads : {2, 4}) {
+        americanOption.setPricingEngine(engine(threads));
+        const Real calculated = americanOption.NPV();
+        const Real errorEstimate = americanOption.errorEstimate();
+        const Real exerciseProbability =
+            americanOption.result<Real>("exerciseProbability");
+
+        // the tolerance allows for the low bias of the exercise
+        // strategy on 50 exercise dates
+        if (std::fabs(calculated - expected) > 0.05)
+            BOOST_ERROR("Failed to reproduce american option price"
+                        << "\n    threads:    " << threads
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated
+                        << " +/- " << errorEstimate);
+
+        if (std::fabs(exerciseProbability - singleThreadedExProb) > 0.015)
+            BOOST_ERROR("Failed to reproduce exercise probability"
+                        << "\n    threads:         " << threads
+                        << "\n    single-threaded: " << singleThreadedExProb
+                        << "\n    calculated:      " << exerciseProbability);
+
+        // the results only depend on the seed and the number of threads
+        americanOption.setPricingEngine(engine(threads));
+        if (americanOption.NPV() != calculated)
+            BOOST_ERROR("multi-threaded pricing is not reproducible"
+                        << "\n    threads: " << threads);
+
+        if (std::fabs(calculated - singleThreaded) > 4.0*errorEstimate)
+            BOOST_ERROR("multi-threaded price too far from single-threaded one"
+                        << "\n    threads:         " << threads
+                        << "\n    single-threaded: " << singleThreaded
+                        << "\n    calculated:      " << calculated);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testLeanCalibration) {
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration "
+                       "with lean storage...");
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(36.0)),
+            Handle<YieldTermStructure>(
+                ext::make_shared<FlatForward>(today, 0.0, dayCounter)),
+            Handle<YieldTermStructure>(
+                ext::make_shared<FlatForward>(today, 0.06, dayCounter)),
+            Handle<BlackVolTermStructure>(
+                ext::make_shared<BlackConstantVol>(
+                    today, NullCalendar(), 0.2, dayCounter)));
+
+    VanillaOption americanOption(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const auto engine = [&](bool lean) {
+        return MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(5000)
+            .withSeed(42)
+            .withPolynomialOrder(3)
+            .withLeanCalibration(lean);
+    };
+
+    americanOption.setPricingEngine(engine(false));
+    const Real expected = americanOption.NPV();
+    const Real expectedExProb =
+        americanOption.result<Real>("exerciseProbability");
+
+    americanOption.setPricingEngine(engine(true));
+    const Real calculated = americanOption.NPV();
+    const Real exerciseProbability =
+        americanOption.result<Real>("exerciseProbability");
+
+    // the stored data are the same, and so is the calibration
+    if (calculated != expected || exerciseProbability != expectedExProb)
+        BOOST_ERROR("lean calibration changes the results"
+                    << "\n    expected:   " << expected
+                    << " (exercise probability " << expectedExProb << ")"
+                    << "\n    calculated: " << calculated
+                    << " (exercise probability " << exerciseProbability << ")");
+}
+
 BOOST_AUTO_TEST_CASE(testAmericanMaxOption) {
 
     // reference values taken from
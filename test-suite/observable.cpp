@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
@@ -263,6 +264,164 @@ BOOST_AUTO_TEST_CASE(testMultiThreadingGlobalSettings) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(testConcurrentRegistration) {
+    BOOST_TEST_MESSAGE("Testing concurrent registration and notification "
+                       "of observers...");
+
+    const Size nThreads = 4;
+    const Size nObservers = 5000;
+
+    const ext::shared_ptr<SimpleQuote> quote(new SimpleQuote(-1.0));
+
+    // registration contends on the same observable while another
+    // thread keeps notifying it and the observers die concurrently
+    std::atomic<bool> done(false);
+    std::thread notifier([&]() {
+        Size i = 0;
+        while (!done)
+            quote->setValue(Real(++i));
+    });
+
+    std::vector<std::vector<ext::shared_ptr<MTUpdateCounter> > >
+        observers(nThreads);
+    std::vector<std::thread> workers;
+    for (Size t=0; t < nThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (Size i=0; i < nObservers; ++i) {
+                const ext::shared_ptr<MTUpdateCounter> observer =
+                    ext::make_shared<MTUpdateCounter>();
+                observer->registerWith(quote);
+                // registering twice must not duplicate notifications
+                observer->registerWith(quote);
+                if ((i % 2) == 0)
+                    observers[t].push_back(observer);
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    done = true;
+    notifier.join();
+
+    std::vector<int> counters;
+    for (const auto& v : observers)
+        for (const auto& observer : v)
+            counters.push_back(observer->counter());
+
+    quote->setValue(-2.0);
+
+    Size k = 0;
+    for (const auto& v : observers) {
+        for (const auto& observer : v) {
+            if (observer->counter() != counters[k++] + 1)
+                BOOST_FAIL("exactly one notification should have been sent");
+        }
+    }
+
+    observers.clear();
+    if (MTUpdateCounter::instanceCounter() != 0) {
+        BOOST_FAIL("observers were not released");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testRegistrationThroughput) {
+    BOOST_TEST_MESSAGE("Testing throughput of concurrent registration "
+                       "with a shared observable...");
+
+    const Size nRegistrations = 40000;
+    const ext::shared_ptr<SimpleQuote> quote(new SimpleQuote(-1.0));
+
+    // the same number of observers is registered with the shared
+    // quote, split among an increasing number of threads; the quote
+    // is notified now and then while the observers come and go
+    Real singleThreaded = 0.0;
+    for (Size nThreads : {1, 2, 4, 8}) {
+        const Size perThread = nRegistrations / nThreads;
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (Size t=0; t < nThreads; ++t) {
+            workers.emplace_back([&]() {
+                std::vector<ext::shared_ptr<MTUpdateCounter> > alive;
+                for (Size i=0; i < perThread; ++i) {
+                    alive.push_back(ext::make_shared<MTUpdateCounter>());
+                    alive.back()->registerWith(quote);
+                    if ((i % 64) == 63) {
+                        quote->setValue(Real(i));
+                        alive.clear();
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+        const std::chrono::duration<Real> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        const Real throughput = (perThread * nThreads) / elapsed.count();
+        if (nThreads == 1)
+            singleThreaded = throughput;
+        BOOST_TEST_MESSAGE("    " << nThreads << " threads: "
+                           << std::fixed << std::setprecision(0)
+                           << throughput << " registrations/s ("
+                           << std::setprecision(2)
+                           << throughput / singleThreaded << "x)");
+    }
+
+    if (MTUpdateCounter::instanceCounter() != 0) {
+        BOOST_FAIL("observers were not released");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testThreadLocalNotificationBatch) {
+    BOOST_TEST_MESSAGE("Testing that notification batches are local "
+                       "to their thread...");
+
+    const Size nQuotes = 100;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    const auto batched = ext::make_shared<MTUpdateCounter>();
+    for (Size i=0; i < nQuotes; ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.0));
+        batched->registerWith(quotes.back());
+    }
+    const auto otherQuote = ext::make_shared<SimpleQuote>(0.0);
+    const auto other = ext::make_shared<MTUpdateCounter>();
+    other->registerWith(otherQuote);
+
+    {
+        NotificationBatch batch;
+        for (Size i=0; i < nQuotes; ++i)
+            quotes[i]->setValue(Real(i+1));
+
+        // notifications from another thread are not collected
+        std::thread worker([&]() {
+            NotificationBatch otherBatch;
+            otherQuote->setValue(1.0);
+            if (otherBatch.suppressedNotifications() != 1)
+                BOOST_ERROR("batch of the worker thread suppressed "
+                            << otherBatch.suppressedNotifications()
+                            << " notifications instead of 1");
+        });
+        worker.join();
+        if (other->counter() != 1)
+            BOOST_FAIL("notification from the worker thread was not sent "
+                       "at the end of its batch");
+
+        // while this thread's notifications are
+        otherQuote->setValue(2.0);
+        if (batched->counter() != 0 || other->counter() != 1)
+            BOOST_FAIL("observers were notified during the batch");
+        if (batch.suppressedNotifications() != nQuotes + 1)
+            BOOST_FAIL("batch suppressed " << batch.suppressedNotifications()
+                       << " notifications instead of " << nQuotes + 1);
+    }
+
+    if (batched->counter() != 1 || other->counter() != 2)
+        BOOST_FAIL("each observer should have been updated once more"
+                   << "\n    batched: " << batched->counter()
+                   << "\n    other:   " << other->counter());
+}
 #endif
 
 BOOST_AUTO_TEST_CASE(testDeepUpdate) {
@@ -318,6 +477,203 @@ BOOST_AUTO_TEST_CASE(testEmptyObserverList) {
     dummyObserver->unregisterWith(ext::make_shared<SimpleQuote>(10.0));
 }
 
+BOOST_AUTO_TEST_CASE(testRegistrationOfManyObservers) {
+    BOOST_TEST_MESSAGE("Testing registration and removal of many observers...");
+
+    const ext::shared_ptr<SimpleQuote> q1 = ext::make_shared<SimpleQuote>(0.0);
+    const ext::shared_ptr<SimpleQuote> q2 = ext::make_shared<SimpleQuote>(0.0);
+
+    std::vector<ext::shared_ptr<UpdateCounter> > observers;
+    for (Size i=0; i < 1000; ++i) {
+        observers.push_back(ext::make_shared<UpdateCounter>());
+        observers.back()->registerWith(q1);
+        observers.back()->registerWith(q2);
+        // registering twice must not duplicate notifications
+        observers.back()->registerWith(q1);
+    }
+
+    q1->setValue(1.0);
+    for (const auto& observer : observers) {
+        if (observer->counter() != 1)
+            BOOST_FAIL("only one notification should have been sent");
+    }
+
+    // destroy half of the observers, then unregister some of the
+    // remaining ones, so that the observer lists get compacted
+    std::vector<ext::shared_ptr<UpdateCounter> > remaining;
+    for (Size i=0; i < observers.size(); i+=2)
+        remaining.push_back(observers[i]);
+    observers.swap(remaining);
+    remaining.clear();
+
+    for (Size i=0; i < observers.size(); i+=3) {
+        if (observers[i]->unregisterWith(q1) != 1)
+            BOOST_FAIL("observer should have been registered");
+        if (observers[i]->unregisterWith(q1) != 0)
+            BOOST_FAIL("observer should have been already unregistered");
+    }
+
+    UpdateCounter copy(*observers[1]);
+
+    q1->setValue(2.0);
+    q2->setValue(2.0);
+
+    for (Size i=0; i < observers.size(); ++i) {
+        Size expected = (i % 3 == 0) ? 2 : 3;
+        if (observers[i]->counter() != expected)
+            BOOST_FAIL("observer " << i << " received "
+                       << observers[i]->counter() - 1
+                       << " notifications instead of " << expected - 1);
+    }
+    if (copy.counter() != 3)
+        BOOST_FAIL("copied observer received " << copy.counter() - 1
+                   << " notifications instead of 2");
+}
+
+BOOST_AUTO_TEST_CASE(testRegistrationWithManyObservables) {
+    BOOST_TEST_MESSAGE("Testing registration with many observables...");
+
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i < 1000; ++i)
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.0));
+
+    UpdateCounter observer;
+    for (const auto& q : quotes) {
+        if (!observer.registerWith(q).second)
+            BOOST_FAIL("observer should not have been registered yet");
+    }
+    for (Size i=0; i < quotes.size(); i+=7) {
+        std::pair<Observer::iterator, bool> result =
+            observer.registerWith(quotes[i]);
+        if (result.second || *result.first != quotes[i])
+            BOOST_FAIL("observer should have been already registered");
+    }
+
+    // self-assignment keeps the registrations
+    auto& self = observer;
+    observer = self;
+
+    for (Size i=0; i < quotes.size(); i+=2) {
+        if (observer.unregisterWith(quotes[i]) != 1)
+            BOOST_FAIL("observer should have been registered");
+    }
+
+    for (const auto& q : quotes)
+        q->setValue(1.0);
+
+    if (observer.counter() != quotes.size() / 2)
+        BOOST_FAIL("observer received " << observer.counter()
+                   << " notifications instead of " << quotes.size() / 2);
+}
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+
+class NamedNode : public LazyObject {
+  public:
+    NamedNode(std::string name, std::vector<std::string>& log)
+    : name_(std::move(name)), log_(log) {
+        alwaysForwardNotifications();
+    }
+    void update() override {
+        ++updates_;
+        log_.push_back(name_);
+        LazyObject::update();
+    }
+    Size updates() const { return updates_; }
+    Size position() const {
+        return std::find(log_.begin(), log_.end(), name_) - log_.begin();
+    }
+  private:
+    void performCalculations() const override {}
+    std::string name_;
+    std::vector<std::string>& log_;
+    Size updates_ = 0;
+};
+
+BOOST_AUTO_TEST_CASE(testNotificationBatch) {
+    BOOST_TEST_MESSAGE("Testing batched notifications...");
+
+    const Size nQuotes = 5000;
+
+    // a diamond: every quote is observed by a, which is observed by
+    // b and c, which are both observed by d
+    std::vector<std::string> log;
+    auto a = ext::make_shared<NamedNode>("a", log);
+    auto b = ext::make_shared<NamedNode>("b", log);
+    auto c = ext::make_shared<NamedNode>("c", log);
+    auto d = ext::make_shared<NamedNode>("d", log);
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i < nQuotes; ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.0));
+        a->registerWith(quotes.back());
+    }
+    b->registerWith(a);
+    c->registerWith(a);
+    d->registerWith(b);
+    d->registerWith(c);
+
+    // a temporary quote and observer, destroyed before the flush
+    auto tmpQuote = ext::make_shared<SimpleQuote>(0.0);
+    auto tmpObserver = ext::make_shared<NamedNode>("tmp", log);
+    tmpObserver->registerWith(tmpQuote);
+    tmpObserver->registerWith(quotes.front());
+
+    {
+        NotificationBatch batch;
+        for (Size i=0; i < nQuotes; ++i)
+            quotes[i]->setValue(Real(i+1));
+        tmpQuote->setValue(1.0);
+        tmpObserver.reset();
+        tmpQuote.reset();
+
+        if (!log.empty())
+            BOOST_FAIL("observers were notified during the batch");
+        if (batch.suppressedNotifications() != nQuotes + 1)
+            BOOST_FAIL("batch suppressed " << batch.suppressedNotifications()
+                       << " notifications instead of " << nQuotes + 1);
+
+        batch.flush();
+
+        if (a->updates() != 1 || b->updates() != 1 ||
+            c->updates() != 1 || d->updates() != 1)
+            BOOST_FAIL("each observer should have been updated once"
+                       << "\n    a: " << a->updates()
+                       << "\n    b: " << b->updates()
+                       << "\n    c: " << c->updates()
+                       << "\n    d: " << d->updates());
+        if (a->position() > b->position() || a->position() > c->position() ||
+            b->position() > d->position() || c->position() > d->position())
+            BOOST_FAIL("observers were not updated in topological order");
+        if (batch.updates() != 4)
+            BOOST_FAIL("batch sent " << batch.updates()
+                       << " updates instead of 4");
+
+        // notifications after the flush are collected again
+        quotes.back()->setValue(-1.0);
+        if (a->updates() != 1)
+            BOOST_FAIL("observer was notified during the batch");
+    }
+
+    if (a->updates() != 2 || d->updates() != 2)
+        BOOST_FAIL("observers were not notified when the batch ended");
+
+    // nested batches only flush at the end of the outermost one
+    {
+        NotificationBatch outer;
+        {
+            NotificationBatch inner;
+            quotes.front()->setValue(-1.0);
+            inner.flush();
+        }
+        if (a->updates() != 2)
+            BOOST_FAIL("inner batch should not flush");
+    }
+    if (a->updates() != 3 || d->updates() != 3)
+        BOOST_FAIL("outer batch did not flush");
+}
+
+#endif
+
 BOOST_AUTO_TEST_CASE(testAddAndDeleteObserverDuringNotifyObservers) {
     BOOST_TEST_MESSAGE("Testing addition and deletion of observers during notifyObserver...");
 
@@ -37,6 +37,7 @@
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/bumpednodesensitivities.hpp>
 #include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -56,6 +57,7 @@
 #include <iomanip>
 #include <map>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -862,6 +864,77 @@ BOOST_AUTO_TEST_CASE(testObservability) {
                    " without an intervening recalculation");
 }
 
+BOOST_AUTO_TEST_CASE(testLargeSwapPortfolio) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing a large swap portfolio on a piecewise yield curve...");
+
+    CommonVars vars;
+
+    vars.termStructure = ext::make_shared<PiecewiseYieldCurve<Discount,LogLinear>>(
+                                                   vars.settlement,
+                                                   vars.instruments,
+                                                   Actual360());
+    RelinkableHandle<YieldTermStructure> curveHandle;
+    curveHandle.linkTo(vars.termStructure);
+
+    auto euribor6m = ext::make_shared<Euribor6M>(curveHandle);
+    auto engine = ext::make_shared<DiscountingSwapEngine>(curveHandle);
+
+    // every coupon of every swap ends up observing the same index
+    // and curve, which stresses the registration of observers
+    const Size nSwaps = 2000;
+    std::vector<ext::shared_ptr<VanillaSwap> > portfolio;
+    portfolio.reserve(nSwaps);
+    for (Size i=0; i<nSwaps; i++) {
+        Date effectiveDate =
+            vars.calendar.advance(vars.settlement, Integer(i % 250), Days);
+        portfolio.push_back(
+            MakeVanillaSwap((1 + i % 25) * Years, euribor6m, 0.03)
+            .withEffectiveDate(effectiveDate)
+            .withFixedLegDayCount(vars.fixedLegDayCounter)
+            .withFixedLegTenor(Period(vars.fixedLegFrequency))
+            .withFixedLegConvention(vars.fixedLegConvention)
+            .withFixedLegTerminationDateConvention(vars.fixedLegConvention)
+            .withPricingEngine(engine));
+    }
+
+    std::vector<Real> npvs(nSwaps);
+    for (Size i=0; i<nSwaps; i++)
+        npvs[i] = portfolio[i]->NPV();
+
+    // a change in the market must reach every swap
+    for (auto& r : vars.rates)
+        r->setValue(r->value() + 0.001);
+    for (Size i=0; i<nSwaps; i++) {
+        if (portfolio[i]->NPV() == npvs[i])
+            BOOST_FAIL("swap #" << i << " was not notified of rate change");
+    }
+
+    // tear down half of the portfolio; the rest must keep working
+    std::vector<ext::shared_ptr<VanillaSwap> > remaining;
+    std::vector<Real> remainingNpvs;
+    for (Size i=0; i<nSwaps; i+=2) {
+        remaining.push_back(portfolio[i]);
+        remainingNpvs.push_back(npvs[i]);
+    }
+    portfolio.swap(remaining);
+    remaining.clear();
+
+    for (auto& r : vars.rates)
+        r->setValue(r->value() - 0.001);
+    for (Size i=0; i<portfolio.size(); i++) {
+        if (std::fabs(portfolio[i]->NPV() - remainingNpvs[i]) > 1.0e-8)
+            BOOST_ERROR("failed to reproduce NPV of swap #" << 2*i
+                        << " after partial tear-down:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << portfolio[i]->NPV()
+                        << "\n    expected:   " << remainingNpvs[i]);
+    }
+
+    portfolio.clear();
+}
+
 BOOST_AUTO_TEST_CASE(testLiborFixing) {
 
     BOOST_TEST_MESSAGE(
@@ -1544,6 +1617,267 @@ BOOST_AUTO_TEST_CASE(testCustomFuturesHelpers) {
     }
 }
 
+namespace {
+
+    template <class T, class I>
+    void checkBumpedNodeSensitivities(const std::string& name) {
+
+        CommonVars vars;
+
+        // 40 pillars: 5 deposits and 35 swaps
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<RateHelper> > helpers;
+        auto euribor6m = ext::make_shared<Euribor6M>();
+        for (Integer n : { 1, 2, 3, 6, 9 }) {
+            quotes.push_back(ext::make_shared<SimpleQuote>(0.02 + 0.0005 * n));
+            helpers.push_back(ext::make_shared<DepositRateHelper>(
+                Handle<Quote>(quotes.back()), n * Months, vars.settlementDays,
+                vars.calendar, ModifiedFollowing, true, Actual360()));
+        }
+        for (Integer n = 1; n <= 35; ++n) {
+            quotes.push_back(ext::make_shared<SimpleQuote>(0.025 + 0.005 * std::log(Real(n))));
+            helpers.push_back(ext::make_shared<SwapRateHelper>(
+                Handle<Quote>(quotes.back()), n * Years, vars.calendar,
+                vars.fixedLegFrequency, vars.fixedLegConvention,
+                vars.fixedLegDayCounter, euribor6m));
+        }
+
+        typedef PiecewiseYieldCurve<T, I> Curve;
+        auto curve = ext::make_shared<Curve>(vars.settlement, helpers, Actual360());
+        RelinkableHandle<YieldTermStructure> curveHandle(curve);
+        auto index = ext::make_shared<Euribor6M>(curveHandle);
+        auto engine = ext::make_shared<DiscountingSwapEngine>(curveHandle);
+
+        std::vector<ext::shared_ptr<Instrument> > swaps;
+        std::vector<Real> npvs;
+        for (auto data : { std::make_tuple(7 * Years, 0.03, 0 * Days),
+                           std::make_tuple(23 * Years, 0.035, 0 * Days),
+                           std::make_tuple(10 * Years, 0.04, 5 * Years) }) {
+            ext::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(std::get<0>(data), index, std::get<1>(data),
+                                std::get<2>(data))
+                .withNominal(1000000.0)
+                .withPricingEngine(engine);
+            swaps.push_back(swap);
+            npvs.push_back(swap->NPV());
+        }
+
+        Flag flag;
+        flag.registerWith(curveHandle);
+
+        BumpedNodeSensitivities<Curve> sensitivities(curve);
+        Matrix deltas = sensitivities.quoteSensitivities(swaps);
+
+        // the swaps are recalculated directly
+        if (flag.isUp())
+            BOOST_ERROR(name << ": curve observers were notified");
+
+        if (sensitivities.helpers() != helpers)
+            BOOST_FAIL(name << ": unexpected helper order");
+
+        // the curve must be left untouched
+        for (Size k = 0; k < swaps.size(); ++k) {
+            if (std::fabs(swaps[k]->NPV() - npvs[k]) > 1.0e-8)
+                BOOST_ERROR(name << ": curve not restored"
+                            << std::setprecision(12)
+                            << "\n    swap:       " << k
+                            << "\n    NPV before: " << npvs[k]
+                            << "\n    NPV after:  " << swaps[k]->NPV());
+        }
+
+        // compare with bump-and-reprice
+        const Real h = 1.0e-5, tolerance = 0.5;
+        for (Size j = 0; j < quotes.size(); ++j) {
+            Real q = quotes[j]->value();
+            std::vector<Real> up, down;
+            quotes[j]->setValue(q + h);
+            for (const auto& swap : swaps)
+                up.push_back(swap->NPV());
+            quotes[j]->setValue(q - h);
+            for (const auto& swap : swaps)
+                down.push_back(swap->NPV());
+            quotes[j]->setValue(q);
+            for (Size k = 0; k < swaps.size(); ++k) {
+                Real expected = (up[k] - down[k]) / (2.0 * h);
+                if (std::fabs(deltas[k][j] - expected) > tolerance)
+                    BOOST_ERROR(name << ": wrong quote sensitivity"
+                                << std::setprecision(12)
+                                << "\n    swap:       " << k
+                                << "\n    quote:      " << j
+                                << "\n    calculated: " << deltas[k][j]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testBumpedNodeSensitivities) {
+
+    BOOST_TEST_MESSAGE("Testing quote sensitivities of bootstrapped curves...");
+
+    checkBumpedNodeSensitivities<Discount, LogLinear>("log-linear discount");
+    checkBumpedNodeSensitivities<ZeroYield, Linear>("linear zero yield");
+}
+
+namespace {
+
+    template <class T, class I, class F>
+    void checkAnalyticBootstrap(const std::string& name, F makeHelpers) {
+
+        // helpers can't be shared between curves
+        CommonVars vars1, vars2;
+        std::vector<ext::shared_ptr<RateHelper> > helpers = makeHelpers(vars2);
+
+        typedef PiecewiseYieldCurve<T, I> Curve;
+        typename Curve::bootstrap_type analytic(
+            Null<Real>(), Null<Real>(), Null<Real>(), 1, 2.0, 2.0, false, 10,
+            MAX_FUNCTION_EVALUATIONS, true);
+        auto expected = ext::make_shared<Curve>(vars1.settlement, makeHelpers(vars1),
+                                                Actual360());
+        auto calculated = ext::make_shared<Curve>(vars2.settlement, helpers,
+                                                  Actual360(), I(), analytic);
+
+        const std::vector<Real> expectedData = expected->data();
+        const std::vector<Real> calculatedData = calculated->data();
+        for (Size i = 0; i < expectedData.size(); ++i) {
+            if (std::fabs(calculatedData[i] - expectedData[i]) > 1.0e-10)
+                BOOST_ERROR(name << ": failed to reproduce node #" << i
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculatedData[i]
+                            << "\n    expected:   " << expectedData[i]);
+        }
+
+        // the Jacobian is taken from the bootstrap for the second
+        // curve, and obtained by repricing the helpers for the first
+        Matrix expectedJacobian = BumpedNodeSensitivities<Curve>(expected).jacobian();
+        Matrix calculatedJacobian = BumpedNodeSensitivities<Curve>(calculated).jacobian();
+        for (Size i = 0; i < expectedJacobian.rows(); ++i) {
+            for (Size j = 0; j < expectedJacobian.columns(); ++j) {
+                Real tolerance = 1.0e-5 * std::max(1.0, std::fabs(expectedJacobian[i][j]));
+                if (std::fabs(calculatedJacobian[i][j] - expectedJacobian[i][j]) > tolerance)
+                    BOOST_ERROR(name << ": wrong Jacobian element (" << i << "," << j << ")"
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculatedJacobian[i][j]
+                                << "\n    expected:   " << expectedJacobian[i][j]);
+            }
+        }
+
+        // the curve must be left untouched
+        for (Size i = 0; i < calculatedData.size(); ++i) {
+            if (calculatedData[i] != calculated->data()[i])
+                BOOST_FAIL(name << ": curve not restored");
+        }
+        for (const auto& helper : helpers) {
+            if (std::fabs(helper->quoteError()) > 1.0e-9)
+                BOOST_ERROR(name << ": helper with pillar " << helper->pillarDate()
+                            << " not repriced"
+                            << std::setprecision(12)
+                            << "\n    error: " << helper->quoteError());
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testAnalyticBootstrapDerivatives) {
+
+    BOOST_TEST_MESSAGE("Testing bootstrap with analytic helper derivatives...");
+
+    auto depositsAndSwaps = [](const CommonVars& vars) { return vars.instruments; };
+    auto indexedFras = [](const CommonVars& vars) { return vars.fraHelpers(true); };
+    auto parFras = [](const CommonVars& vars) { return vars.fraHelpers(false); };
+
+    checkAnalyticBootstrap<Discount, LogLinear>("log-linear discount", depositsAndSwaps);
+    checkAnalyticBootstrap<ZeroYield, Linear>("linear zero yield", depositsAndSwaps);
+    checkAnalyticBootstrap<ForwardRate, BackwardFlat>("flat forward", depositsAndSwaps);
+    checkAnalyticBootstrap<ZeroYield, Cubic>("cubic zero yield", depositsAndSwaps);
+    checkAnalyticBootstrap<Discount, LogLinear>("indexed FRAs", indexedFras);
+    checkAnalyticBootstrap<Discount, LogLinear>("par FRAs", parFras);
+}
+
+namespace {
+
+    // 60 pillars: 5 deposits and 55 swaps
+    std::vector<ext::shared_ptr<RateHelper> >
+    tickHelpers(const CommonVars& vars,
+                const std::vector<ext::shared_ptr<SimpleQuote> >& quotes) {
+        std::vector<ext::shared_ptr<RateHelper> > helpers;
+        auto euribor6m = ext::make_shared<Euribor6M>();
+        Size j = 0;
+        for (Integer n : { 1, 2, 3, 6, 9 }) {
+            helpers.push_back(ext::make_shared<DepositRateHelper>(
+                Handle<Quote>(quotes[j++]), n * Months, vars.settlementDays,
+                vars.calendar, ModifiedFollowing, true, Actual360()));
+        }
+        for (Integer n = 1; n <= 55; ++n) {
+            helpers.push_back(ext::make_shared<SwapRateHelper>(
+                Handle<Quote>(quotes[j++]), n * Years, vars.calendar,
+                vars.fixedLegFrequency, vars.fixedLegConvention,
+                vars.fixedLegDayCounter, euribor6m));
+        }
+        return helpers;
+    }
+
+    template <class T, class I>
+    void checkIncrementalBootstrap(const std::string& name) {
+
+        CommonVars vars;
+
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+        for (Integer n : { 1, 2, 3, 6, 9 })
+            quotes.push_back(ext::make_shared<SimpleQuote>(0.02 + 0.0005 * n));
+        for (Integer n = 1; n <= 55; ++n)
+            quotes.push_back(ext::make_shared<SimpleQuote>(0.025 + 0.005 * std::log(Real(n))));
+
+        typedef PiecewiseYieldCurve<T, I> Curve;
+        auto curve = ext::make_shared<Curve>(vars.settlement, tickHelpers(vars, quotes),
+                                             Actual360());
+
+        // one quote at a time ticks, and the curve is recalculated
+        for (Size j = 0; j < quotes.size(); ++j) {
+            std::vector<Real> before = curve->data();
+            quotes[j]->setValue(quotes[j]->value() + 0.0001);
+            std::vector<Real> calculated = curve->data();
+
+            // with a local interpolation, the pillars before the
+            // changed one are not solved again
+            if (!I::global) {
+                for (Size i = 1; i <= j; ++i) {
+                    if (calculated[i] != before[i])
+                        BOOST_FAIL(name << ": node #" << i << " changed after"
+                                   << " tick of quote #" << j);
+                }
+            }
+
+            if (j != 0 && j != 5 && j != 30 && j != quotes.size()-1)
+                continue;
+
+            // compare with a curve bootstrapped from scratch
+            Curve expected(vars.settlement, tickHelpers(vars, quotes), Actual360());
+            const std::vector<Real>& expectedData = expected.data();
+            for (Size i = 0; i < expectedData.size(); ++i) {
+                if (std::fabs(calculated[i] - expectedData[i]) > 1.0e-10)
+                    BOOST_ERROR(name << ": failed to reproduce node #" << i
+                                << " after tick of quote #" << j
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculated[i]
+                                << "\n    expected:   " << expectedData[i]);
+            }
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testIncrementalBootstrap) {
+
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap after single-quote ticks...");
+
+    checkIncrementalBootstrap<Discount, LogLinear>("log-linear discount");
+    checkIncrementalBootstrap<ZeroYield, Linear>("linear zero yield");
+    // global interpolation; the whole curve is bootstrapped again
+    checkIncrementalBootstrap<ZeroYield, Cubic>("cubic zero yield");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -478,10 +478,14 @@ namespace {
 // Equity & FX
 QL_BENCHMARK_DECLARE(AmericanOptionTests, testFdAmericanGreeks, 1, 0.5);
 QL_BENCHMARK_DECLARE(AmericanOptionTests, testFdValues, 20, 3.0);
+QL_BENCHMARK_DECLARE(AmericanOptionTests, testFdStrikeLadder, 2, 1.0);
 QL_BENCHMARK_DECLARE(AmericanOptionTests, testCallPutParity, 100, 1.0);
 QL_BENCHMARK_DECLARE(AmericanOptionTests, testQdEngineStandardExample, 400, 0.5);
+QL_BENCHMARK_DECLARE(BlackFormulaTests, testBlackFormulaStrip, 20, 0.5);
 QL_BENCHMARK_DECLARE(EuropeanOptionTests, testImpliedVol, 1, 0.5);
 QL_BENCHMARK_DECLARE(EuropeanOptionTests, testMcEngines, 1, 1.0);
+QL_BENCHMARK_DECLARE(EuropeanOptionTests, testBatchPricing, 5, 1.0);
+QL_BENCHMARK_DECLARE(EuropeanOptionTests, testFdBatchPricing, 5, 1.0);
 QL_BENCHMARK_DECLARE(EuropeanOptionTests, testLocalVolatility, 3, 2.0);
 QL_BENCHMARK_DECLARE(BatesModelTests, testDAXCalibration, 1, 0.5);
 QL_BENCHMARK_DECLARE(BatesModelTests, testAnalyticVsMCPricing, 1, 1.0);
@@ -521,6 +525,9 @@ QL_BENCHMARK_DECLARE(LiborMarketModelTests, testCalibration, 1, 5.0);
 QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testConvexMonotoneForwardConsistency, 10, 2.0);
 QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testFlatForwardConsistency, 50, 3.0);
 QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testGlobalBootstrap, 20, 2.0);
+QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testLargeSwapPortfolio, 1, 2.0);
+QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testBumpedNodeSensitivities, 1, 2.0);
+QL_BENCHMARK_DECLARE(PiecewiseYieldCurveTests, testIncrementalBootstrap, 1, 3.0);
 QL_BENCHMARK_DECLARE(OvernightIndexedSwapTests, testBootstrapWithArithmeticAverage, 10, 5.0);
 QL_BENCHMARK_DECLARE(OvernightIndexedSwapTests, testBaseBootstrap, 10, 3.0);
 QL_BENCHMARK_DECLARE(OvernightIndexedSwapTests, testBootstrapRegression, 10, 1.0);
@@ -572,6 +579,11 @@ QL_BENCHMARK_DECLARE(RoundingTests, testFloor, 100000, 0.1);
 QL_BENCHMARK_DECLARE(RoundingTests, testDown, 100000, 0.1);
 QL_BENCHMARK_DECLARE(RoundingTests, testClosest, 100000, 0.1);
 
+// Patterns
+#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+QL_BENCHMARK_DECLARE(ObservableTests, testRegistrationThroughput, 2, 0.5);
+#endif
+
 
 
 